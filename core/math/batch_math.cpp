@@ -0,0 +1,500 @@
+/**************************************************************************/
+/*  batch_math.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "batch_math.h"
+
+#if !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BATCH_MATH_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define BATCH_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace BatchMath {
+
+void xform_points_scalar(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+void xform_aabbs_scalar(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+void xform_transforms_scalar(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform * p_src[i];
+	}
+}
+
+uint32_t aabbs_intersect_scalar(const AABB &p_aabb, const AABB *p_aabbs, uint32_t p_count, uint32_t *r_indices) {
+	uint32_t found = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (p_aabb.intersects(p_aabbs[i])) {
+			r_indices[found++] = i;
+		}
+	}
+	return found;
+}
+
+void project_box_scalar(const Transform3D &p_xform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		// No matter the angle, the box is mirrored anyway.
+		const Vector3 local_axis = p_xform.basis.xform_inv(p_axes[i]);
+		const real_t length = local_axis.abs().dot(p_half_extents);
+		const real_t distance = p_axes[i].dot(p_xform.origin);
+		r_min[i] = distance - length;
+		r_max[i] = distance + length;
+	}
+}
+
+void project_points_scalar(const Transform3D &p_xform, const Vector3 *p_points, uint32_t p_point_count, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_axis_count) {
+	for (uint32_t i = 0; i < p_axis_count; i++) {
+		for (uint32_t j = 0; j < p_point_count; j++) {
+			const real_t d = p_axes[i].dot(p_xform.xform(p_points[j]));
+			if (j == 0 || d > r_max[i]) {
+				r_max[i] = d;
+			}
+			if (j == 0 || d < r_min[i]) {
+				r_min[i] = d;
+			}
+		}
+	}
+}
+
+#if defined(BATCH_MATH_SSE2) || defined(BATCH_MATH_NEON)
+
+static_assert(sizeof(Vector3) == sizeof(float) * 3);
+static_assert(sizeof(AABB) == sizeof(float) * 6);
+static_assert(sizeof(Transform3D) == sizeof(float) * 12);
+
+// Thin wrappers, so the kernels below are only written once for both instruction sets.
+// Only the first three lanes are meaningful; the fourth one is never stored.
+
+#ifdef BATCH_MATH_SSE2
+
+typedef __m128 float4;
+
+// Loads and stores touch exactly three floats, so they never read or write past the end of an array.
+static _ALWAYS_INLINE_ float4 load3(const float *p_ptr) {
+	return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd((const double *)p_ptr)), _mm_load_ss(p_ptr + 2));
+}
+static _ALWAYS_INLINE_ void store3(float *p_ptr, float4 p_v) {
+	_mm_store_sd((double *)p_ptr, _mm_castps_pd(p_v));
+	_mm_store_ss(p_ptr + 2, _mm_movehl_ps(p_v, p_v));
+}
+static _ALWAYS_INLINE_ float4 load4(const float *p_ptr) {
+	return _mm_loadu_ps(p_ptr);
+}
+static _ALWAYS_INLINE_ void store4(float *p_ptr, float4 p_v) {
+	_mm_storeu_ps(p_ptr, p_v);
+}
+static _ALWAYS_INLINE_ float4 splat(float p_value) {
+	return _mm_set1_ps(p_value);
+}
+static _ALWAYS_INLINE_ float4 add(float4 p_a, float4 p_b) {
+	return _mm_add_ps(p_a, p_b);
+}
+static _ALWAYS_INLINE_ float4 sub(float4 p_a, float4 p_b) {
+	return _mm_sub_ps(p_a, p_b);
+}
+static _ALWAYS_INLINE_ float4 mul(float4 p_a, float4 p_b) {
+	return _mm_mul_ps(p_a, p_b);
+}
+static _ALWAYS_INLINE_ float4 abs(float4 p_v) {
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), p_v);
+}
+// Same as `a < b ? a : b`, including for NaN and signed zeros.
+static _ALWAYS_INLINE_ float4 select_min(float4 p_a, float4 p_b) {
+	return _mm_min_ps(p_a, p_b);
+}
+// Same as `a < b ? b : a`.
+static _ALWAYS_INLINE_ float4 select_max(float4 p_a, float4 p_b) {
+	return _mm_max_ps(p_b, p_a);
+}
+// True if `a < b && c > d` in the first three lanes.
+static _ALWAYS_INLINE_ bool overlaps3(float4 p_a, float4 p_b, float4 p_c, float4 p_d) {
+	return (_mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(p_a, p_b), _mm_cmpgt_ps(p_c, p_d))) & 7) == 7;
+}
+
+// Lane order is the same as in memory: `_mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0))` = [a[i0], a[i1], b[i2], b[i3]].
+#define SHUFFLE(m_a, m_b, m_i0, m_i1, m_i2, m_i3) _mm_shuffle_ps(m_a, m_b, _MM_SHUFFLE(m_i3, m_i2, m_i1, m_i0))
+
+static void xform_points_simd(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	const float4 m00 = splat(b.rows[0][0]), m01 = splat(b.rows[0][1]), m02 = splat(b.rows[0][2]);
+	const float4 m10 = splat(b.rows[1][0]), m11 = splat(b.rows[1][1]), m12 = splat(b.rows[1][2]);
+	const float4 m20 = splat(b.rows[2][0]), m21 = splat(b.rows[2][1]), m22 = splat(b.rows[2][2]);
+	const float4 ox = splat(p_xform.origin.x), oy = splat(p_xform.origin.y), oz = splat(p_xform.origin.z);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		// Four points are three registers: [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3].
+		const float *src = (const float *)(p_src + i);
+		const float4 a = _mm_loadu_ps(src);
+		const float4 b4 = _mm_loadu_ps(src + 4);
+		const float4 c = _mm_loadu_ps(src + 8);
+
+		const float4 x = SHUFFLE(a, SHUFFLE(b4, c, 2, 2, 1, 1), 0, 3, 0, 2);
+		const float4 y = SHUFFLE(SHUFFLE(a, b4, 1, 1, 0, 0), SHUFFLE(b4, c, 3, 3, 2, 2), 0, 2, 0, 2);
+		const float4 z = SHUFFLE(SHUFFLE(a, b4, 2, 2, 1, 1), c, 0, 2, 0, 3);
+
+		// Same evaluation order as Vector3::dot() followed by adding the origin.
+		const float4 rx = add(add(add(mul(m00, x), mul(m01, y)), mul(m02, z)), ox);
+		const float4 ry = add(add(add(mul(m10, x), mul(m11, y)), mul(m12, z)), oy);
+		const float4 rz = add(add(add(mul(m20, x), mul(m21, y)), mul(m22, z)), oz);
+
+		const float4 xy_lo = _mm_unpacklo_ps(rx, ry); // [x0 y0 x1 y1]
+		const float4 xy_hi = _mm_unpackhi_ps(rx, ry); // [x2 y2 x3 y3]
+		float *dst = (float *)(r_dst + i);
+		_mm_storeu_ps(dst, SHUFFLE(xy_lo, SHUFFLE(rz, rx, 0, 0, 1, 1), 0, 1, 0, 2));
+		_mm_storeu_ps(dst + 4, SHUFFLE(SHUFFLE(ry, rz, 1, 1, 1, 1), xy_hi, 0, 2, 0, 1));
+		const float4 t = SHUFFLE(rz, xy_hi, 2, 3, 2, 3); // [z2 z3 x3 y3]
+		_mm_storeu_ps(dst + 8, SHUFFLE(t, t, 0, 2, 3, 1));
+	}
+
+	xform_points_scalar(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+#undef SHUFFLE
+
+#else // BATCH_MATH_NEON
+
+typedef float32x4_t float4;
+
+static _ALWAYS_INLINE_ float4 load3(const float *p_ptr) {
+	return vcombine_f32(vld1_f32(p_ptr), vld1_lane_f32(p_ptr + 2, vdup_n_f32(0.0f), 0));
+}
+static _ALWAYS_INLINE_ void store3(float *p_ptr, float4 p_v) {
+	vst1_f32(p_ptr, vget_low_f32(p_v));
+	vst1q_lane_f32(p_ptr + 2, p_v, 2);
+}
+static _ALWAYS_INLINE_ float4 load4(const float *p_ptr) {
+	return vld1q_f32(p_ptr);
+}
+static _ALWAYS_INLINE_ void store4(float *p_ptr, float4 p_v) {
+	vst1q_f32(p_ptr, p_v);
+}
+static _ALWAYS_INLINE_ float4 splat(float p_value) {
+	return vdupq_n_f32(p_value);
+}
+static _ALWAYS_INLINE_ float4 add(float4 p_a, float4 p_b) {
+	return vaddq_f32(p_a, p_b);
+}
+static _ALWAYS_INLINE_ float4 sub(float4 p_a, float4 p_b) {
+	return vsubq_f32(p_a, p_b);
+}
+static _ALWAYS_INLINE_ float4 mul(float4 p_a, float4 p_b) {
+	return vmulq_f32(p_a, p_b);
+}
+static _ALWAYS_INLINE_ float4 abs(float4 p_v) {
+	return vabsq_f32(p_v);
+}
+// Same as `a < b ? a : b`, including for NaN and signed zeros.
+static _ALWAYS_INLINE_ float4 select_min(float4 p_a, float4 p_b) {
+	return vbslq_f32(vcltq_f32(p_a, p_b), p_a, p_b);
+}
+// Same as `a < b ? b : a`.
+static _ALWAYS_INLINE_ float4 select_max(float4 p_a, float4 p_b) {
+	return vbslq_f32(vcltq_f32(p_a, p_b), p_b, p_a);
+}
+// True if `a < b && c > d` in the first three lanes.
+static _ALWAYS_INLINE_ bool overlaps3(float4 p_a, float4 p_b, float4 p_c, float4 p_d) {
+	const uint32x4_t mask = vandq_u32(vcltq_f32(p_a, p_b), vcgtq_f32(p_c, p_d));
+	return vminvq_u32(vsetq_lane_u32(0xFFFFFFFF, mask, 3)) != 0;
+}
+
+static void xform_points_simd(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		// Deinterleaves four points into x, y and z registers.
+		const float32x4x3_t v = vld3q_f32((const float *)(p_src + i));
+		float32x4x3_t r;
+		for (int k = 0; k < 3; k++) {
+			// Same evaluation order as Vector3::dot() followed by adding the origin.
+			r.val[k] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], b.rows[k][0]), vmulq_n_f32(v.val[1], b.rows[k][1])), vmulq_n_f32(v.val[2], b.rows[k][2])), vdupq_n_f32(p_xform.origin[k]));
+		}
+		vst3q_f32((float *)(r_dst + i), r);
+	}
+
+	xform_points_scalar(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+#endif
+
+static void xform_aabbs_simd(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	// Columns of the basis, as the box is expanded one source axis at a time.
+	const Vector3 columns[3] = { p_xform.basis.get_column(0), p_xform.basis.get_column(1), p_xform.basis.get_column(2) };
+	const float4 col0 = load3(&columns[0].x);
+	const float4 col1 = load3(&columns[1].x);
+	const float4 col2 = load3(&columns[2].x);
+	const float4 origin = load3(&p_xform.origin.x);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const float *src = (const float *)(p_src + i);
+		const float min_x = src[0], min_y = src[1], min_z = src[2];
+		const float max_x = min_x + src[3], max_y = min_y + src[4], max_z = min_z + src[5];
+
+		// Same accumulation order as Transform3D::xform(const AABB &).
+		float4 e = mul(col0, splat(min_x));
+		float4 f = mul(col0, splat(max_x));
+		float4 tmin = add(origin, select_min(e, f));
+		float4 tmax = add(origin, select_max(e, f));
+		e = mul(col1, splat(min_y));
+		f = mul(col1, splat(max_y));
+		tmin = add(tmin, select_min(e, f));
+		tmax = add(tmax, select_max(e, f));
+		e = mul(col2, splat(min_z));
+		f = mul(col2, splat(max_z));
+		tmin = add(tmin, select_min(e, f));
+		tmax = add(tmax, select_max(e, f));
+
+		float *dst = (float *)(r_dst + i);
+		store3(dst, tmin);
+		store3(dst + 3, tmax);
+		// Size is computed in scalar to round exactly like the scalar version does.
+		dst[3] -= dst[0];
+		dst[4] -= dst[1];
+		dst[5] -= dst[2];
+	}
+}
+
+static void xform_transforms_simd(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	const Vector3 columns[3] = { b.get_column(0), b.get_column(1), b.get_column(2) };
+	const float4 col0 = load3(&columns[0].x);
+	const float4 col1 = load3(&columns[1].x);
+	const float4 col2 = load3(&columns[2].x);
+	const float4 origin = load3(&p_xform.origin.x);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		// A transform is 12 contiguous floats: three basis rows, then the origin.
+		// Rows are loaded and stored four floats at a time, the extra lane spilling into the next row,
+		// which is why they're stored in order and the origin is stored last.
+		const float *src = (const float *)(p_src + i);
+		const float4 row0 = load4(src);
+		const float4 row1 = load4(src + 3);
+		const float4 row2 = load4(src + 6);
+		const float ox = src[9], oy = src[10], oz = src[11];
+
+		// Same evaluation order as Basis::operator*=() and Transform3D::xform().
+		const float4 r0 = add(add(mul(row0, splat(b.rows[0][0])), mul(row1, splat(b.rows[0][1]))), mul(row2, splat(b.rows[0][2])));
+		const float4 r1 = add(add(mul(row0, splat(b.rows[1][0])), mul(row1, splat(b.rows[1][1]))), mul(row2, splat(b.rows[1][2])));
+		const float4 r2 = add(add(mul(row0, splat(b.rows[2][0])), mul(row1, splat(b.rows[2][1]))), mul(row2, splat(b.rows[2][2])));
+		const float4 o = add(add(add(mul(col0, splat(ox)), mul(col1, splat(oy))), mul(col2, splat(oz))), origin);
+
+		float *dst = (float *)(r_dst + i);
+		store4(dst, r0);
+		store4(dst + 3, r1);
+		store4(dst + 6, r2);
+		store3(dst + 9, o);
+	}
+}
+
+static uint32_t aabbs_intersect_simd(const AABB &p_aabb, const AABB *p_aabbs, uint32_t p_count, uint32_t *r_indices) {
+	const float4 pos = load3(&p_aabb.position.x);
+	const float4 end = add(pos, load3(&p_aabb.size.x));
+
+	uint32_t found = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		const float4 other_pos = load3(&p_aabbs[i].position.x);
+		const float4 other_end = add(other_pos, load3(&p_aabbs[i].size.x));
+		if (overlaps3(pos, other_end, end, other_pos)) {
+			r_indices[found++] = i;
+		}
+	}
+	return found;
+}
+
+// Up to four axes, one per lane. The unused lanes are zero, and never stored.
+struct Axes4 {
+	float4 x, y, z;
+};
+
+static _ALWAYS_INLINE_ Axes4 load_axes(const Vector3 *p_axes, uint32_t p_count) {
+	float x[4] = {}, y[4] = {}, z[4] = {};
+	for (uint32_t i = 0; i < p_count; i++) {
+		x[i] = p_axes[i].x;
+		y[i] = p_axes[i].y;
+		z[i] = p_axes[i].z;
+	}
+	return { load4(x), load4(y), load4(z) };
+}
+
+static _ALWAYS_INLINE_ void store_lanes(float *p_ptr, float4 p_v, uint32_t p_count) {
+	float v[4];
+	store4(v, p_v);
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_ptr[i] = v[i];
+	}
+}
+
+static void project_box_simd(const Transform3D &p_xform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	const float4 hx = splat(p_half_extents.x), hy = splat(p_half_extents.y), hz = splat(p_half_extents.z);
+	const float4 ox = splat(p_xform.origin.x), oy = splat(p_xform.origin.y), oz = splat(p_xform.origin.z);
+
+	for (uint32_t i = 0; i < p_count; i += 4) {
+		const uint32_t lanes = MIN(p_count - i, 4u);
+		const Axes4 a = load_axes(p_axes + i, lanes);
+
+		// Same evaluation order as Basis::xform_inv(), then Vector3::abs() and Vector3::dot().
+		const float4 lx = add(add(mul(splat(b.rows[0][0]), a.x), mul(splat(b.rows[1][0]), a.y)), mul(splat(b.rows[2][0]), a.z));
+		const float4 ly = add(add(mul(splat(b.rows[0][1]), a.x), mul(splat(b.rows[1][1]), a.y)), mul(splat(b.rows[2][1]), a.z));
+		const float4 lz = add(add(mul(splat(b.rows[0][2]), a.x), mul(splat(b.rows[1][2]), a.y)), mul(splat(b.rows[2][2]), a.z));
+		const float4 length = add(add(mul(abs(lx), hx), mul(abs(ly), hy)), mul(abs(lz), hz));
+		const float4 distance = add(add(mul(a.x, ox), mul(a.y, oy)), mul(a.z, oz));
+
+		store_lanes(r_min + i, sub(distance, length), lanes);
+		store_lanes(r_max + i, add(distance, length), lanes);
+	}
+}
+
+static void project_points_simd(const Transform3D &p_xform, const Vector3 *p_points, uint32_t p_point_count, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_axis_count) {
+	if (p_point_count == 0) {
+		return;
+	}
+
+	// Eight axes at a time, so each point is transformed once for two registers of axes.
+	for (uint32_t i = 0; i < p_axis_count; i += 8) {
+		const uint32_t lanes = MIN(p_axis_count - i, 8u);
+		const uint32_t lanes_lo = MIN(lanes, 4u);
+		const uint32_t lanes_hi = lanes - lanes_lo;
+		const Axes4 a = load_axes(p_axes + i, lanes_lo);
+		const Axes4 b = load_axes(p_axes + i + lanes_lo, lanes_hi);
+
+		float4 min_lo = splat(0.0f), max_lo = splat(0.0f), min_hi = splat(0.0f), max_hi = splat(0.0f);
+		for (uint32_t j = 0; j < p_point_count; j++) {
+			// Transformed in scalar, so the point is rounded exactly like in the scalar version.
+			const Vector3 point = p_xform.xform(p_points[j]);
+			const float4 px = splat(point.x), py = splat(point.y), pz = splat(point.z);
+
+			// Same evaluation order as Vector3::dot(), and the same comparisons as the scalar version:
+			// `d > max ? d : max` and `d < min ? d : min`.
+			const float4 d_lo = add(add(mul(a.x, px), mul(a.y, py)), mul(a.z, pz));
+			min_lo = j == 0 ? d_lo : select_min(d_lo, min_lo);
+			max_lo = j == 0 ? d_lo : select_max(max_lo, d_lo);
+			if (lanes_hi) {
+				const float4 d_hi = add(add(mul(b.x, px), mul(b.y, py)), mul(b.z, pz));
+				min_hi = j == 0 ? d_hi : select_min(d_hi, min_hi);
+				max_hi = j == 0 ? d_hi : select_max(max_hi, d_hi);
+			}
+		}
+
+		store_lanes(r_min + i, min_lo, lanes_lo);
+		store_lanes(r_max + i, max_lo, lanes_lo);
+		store_lanes(r_min + i + 4, min_hi, lanes_hi);
+		store_lanes(r_max + i + 4, max_hi, lanes_hi);
+	}
+}
+
+#endif // BATCH_MATH_SSE2 || BATCH_MATH_NEON
+
+Backend get_backend() {
+#if defined(BATCH_MATH_SSE2)
+	return BACKEND_SSE2;
+#elif defined(BATCH_MATH_NEON)
+	return BACKEND_NEON;
+#else
+	return BACKEND_SCALAR;
+#endif
+}
+
+const char *get_backend_name() {
+	switch (get_backend()) {
+		case BACKEND_SSE2:
+			return "SSE2";
+		case BACKEND_NEON:
+			return "NEON";
+		default:
+			return "Scalar";
+	}
+}
+
+#if defined(BATCH_MATH_SSE2) || defined(BATCH_MATH_NEON)
+
+void xform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	xform_points_simd(p_xform, p_src, r_dst, p_count);
+}
+
+void xform_aabbs(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	xform_aabbs_simd(p_xform, p_src, r_dst, p_count);
+}
+
+void xform_transforms(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	xform_transforms_simd(p_xform, p_src, r_dst, p_count);
+}
+
+uint32_t aabbs_intersect(const AABB &p_aabb, const AABB *p_aabbs, uint32_t p_count, uint32_t *r_indices) {
+	return aabbs_intersect_simd(p_aabb, p_aabbs, p_count, r_indices);
+}
+
+void project_box(const Transform3D &p_xform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	project_box_simd(p_xform, p_half_extents, p_axes, r_min, r_max, p_count);
+}
+
+void project_points(const Transform3D &p_xform, const Vector3 *p_points, uint32_t p_point_count, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_axis_count) {
+	project_points_simd(p_xform, p_points, p_point_count, p_axes, r_min, r_max, p_axis_count);
+}
+
+#else
+
+void xform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	xform_points_scalar(p_xform, p_src, r_dst, p_count);
+}
+
+void xform_aabbs(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	xform_aabbs_scalar(p_xform, p_src, r_dst, p_count);
+}
+
+void xform_transforms(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	xform_transforms_scalar(p_xform, p_src, r_dst, p_count);
+}
+
+uint32_t aabbs_intersect(const AABB &p_aabb, const AABB *p_aabbs, uint32_t p_count, uint32_t *r_indices) {
+	return aabbs_intersect_scalar(p_aabb, p_aabbs, p_count, r_indices);
+}
+
+void project_box(const Transform3D &p_xform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count) {
+	project_box_scalar(p_xform, p_half_extents, p_axes, r_min, r_max, p_count);
+}
+
+void project_points(const Transform3D &p_xform, const Vector3 *p_points, uint32_t p_point_count, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_axis_count) {
+	project_points_scalar(p_xform, p_points, p_point_count, p_axes, r_min, r_max, p_axis_count);
+}
+
+#endif
+
+} // namespace BatchMath
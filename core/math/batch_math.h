@@ -0,0 +1,77 @@
+/**************************************************************************/
+/*  batch_math.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
+#include "core/math/vector3.h"
+
+// Operations over arrays of points, AABBs and transforms, for hot loops like culling and skinning.
+// With single precision, these use SSE2 or NEON when the build targets them (they're part of the
+// x86_64 and arm64 baselines), and a scalar fallback otherwise. Results match the per-element
+// scalar operations, as they are evaluated in the same order.
+// Source and destination arrays may be the same, but must not otherwise overlap.
+namespace BatchMath {
+
+enum Backend {
+	BACKEND_SCALAR,
+	BACKEND_SSE2,
+	BACKEND_NEON,
+};
+
+Backend get_backend();
+const char *get_backend_name();
+
+// r_dst[i] = p_xform.xform(p_src[i])
+void xform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+// r_dst[i] = p_xform.xform(p_src[i])
+void xform_aabbs(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count);
+// r_dst[i] = p_xform * p_src[i]
+void xform_transforms(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count);
+// Writes the indices of the AABBs that intersect p_aabb (as in AABB::intersects()) and returns how many there are.
+// r_indices must have room for p_count elements.
+uint32_t aabbs_intersect(const AABB &p_aabb, const AABB *p_aabbs, uint32_t p_count, uint32_t *r_indices);
+// Projects a box, centered on the origin of p_xform and with the given half extents, onto each axis:
+// r_min[i] and r_max[i] are the range of p_axes[i].dot(point) over the points of the box.
+void project_box(const Transform3D &p_xform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count);
+// r_min[i] and r_max[i] are the range of p_axes[i].dot(p_xform.xform(p_points[j])) over the points.
+// Each point is only transformed once for several axes. Nothing is written if there are no points.
+void project_points(const Transform3D &p_xform, const Vector3 *p_points, uint32_t p_point_count, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_axis_count);
+
+// Scalar versions, always available. Mostly useful for testing and benchmarking.
+void xform_points_scalar(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+void xform_aabbs_scalar(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count);
+void xform_transforms_scalar(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count);
+uint32_t aabbs_intersect_scalar(const AABB &p_aabb, const AABB *p_aabbs, uint32_t p_count, uint32_t *r_indices);
+void project_box_scalar(const Transform3D &p_xform, const Vector3 &p_half_extents, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_count);
+void project_points_scalar(const Transform3D &p_xform, const Vector3 *p_points, uint32_t p_point_count, const Vector3 *p_axes, real_t *r_min, real_t *r_max, uint32_t p_axis_count);
+
+} // namespace BatchMath
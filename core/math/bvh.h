@@ -53,6 +53,7 @@
 #include "bvh_tree.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -298,10 +299,12 @@ public:
 	}
 
 	// call e.g. once per frame (this does a trickle optimize)
-	void update() {
+	// When multithreaded, the pairing culls of the changed items are spread over the worker threads,
+	// so this shouldn't be called from a worker thread that other tasks are waiting for.
+	void update(bool p_multithreaded = false) {
 		BVH_LOCKED_FUNCTION
 		tree.update();
-		_check_for_collisions();
+		_check_for_collisions(false, p_multithreaded);
 #ifdef BVH_INTEGRITY_CHECKS
 		tree._integrity_check_all();
 #endif
@@ -429,51 +432,81 @@ public:
 	}
 
 private:
-	// do this after moving etc.
-	void _check_for_collisions(bool p_full_check = false) {
-		if (!changed_items.size()) {
-			// noop
-			return;
-		}
+	// Below this many changed items, pairing runs on the calling thread.
+	static constexpr uint32_t THREADED_PAIRING_MIN_ITEMS = 64;
 
-		typename BVHTREE_CLASS::CullParams params;
+	void _fill_pairing_cullparams(BVHHandle p_handle, typename BVHTREE_CLASS::CullParams &r_params) {
+		// use the expanded aabb for pairing
+		const BOUNDS &expanded_aabb = tree._pairs[p_handle.id()].expanded_aabb;
+		r_params.abb.from(expanded_aabb);
 
-		params.result_count_overall = 0;
-		params.result_max = INT_MAX;
-		params.result_array = nullptr;
-		params.subindex_array = nullptr;
+		tree.item_fill_cullparams(p_handle, r_params);
+
+		r_params.result_count_overall = 0;
+		r_params.result_max = INT_MAX;
+		r_params.result_array = nullptr;
+		r_params.subindex_array = nullptr;
+	}
+
+	void _pair_changed_item(BVHHandle p_handle, const BVHABB_CLASS &p_abb, const LocalVector<uint32_t> &p_hits, bool p_full_check) {
+		// find all the existing paired aabbs that are no longer
+		// paired, and send callbacks
+		_find_leavers(p_handle, p_abb, p_full_check);
 
-		for (const BVHHandle &h : changed_items) {
-			// use the expanded aabb for pairing
-			const BOUNDS &expanded_aabb = tree._pairs[h.id()].expanded_aabb;
-			BVHABB_CLASS abb;
-			abb.from(expanded_aabb);
+		uint32_t changed_item_ref_id = p_handle.id();
 
-			tree.item_fill_cullparams(h, params);
+		for (const uint32_t ref_id : p_hits) {
+			// don't collide against ourself
+			if (ref_id == changed_item_ref_id) {
+				continue;
+			}
 
-			// find all the existing paired aabbs that are no longer
-			// paired, and send callbacks
-			_find_leavers(h, abb, p_full_check);
+			// checkmasks is already done in the cull routine.
+			BVHHandle h_collidee;
+			h_collidee.set_id(ref_id);
 
-			uint32_t changed_item_ref_id = h.id();
+			// find NEW enterers, and send callbacks for them only
+			_collide(p_handle, h_collidee);
+		}
+	}
 
-			params.abb = abb;
+	// Only reads the tree, so it can run for several items at once.
+	void _cull_changed_item(uint32_t p_index, void *p_userdata) {
+		typename BVHTREE_CLASS::CullParams params;
+		_fill_pairing_cullparams(changed_items[p_index], params);
+		params.hits = &changed_item_hits[p_index];
+		tree.cull_aabb(params, false);
+	}
 
-			params.result_count_overall = 0; // might not be needed
-			tree.cull_aabb(params, false);
+	// do this after moving etc.
+	void _check_for_collisions(bool p_full_check = false, bool p_multithreaded = false) {
+		if (!changed_items.size()) {
+			// noop
+			return;
+		}
 
-			for (const uint32_t ref_id : tree._cull_hits) {
-				// don't collide against ourself
-				if (ref_id == changed_item_ref_id) {
-					continue;
-				}
+		if (p_multithreaded && changed_items.size() >= THREADED_PAIRING_MIN_ITEMS) {
+			// The culls don't depend on the pairs, so they can all run first, in parallel.
+			// The pairs are then updated in the order of the changed items like below,
+			// so the callbacks are the same as on a single thread.
+			if (changed_item_hits.size() < changed_items.size()) {
+				changed_item_hits.resize(changed_items.size());
+			}
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_changed_item, nullptr, changed_items.size(), -1, true, SNAME("BVHPairing"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-				// checkmasks is already done in the cull routine.
-				BVHHandle h_collidee;
-				h_collidee.set_id(ref_id);
+			for (uint32_t n = 0; n < changed_items.size(); n++) {
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[changed_items[n].id()].expanded_aabb);
+				_pair_changed_item(changed_items[n], abb, changed_item_hits[n], p_full_check);
+			}
+		} else {
+			typename BVHTREE_CLASS::CullParams params;
 
-				// find NEW enterers, and send callbacks for them only
-				_collide(h, h_collidee);
+			for (const BVHHandle &h : changed_items) {
+				_fill_pairing_cullparams(h, params);
+				tree.cull_aabb(params, false);
+				_pair_changed_item(h, params.abb, tree._cull_hits, p_full_check);
 			}
 		}
 		_reset();
@@ -770,6 +803,8 @@ private:
 	// for collision pairing,
 	// maintain a list of all items moved etc on each frame / tick
 	LocalVector<BVHHandle> changed_items;
+	// The cull hits of each changed item, when pairing on several threads.
+	LocalVector<LocalVector<uint32_t>> changed_item_hits;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
 	class BVHLockedFunction {
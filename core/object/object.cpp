@@ -42,20 +42,17 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
+_ObjectDebugLock::_ObjectDebugLock(Object *p_obj) {
+	obj_id = p_obj->get_instance_id();
+	p_obj->_lock_index.ref();
+}
 
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
+_ObjectDebugLock::~_ObjectDebugLock() {
+	Object *obj_ptr = ObjectDB::get_instance(obj_id);
+	if (likely(obj_ptr)) {
+		obj_ptr->_lock_index.unref();
 	}
-};
+}
 
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
@@ -1276,14 +1273,10 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	// Shares the slots of the signal, so no connection is copied and nothing is allocated unless they changed.
+	// Disconnecting the signal or even deleting the object will not affect the signal calling.
+	Vector<SignalData::EmitSlot> shared_slots;
+	const Vector<SignalData::EmitSlot> &slots = shared_slots; // Only read through this, so it's never copied on write.
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1299,32 +1292,29 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
-		}
-
-		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
+		if (!s->emit_slots_valid) {
+			s->emit_slots.resize(s->slot_map.size());
+			SignalData::EmitSlot *emit_slots = s->emit_slots.ptrw();
+			for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
+				emit_slots->callable = slot_kv.value.conn.callable;
+				emit_slots->flags = slot_kv.value.conn.flags;
+				++emit_slots;
+			}
+			s->emit_slots_valid = true;
 		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		shared_slots = s->emit_slots;
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		for (const SignalData::EmitSlot &slot : slots) {
+			bool disconnect = slot.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+			if (disconnect && (slot.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 				disconnect = false;
 			}
 #endif
 			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				_disconnect(p_name, slot.callable);
 			}
 		}
 	}
@@ -1340,9 +1330,9 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	for (const SignalData::EmitSlot &slot : slots) {
+		const Callable &callable = slot.callable;
+		const uint32_t &flags = slot.flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1378,15 +1368,6 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
-
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
 		// because it would do the init ref logic, which is something this function
@@ -1637,6 +1618,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_emit_slots();
 
 	return OK;
 }
@@ -1717,6 +1699,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_emit_slots();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
@@ -2452,12 +2435,20 @@ void postinitialize_handler(Object *p_object) {
 }
 
 void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
+	// Objects are added and removed without locking, so this only prevents new blocks
+	// from being allocated. Objects being created or freed on other threads meanwhile
+	// may or may not be reported.
 	spin_lock.lock();
 
-	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
-			count--;
+	uint32_t max = slot_max.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < max; i++) {
+		const ObjectSlot &object_slot = _get_slot(i);
+		uint64_t validator = object_slot.get_validator();
+		if (validator) {
+			Object *object = object_slot.object.load(std::memory_order_acquire);
+			if (object && object_slot.get_validator() == validator) {
+				p_func(object, p_user_data);
+			}
 		}
 	}
 	spin_lock.unlock();
@@ -2509,56 +2500,115 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 }
 #endif
 
+// Marks the end of the free list. It's never handed out as a slot.
+#define OBJECTDB_SLOT_NONE uint32_t(OBJECTDB_SLOT_MAX_COUNT_MASK)
+#define OBJECTDB_NEXT_FREE_SHIFT OBJECTDB_VALIDATOR_BITS
+
 SpinLock ObjectDB::spin_lock;
-uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+SafeNumeric<uint32_t> ObjectDB::slot_count;
+std::atomic<uint32_t> ObjectDB::slot_max = 0;
+ObjectDB::ObjectSlot *ObjectDB::object_slot_blocks[OBJECTDB_SLOT_MAX_BLOCKS] = {};
+uint32_t ObjectDB::free_slot_head = OBJECTDB_SLOT_NONE;
+uint32_t ObjectDB::generation = 1;
+std::atomic<uint64_t> ObjectDB::validator_counter = 0;
+thread_local ObjectDB::ThreadSlotCache ObjectDB::thread_slot_cache;
+
+ObjectDB::ThreadSlotCache::~ThreadSlotCache() {
+	// Give the slots back, so they aren't lost when threads come and go.
+	if (count > 0 && generation == ObjectDB::generation) {
+		ObjectDB::_flush_thread_cache(*this, count);
+	}
+}
 
 int ObjectDB::get_object_count() {
-	return slot_count;
+	return slot_count.get();
 }
 
-ObjectID ObjectDB::add_instance(Object *p_object) {
+void ObjectDB::_refill_thread_cache(ThreadSlotCache &p_cache) {
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+	if (p_cache.generation != generation) {
+		p_cache.count = 0;
+		p_cache.generation = generation;
+	}
+
+	while (p_cache.count < OBJECTDB_THREAD_CACHE_SIZE / 2) {
+		if (unlikely(free_slot_head == OBJECTDB_SLOT_NONE)) {
+			uint32_t block = slot_max.load(std::memory_order_relaxed) >> OBJECTDB_SLOT_BLOCK_BITS;
+			if (unlikely(block == OBJECTDB_SLOT_MAX_BLOCKS)) {
+				spin_lock.unlock();
+				CRASH_NOW_MSG("Too many object instances.");
+			}
+
+			ObjectSlot *slots = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_BLOCK_SIZE);
+			uint32_t first = block << OBJECTDB_SLOT_BLOCK_BITS;
+			uint32_t last = first + OBJECTDB_SLOT_BLOCK_SIZE - 1;
+			if (last == OBJECTDB_SLOT_NONE) {
+				last--;
+			}
+			for (uint32_t i = 0; i < OBJECTDB_SLOT_BLOCK_SIZE; i++) {
+				uint32_t next = first + i < last ? first + i + 1 : OBJECTDB_SLOT_NONE;
+				memnew_placement(&slots[i], ObjectSlot);
+				slots[i].state.store(uint64_t(next) << OBJECTDB_NEXT_FREE_SHIFT, std::memory_order_relaxed);
+				slots[i].object.store(nullptr, std::memory_order_relaxed);
+			}
+			object_slot_blocks[block] = slots;
+			free_slot_head = first;
+			// Publishes the block to lock-free readers.
+			slot_max.store(first + OBJECTDB_SLOT_BLOCK_SIZE, std::memory_order_release);
 		}
-		slot_max = new_slot_max;
+
+		uint32_t slot = free_slot_head;
+		free_slot_head = (_get_slot(slot).state.load(std::memory_order_relaxed) >> OBJECTDB_NEXT_FREE_SHIFT) & OBJECTDB_SLOT_MAX_COUNT_MASK;
+		p_cache.slots[p_cache.count++] = slot;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
-		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+	spin_lock.unlock();
+}
+
+void ObjectDB::_flush_thread_cache(ThreadSlotCache &p_cache, uint32_t p_count) {
+	spin_lock.lock();
+
+	for (uint32_t i = 0; i < p_count && p_cache.count > 0; i++) {
+		uint32_t slot = p_cache.slots[--p_cache.count];
+		// The validator was already cleared, so readers can't match this slot.
+		_get_slot(slot).state.store(uint64_t(free_slot_head) << OBJECTDB_NEXT_FREE_SHIFT, std::memory_order_release);
+		free_slot_head = slot;
+	}
+
+	spin_lock.unlock();
+}
+
+ObjectID ObjectDB::add_instance(Object *p_object) {
+	ThreadSlotCache &cache = thread_slot_cache;
+	if (unlikely(cache.count == 0 || cache.generation != generation)) {
+		_refill_thread_cache(cache);
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+
+	// This thread owns the slot now, so no lock is needed to set it up.
+	uint32_t slot = cache.slots[--cache.count];
+	ObjectSlot &object_slot = _get_slot(slot);
+
+	uint64_t validator = (validator_counter.fetch_add(1, std::memory_order_relaxed) + 1) & OBJECTDB_VALIDATOR_MASK;
+	if (unlikely(validator == 0)) {
+		validator = (validator_counter.fetch_add(1, std::memory_order_relaxed) + 1) & OBJECTDB_VALIDATOR_MASK;
 	}
-	object_slots[slot].validator = validator_counter;
 
-	uint64_t id = validator_counter;
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
 	id |= uint64_t(slot);
 
+	uint64_t state = validator;
 	if (p_object->is_ref_counted()) {
 		id |= OBJECTDB_REFERENCE_BIT;
+		state |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
+	// The object must be visible before the validator that makes the slot match.
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.state.store(state, std::memory_order_release);
 
-	spin_lock.unlock();
+	slot_count.increment();
 
 	return ObjectID(id);
 }
@@ -2567,33 +2617,31 @@ void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
 
-	spin_lock.lock();
+	ObjectSlot &object_slot = _get_slot(slot);
 
 #ifdef DEBUG_ENABLED
-
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_acquire) != p_object);
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
-		}
+		ERR_FAIL_COND(object_slot.get_validator() != validator);
 	}
-
 #endif
-	//decrease slot count
-	slot_count--;
-	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
+
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	object_slot.state.store(0, std::memory_order_release);
+	object_slot.object.store(nullptr, std::memory_order_release);
 
-	spin_lock.unlock();
+	slot_count.decrement();
+
+	ThreadSlotCache &cache = thread_slot_cache;
+	if (unlikely(cache.generation != generation)) {
+		cache.count = 0;
+		cache.generation = generation;
+	}
+	if (unlikely(cache.count == OBJECTDB_THREAD_CACHE_SIZE)) {
+		_flush_thread_cache(cache, OBJECTDB_THREAD_CACHE_SIZE / 2);
+	}
+	cache.slots[cache.count++] = slot;
 }
 
 void ObjectDB::setup() {
@@ -2603,7 +2651,7 @@ void ObjectDB::setup() {
 void ObjectDB::cleanup() {
 	spin_lock.lock();
 
-	if (slot_count > 0) {
+	if (slot_count.get() > 0) {
 		WARN_PRINT("ObjectDB instances leaked at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
 			// Ensure calling the native classes because if a leaked instance has a script
@@ -2613,9 +2661,11 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+			uint32_t max = slot_max.load(std::memory_order_acquire);
+			for (uint32_t i = 0, count = slot_count.get(); i < max && count != 0; i++) {
+				const ObjectSlot &object_slot = _get_slot(i);
+				if (object_slot.get_validator()) {
+					Object *obj = object_slot.object.load(std::memory_order_acquire);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2628,7 +2678,8 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t state = object_slot.state.load(std::memory_order_acquire);
+					uint64_t id = uint64_t(i) | ((state & OBJECTDB_VALIDATOR_MASK) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (state & OBJECTDB_REFERENCE_BIT);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2639,9 +2690,15 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	uint32_t block_count = slot_max.load(std::memory_order_relaxed) >> OBJECTDB_SLOT_BLOCK_BITS;
+	for (uint32_t i = 0; i < block_count; i++) {
+		memfree(object_slot_blocks[i]);
+		object_slot_blocks[i] = nullptr;
 	}
+	slot_max.store(0, std::memory_order_release);
+	slot_count.set(0);
+	free_slot_head = OBJECTDB_SLOT_NONE;
+	generation++; // Invalidates the slots cached by threads.
 
 	spin_lock.unlock();
 }
@@ -635,9 +635,24 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// The slots as `emit_signalp()` calls them, made again from `slot_map` on the first emission after it changed.
+		// Emissions share it rather than copying the slots, and keep calling the ones they started with if it changes.
+		struct EmitSlot {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		Vector<EmitSlot> emit_slots;
+		bool emit_slots_valid = false;
 		bool removable = false;
+
+		void invalidate_emit_slots() {
+			// Left to the emissions in progress, if any.
+			emit_slots = Vector<EmitSlot>();
+			emit_slots_valid = false;
+		}
 	};
 	friend struct _ObjectSignalLock;
 	mutable Mutex *signal_mutex = nullptr;
@@ -1051,6 +1066,17 @@ public:
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
+#ifdef DEBUG_ENABLED
+// Held while calling a method of the object, so it can't be freed during the call.
+// Also used by script languages calling methods without going through `Object::callp()`.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj);
+	~_ObjectDebugLock();
+};
+#endif // DEBUG_ENABLED
+
 template <typename T, typename O>
 bool Object::derives_from() const {
 	if constexpr (std::is_base_of_v<T, O>) {
@@ -1077,24 +1103,49 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
+// Slots are allocated in blocks that never move, so they can be read without locking.
+#define OBJECTDB_SLOT_BLOCK_BITS 12
+#define OBJECTDB_SLOT_BLOCK_SIZE (uint32_t(1) << OBJECTDB_SLOT_BLOCK_BITS)
+#define OBJECTDB_SLOT_BLOCK_MASK (OBJECTDB_SLOT_BLOCK_SIZE - 1)
+#define OBJECTDB_SLOT_MAX_BLOCKS (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_BLOCK_BITS))
+// Slots cached per thread, so most allocations and frees don't need the lock.
+#define OBJECTDB_THREAD_CACHE_SIZE 64
 
 	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+		// Packs the validator, the next free slot (while in the free list) and the
+		// is_ref_counted flag, the same way the ObjectID does.
+		std::atomic<uint64_t> state;
+		std::atomic<Object *> object;
+
+		_ALWAYS_INLINE_ uint64_t get_validator() const { return state.load(std::memory_order_acquire) & OBJECTDB_VALIDATOR_MASK; }
+	};
+
+	struct ThreadSlotCache {
+		uint32_t slots[OBJECTDB_THREAD_CACHE_SIZE];
+		uint32_t count = 0;
+		uint32_t generation = 0; // Cached slots are stale if the ObjectDB has been cleaned up since.
+		~ThreadSlotCache();
 	};
 
-	static SpinLock spin_lock;
-	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static SpinLock spin_lock; // Guards the free list and block allocation. Not needed for reading.
+	static SafeNumeric<uint32_t> slot_count;
+	static std::atomic<uint32_t> slot_max;
+	static ObjectSlot *object_slot_blocks[OBJECTDB_SLOT_MAX_BLOCKS];
+	static uint32_t free_slot_head;
+	static uint32_t generation;
+	static std::atomic<uint64_t> validator_counter;
+	static thread_local ThreadSlotCache thread_slot_cache;
 
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
 
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_slot_blocks[p_slot >> OBJECTDB_SLOT_BLOCK_BITS][p_slot & OBJECTDB_SLOT_BLOCK_MASK];
+	}
+	static void _refill_thread_cache(ThreadSlotCache &p_cache);
+	static void _flush_thread_cache(ThreadSlotCache &p_cache, uint32_t p_count);
+
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
 
@@ -1108,20 +1159,21 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ERR_FAIL_COND_V(slot >= slot_max.load(std::memory_order_acquire), nullptr); // This should never happen unless RID is corrupted.
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
+		const ObjectSlot &object_slot = _get_slot(slot);
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.get_validator() != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The slot may have been freed and reused while reading the object. The validator would have changed then.
+		if (unlikely(object_slot.get_validator() != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
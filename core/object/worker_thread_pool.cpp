@@ -34,6 +34,7 @@
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/inline_vector.h"
 
 WorkerThreadPool::Task *const WorkerThreadPool::ThreadData::YIELDING = (Task *)1;
 
@@ -121,6 +122,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (do_post) {
 			p_task->group->done_semaphore.post();
 			p_task->group->completed.set_to(true);
+			if (p_task->group->graph_node) {
+				_finish_graph_node(p_task->group->graph_node);
+			}
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -133,6 +137,20 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 		// For groups, tasks get rid of themselves.
 
+		task_mutex.lock();
+		task_allocator.free(p_task);
+	} else if (p_task->graph_node) {
+		// Empty group nodes are posted as tasks without any function.
+		if (p_task->native_func) {
+			p_task->native_func(p_task->native_func_userdata);
+		} else if (p_task->template_userdata) {
+			p_task->template_userdata->callback();
+			memdelete(p_task->template_userdata);
+		}
+
+		_finish_graph_node(p_task->graph_node);
+
+		// Nobody can wait for graph tasks, so they get rid of themselves.
 		task_mutex.lock();
 		task_allocator.free(p_task);
 	} else {
@@ -155,7 +173,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		for (uint32_t i = 0; i < threads.size(); i++) {
 			if (threads[i].awaited_task == p_task) {
 				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
+				threads[i].signaled.set();
 			}
 		}
 	}
@@ -186,8 +204,11 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: grab a task from the local queues (own first, then stealing) without locking.
+		Task *task_to_process = thread_data->pool->_pop_local_task(thread_data);
+		if (task_to_process) {
+			thread_data->signaled.clear();
+		} else {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -198,7 +219,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 					return;
 				}
 
-				thread_data->signaled = false;
+				thread_data->signaled.clear();
+
+				// Tasks are only ever posted with the mutex held, so checking again here can't miss any.
+				task_to_process = thread_data->pool->_pop_local_task(thread_data);
+				if (task_to_process) {
+					break;
+				}
 
 				if (!thread_data->pool->task_queue.first()) {
 					// There wasn't a task available yet.
@@ -246,7 +273,9 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && !p_pump_task && _push_local_task(caller_pool_thread, p_tasks[i])) {
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -283,7 +312,7 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 			i++, notify_index = (notify_index + 1) % thread_count) {
 		ThreadData &th = threads[notify_index];
 
-		if (th.signaled) {
+		if (th.signaled.is_set()) {
 			continue;
 		}
 		if (th.current_task) {
@@ -292,7 +321,7 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
-				th.signaled = true;
+				th.signaled.set();
 				to_promote--;
 			}
 		} else {
@@ -300,7 +329,7 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
-				th.signaled = true;
+				th.signaled.set();
 				to_process--;
 			}
 		}
@@ -313,19 +342,54 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 			i++, notify_index = (notify_index + 1) % thread_count) {
 		ThreadData &th = threads[notify_index];
 
-		if (th.signaled) {
+		if (th.signaled.is_set()) {
 			continue;
 		}
 		if (th.awaited_task) {
 			if (likely(&th != p_current_thread_data)) {
 				th.cond_var.notify_one();
 			}
-			th.signaled = true;
+			th.signaled.set();
 			to_process--;
 		}
 	}
 }
 
+bool WorkerThreadPool::_push_local_task(ThreadData *p_caller_pool_thread, Task *p_task) {
+	// Tasks posted from a pool thread go to its own queue, to keep nested work local.
+	// Otherwise, they're spread across the queues. Either way, idle threads will steal them.
+	uint32_t queue_count = local_queue_count.get();
+	uint32_t start = p_caller_pool_thread ? p_caller_pool_thread->index : post_index++;
+	for (uint32_t i = 0; i < queue_count; i++) {
+		if (threads.ptr()[(start + i) % queue_count].local_queue.push(p_task)) {
+			return true;
+		}
+	}
+	return false; // All full; the caller will fall back to the global queue.
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_task(ThreadData *p_thread_data) {
+	// May be called without holding the task mutex, so don't rely on the size of the thread array.
+	uint32_t queue_count = local_queue_count.get();
+	Task *task = nullptr;
+	for (uint32_t i = 0; i < queue_count; i++) {
+		if (threads.ptr()[(p_thread_data->index + i) % queue_count].local_queue.pop(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	uint32_t queue_count = local_queue_count.get();
+	for (uint32_t i = 0; i < queue_count; i++) {
+		if (!threads.ptr()[i].local_queue.is_empty_approx()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -369,6 +433,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 			threads.resize_initialized(thread_count + 1);
 			threads[thread_count].index = thread_count;
 			threads[thread_count].pool = this;
+			local_queue_count.set(thread_count + 1);
 			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
 			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
 		}
@@ -492,8 +557,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 		{
 			MutexLock lock(task_mutex);
 
-			bool was_signaled = p_caller_pool_thread->signaled;
-			p_caller_pool_thread->signaled = false;
+			bool was_signaled = p_caller_pool_thread->signaled.is_set();
+			p_caller_pool_thread->signaled.clear();
 
 			bool exit = _handle_runlevel(p_caller_pool_thread, lock);
 			if (unlikely(exit)) {
@@ -516,11 +581,11 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
-						p_caller_pool_thread->signaled = true;
+						p_caller_pool_thread->signaled.set();
 						_notify_threads(p_caller_pool_thread, to_process, to_promote);
 					}
 				}
@@ -534,7 +599,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			task_to_process = _pop_local_task(p_caller_pool_thread);
+			if (!task_to_process && task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -574,7 +640,7 @@ void WorkerThreadPool::_switch_runlevel(Runlevel p_runlevel) {
 	memset(&runlevel_data, 0, sizeof(runlevel_data));
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].cond_var.notify_one();
-		threads[i].signaled = true;
+		threads[i].signaled.set();
 	}
 	control_cond_var.notify_all();
 }
@@ -587,7 +653,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -646,7 +712,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 
 	ThreadData &td = threads[task->pool_thread_index];
 	td.yield_is_over = true;
-	td.signaled = true;
+	td.signaled.set();
 	td.cond_var.notify_one();
 }
 
@@ -705,6 +771,213 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskGraphID WorkerThreadPool::create_task_graph(const String &p_description) {
+	MutexLock task_lock(task_mutex);
+	TaskGraph *graph = memnew(TaskGraph);
+	graph->self = last_task++;
+	graph->description = p_description;
+	task_graphs.insert(graph->self, graph);
+	return graph->self;
+}
+
+WorkerThreadPool::GraphNodeID WorkerThreadPool::_add_graph_node(TaskGraphID p_graph, void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, Span<GraphNodeID> p_dependencies, bool p_high_priority) {
+	MutexLock task_lock(task_mutex);
+	TaskGraph **graphp = task_graphs.getptr(p_graph);
+	if (unlikely(!graphp || (*graphp)->submitted)) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_COND_V_MSG(!graphp, UINT32_MAX, "Invalid Task Graph ID.");
+		ERR_FAIL_V_MSG(UINT32_MAX, "Nodes can't be added to a task graph once submitted.");
+	}
+	TaskGraph *graph = *graphp;
+	GraphNodeID id = graph->nodes.size();
+
+	GraphNode *node = memnew(GraphNode);
+	node->graph = graph;
+	node->native_func = p_func;
+	node->native_group_func = p_group_func;
+	node->native_func_userdata = p_userdata;
+	node->template_userdata = p_template_userdata;
+	node->elements = p_elements;
+	node->tasks = p_tasks < 0 ? MAX(1u, threads.size()) : p_tasks;
+	node->high_priority = p_high_priority;
+	for (GraphNodeID dependency : p_dependencies) {
+		// Only depending on earlier nodes keeps the graph acyclic.
+		ERR_CONTINUE_MSG(dependency >= id, "Task graph nodes can only depend on nodes added before them.");
+		graph->nodes[dependency]->dependents.push_back(id);
+		node->dependency_count++;
+	}
+	graph->nodes.push_back(node);
+	return id;
+}
+
+WorkerThreadPool::GraphNodeID WorkerThreadPool::add_graph_native_task(TaskGraphID p_graph, void (*p_func)(void *), void *p_userdata, Span<GraphNodeID> p_dependencies, bool p_high_priority) {
+	return _add_graph_node(p_graph, p_func, nullptr, p_userdata, nullptr, -1, 0, p_dependencies, p_high_priority);
+}
+
+WorkerThreadPool::GraphNodeID WorkerThreadPool::add_graph_native_group_task(TaskGraphID p_graph, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, Span<GraphNodeID> p_dependencies, bool p_high_priority) {
+	ERR_FAIL_COND_V(p_elements < 0, UINT32_MAX);
+	return _add_graph_node(p_graph, nullptr, p_func, p_userdata, nullptr, p_elements, p_tasks, p_dependencies, p_high_priority);
+}
+
+void WorkerThreadPool::set_task_graph_completion_callback(TaskGraphID p_graph, void (*p_func)(void *), void *p_userdata) {
+	MutexLock task_lock(task_mutex);
+	TaskGraph **graphp = task_graphs.getptr(p_graph);
+	ERR_FAIL_NULL_MSG(graphp, "Invalid Task Graph ID.");
+	ERR_FAIL_COND_MSG((*graphp)->submitted, "The completion callback can't be changed once the task graph is submitted.");
+	(*graphp)->completion_func = p_func;
+	(*graphp)->completion_userdata = p_userdata;
+}
+
+void WorkerThreadPool::submit_task_graph(TaskGraphID p_graph, bool p_detached) {
+	MutexLock<BinaryMutex> lock(task_mutex);
+	TaskGraph **graphp = task_graphs.getptr(p_graph);
+	ERR_FAIL_NULL_MSG(graphp, "Invalid Task Graph ID.");
+	TaskGraph *graph = *graphp;
+	ERR_FAIL_COND_MSG(graph->submitted, "The task graph was already submitted.");
+	graph->submitted = true;
+	graph->detached = p_detached;
+
+	if (graph->nodes.is_empty()) {
+		lock.temp_unlock();
+		_finish_task_graph(graph);
+		return;
+	}
+
+	// Gather the roots before posting any, since a dependent may become ready as soon as its dependencies complete.
+	graph->pending_nodes.set(graph->nodes.size());
+	GraphNode **roots = (GraphNode **)alloca(sizeof(GraphNode *) * graph->nodes.size());
+	uint32_t root_count = 0;
+	for (GraphNode *node : graph->nodes) {
+		node->pending_dependencies.set(node->dependency_count);
+		if (node->dependency_count == 0) {
+			roots[root_count++] = node;
+		}
+	}
+	for (uint32_t i = 0; i < root_count; i++) {
+		_post_graph_node(roots[i], lock);
+	}
+}
+
+void WorkerThreadPool::_post_graph_node(GraphNode *p_node, MutexLock<BinaryMutex> &p_lock) {
+	if (p_node->elements <= 0) {
+		Task *task = task_allocator.alloc();
+		task->graph_node = p_node;
+		task->description = p_node->graph->description;
+		if (p_node->elements < 0) {
+			task->native_func = p_node->native_func;
+			task->native_func_userdata = p_node->native_func_userdata;
+			task->template_userdata = p_node->template_userdata;
+		} else if (p_node->template_userdata) {
+			// Nothing to run, but the node still has to complete for its dependents to be posted.
+			memdelete(p_node->template_userdata);
+		}
+		_post_tasks(&task, 1, p_node->high_priority, p_lock, false);
+		return;
+	}
+
+	Group *group = group_allocator.alloc();
+	group->max = p_node->elements;
+	group->tasks_used = p_node->tasks;
+	group->graph_node = p_node;
+	// Nobody waits for the group, so account for the waiting user upfront.
+	group->finished.set(1);
+
+	Task **tasks_posted = (Task **)alloca(sizeof(Task *) * p_node->tasks);
+	for (int i = 0; i < p_node->tasks; i++) {
+		Task *task = task_allocator.alloc();
+		task->native_group_func = p_node->native_group_func;
+		task->native_func_userdata = p_node->native_func_userdata;
+		task->description = p_node->graph->description;
+		task->group = group;
+		task->template_userdata = p_node->template_userdata;
+		tasks_posted[i] = task;
+	}
+
+	_post_tasks(tasks_posted, p_node->tasks, p_node->high_priority, p_lock, false);
+}
+
+void WorkerThreadPool::_finish_graph_node(GraphNode *p_node) {
+	TaskGraph *graph = p_node->graph;
+
+	InlineVector<GraphNode *, 8> ready;
+	for (GraphNodeID dependent : p_node->dependents) {
+		GraphNode *node = graph->nodes[dependent];
+		if (node->pending_dependencies.decrement() == 0) {
+			ready.push_back(node);
+		}
+	}
+	if (!ready.is_empty()) {
+		MutexLock<BinaryMutex> lock(task_mutex);
+		for (GraphNode *node : ready) {
+			_post_graph_node(node, lock);
+		}
+	}
+
+	if (graph->pending_nodes.decrement() == 0) {
+		_finish_task_graph(graph);
+	}
+}
+
+void WorkerThreadPool::_finish_task_graph(TaskGraph *p_graph) {
+	if (p_graph->completion_func) {
+		p_graph->completion_func(p_graph->completion_userdata);
+	}
+
+	MutexLock task_lock(task_mutex);
+	p_graph->completed = true;
+	if (p_graph->detached) {
+		task_graphs.erase(p_graph->self);
+		_free_task_graph(p_graph);
+	} else {
+		p_graph->done_semaphore.post();
+	}
+}
+
+void WorkerThreadPool::_free_task_graph(TaskGraph *p_graph) {
+	for (GraphNode *node : p_graph->nodes) {
+		if (!p_graph->submitted && node->template_userdata) {
+			memdelete(node->template_userdata); // Otherwise, it was freed by the tasks running the node.
+		}
+		memdelete(node);
+	}
+	memdelete(p_graph);
+}
+
+bool WorkerThreadPool::is_task_graph_completed(TaskGraphID p_graph) const {
+	MutexLock task_lock(task_mutex);
+	const TaskGraph *const *graphp = task_graphs.getptr(p_graph);
+	if (!graphp) {
+		ERR_FAIL_V_MSG(false, "Invalid Task Graph ID.");
+	}
+	return (*graphp)->completed;
+}
+
+void WorkerThreadPool::wait_for_task_graph_completion(TaskGraphID p_graph) {
+	task_mutex.lock();
+	TaskGraph **graphp = task_graphs.getptr(p_graph);
+	TaskGraph *graph = graphp ? *graphp : nullptr;
+	task_mutex.unlock();
+	ERR_FAIL_NULL_MSG(graph, "Invalid Task Graph ID.");
+
+	if (graph->submitted) {
+		if (this == singleton) {
+			_unlock_unlockable_mutexes();
+		}
+		graph->done_semaphore.wait();
+		if (this == singleton) {
+			_lock_unlockable_mutexes();
+		}
+	} else {
+		ERR_PRINT("Waiting for a task graph that was never submitted; discarding it.");
+	}
+
+	MutexLock task_lock(task_mutex);
+	task_graphs.erase(p_graph);
+	_free_task_graph(graph);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -825,6 +1098,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	threads.reserve(5);
 #endif
 	threads.resize(p_thread_count);
+	local_queue_count.set(threads.size());
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
@@ -879,8 +1153,13 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		for (KeyValue<TaskGraphID, TaskGraph *> &E : task_graphs) {
+			_free_task_graph(E.value);
+		}
+		task_graphs.clear();
 	}
 
+	local_queue_count.set(0);
 	threads.clear();
 }
 
@@ -36,10 +36,12 @@
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/lock_free_queue.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/span.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -50,9 +52,12 @@ public:
 
 	typedef int64_t TaskID;
 	typedef int64_t GroupID;
+	typedef int64_t TaskGraphID;
+	typedef uint32_t GraphNodeID; // Index of the node within its graph.
 
 private:
 	struct Task;
+	struct GraphNode;
 
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
@@ -69,6 +74,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		GraphNode *graph_node = nullptr;
 	};
 
 	struct Task {
@@ -89,6 +95,7 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		GraphNode *graph_node = nullptr; // Graph tasks have no ID and get rid of themselves, as group ones.
 
 		void free_template_userdata();
 		Task() :
@@ -98,8 +105,38 @@ private:
 				task_elem(this) {}
 	};
 
+	struct TaskGraph;
+
+	struct GraphNode {
+		TaskGraph *graph = nullptr;
+		void (*native_func)(void *) = nullptr;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		BaseTemplateUserdata *template_userdata = nullptr;
+		int elements = -1; // Negative for single tasks.
+		int tasks = 0;
+		bool high_priority = true;
+		uint32_t dependency_count = 0;
+		SafeNumeric<uint32_t> pending_dependencies;
+		LocalVector<GraphNodeID> dependents; // Not modified once the graph is submitted.
+	};
+
+	struct TaskGraph {
+		TaskGraphID self = -1;
+		String description;
+		LocalVector<GraphNode *> nodes;
+		SafeNumeric<uint32_t> pending_nodes;
+		void (*completion_func)(void *) = nullptr;
+		void *completion_userdata = nullptr;
+		Semaphore done_semaphore;
+		bool submitted = false;
+		bool detached = false;
+		bool completed = false; // Protected by the task mutex.
+	};
+
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256; // Must be a power of two.
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -114,7 +151,10 @@ private:
 
 		uint32_t index = 0;
 		Thread thread;
-		bool signaled : 1;
+		// High-priority tasks are posted to per-thread queues, which any thread can pop from
+		// (stealing, if the queue belongs to another thread) without taking the task mutex.
+		LockFreeQueue<Task *, LOCAL_QUEUE_SIZE> local_queue;
+		SafeFlag signaled; // Atomic so it can be cleared when a task is taken without locking.
 		bool yield_is_over : 1;
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
@@ -125,7 +165,6 @@ private:
 		WorkerThreadPool *pool = nullptr;
 
 		ThreadData() :
-				signaled(false),
 				yield_is_over(false),
 				pre_exited_languages(false),
 				exited_languages(false),
@@ -133,6 +172,7 @@ private:
 	};
 
 	TightLocalVector<ThreadData> threads;
+	SafeNumeric<uint32_t> local_queue_count; // Number of threads whose local queue may be stolen from; grows with pump task threads.
 	enum Runlevel {
 		RUNLEVEL_NORMAL,
 		RUNLEVEL_PRE_EXIT_LANGUAGES, // Block adding new tasks
@@ -164,10 +204,12 @@ private:
 			HashMapComparatorDefault<GroupID>,
 			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
 			groups;
+	HashMap<TaskGraphID, TaskGraph *> task_graphs;
 
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	uint32_t post_index = 0; // For rotating across local queues when posting from outside the pool.
 
 	uint64_t last_task = 1;
 	int pump_task_count = 0;
@@ -183,6 +225,10 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	bool _push_local_task(ThreadData *p_caller_pool_thread, Task *p_task);
+	Task *_pop_local_task(ThreadData *p_thread_data);
+	bool _has_local_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -197,6 +243,12 @@ private:
 	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
 	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
 
+	GraphNodeID _add_graph_node(TaskGraphID p_graph, void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, Span<GraphNodeID> p_dependencies, bool p_high_priority);
+	void _post_graph_node(GraphNode *p_node, MutexLock<BinaryMutex> &p_lock);
+	void _finish_graph_node(GraphNode *p_node);
+	void _finish_task_graph(TaskGraph *p_graph);
+	void _free_task_graph(TaskGraph *p_graph);
+
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
 		C *instance;
@@ -267,6 +319,39 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Task graphs are built from tasks and groups that can depend on nodes added to the same graph before them.
+	// Once submitted, a node is posted by whichever thread completes the last of its dependencies, so nobody
+	// has to block between phases. The graph can be waited for (which also frees it) at the latest point
+	// its results are needed, polled, or detached so it frees itself when done.
+	TaskGraphID create_task_graph(const String &p_description = String());
+	template <typename C, typename M, typename U>
+	GraphNodeID add_graph_template_task(TaskGraphID p_graph, C *p_instance, M p_method, U p_userdata, Span<GraphNodeID> p_dependencies = Span<GraphNodeID>(), bool p_high_priority = true) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_graph_node(p_graph, nullptr, nullptr, nullptr, ud, -1, 0, p_dependencies, p_high_priority);
+	}
+	GraphNodeID add_graph_native_task(TaskGraphID p_graph, void (*p_func)(void *), void *p_userdata, Span<GraphNodeID> p_dependencies = Span<GraphNodeID>(), bool p_high_priority = true);
+	template <typename C, typename M, typename U>
+	GraphNodeID add_graph_template_group_task(TaskGraphID p_graph, C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, Span<GraphNodeID> p_dependencies = Span<GraphNodeID>(), bool p_high_priority = true) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_graph_node(p_graph, nullptr, nullptr, nullptr, ud, p_elements, p_tasks, p_dependencies, p_high_priority);
+	}
+	GraphNodeID add_graph_native_group_task(TaskGraphID p_graph, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, Span<GraphNodeID> p_dependencies = Span<GraphNodeID>(), bool p_high_priority = true);
+	// Called by the thread completing the last node, before the graph is flagged as completed.
+	void set_task_graph_completion_callback(TaskGraphID p_graph, void (*p_func)(void *), void *p_userdata);
+	// Starts the nodes without dependencies and returns right away.
+	// A detached graph gets rid of itself once completed, and its ID must not be used after submitting it.
+	void submit_task_graph(TaskGraphID p_graph, bool p_detached = false);
+	bool is_task_graph_completed(TaskGraphID p_graph) const;
+	void wait_for_task_graph_completion(TaskGraphID p_graph);
+
 	_FORCE_INLINE_ int get_thread_count() const {
 #ifdef THREADS_ENABLED
 		return threads.size();
@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+
+SafeNumeric<uint64_t> FrameArena::total_reserved;
+SafeNumeric<uint64_t> FrameArena::total_high_water_mark;
+
+static BinaryMutex arenas_mutex;
+static FrameArena *arenas_first = nullptr;
+
+FrameArena::Chunk *FrameArena::_alloc_chunk(uint64_t p_size) {
+	Chunk *chunk = (Chunk *)Memory::alloc_static(CHUNK_HEADER_SIZE + p_size);
+	CRASH_COND_MSG(!chunk, "Out of memory");
+	memnew_placement(chunk, Chunk);
+	chunk->size = p_size;
+	reserved.add(p_size);
+	total_reserved.add(p_size);
+	return chunk;
+}
+
+void FrameArena::_free_chunks() {
+	Chunk *chunk = first;
+	while (chunk) {
+		Chunk *next = chunk->next;
+		reserved.sub(chunk->size);
+		total_reserved.sub(chunk->size);
+		Memory::free_static(chunk);
+		chunk = next;
+	}
+	first = nullptr;
+	current = nullptr;
+}
+
+void FrameArena::_grow(uint64_t p_size) {
+	// Reuse a chunk left over from a previous rewind, if it's big enough.
+	Chunk *next = current ? current->next : first;
+	if (next && next->size >= p_size) {
+		current = next;
+		current->used = 0;
+		return;
+	}
+
+	// Otherwise, at least double the arena, so it quickly stops growing.
+	Chunk *chunk = _alloc_chunk(MAX(MAX(MIN_CHUNK_SIZE, reserved.get()), p_size));
+	chunk->next = next;
+	if (current) {
+		current->next = chunk;
+	} else {
+		first = chunk;
+	}
+	current = chunk;
+}
+
+void FrameArena::_update_high_water_mark() {
+	const uint64_t previous = high_water_mark.get();
+	high_water_mark.set(used);
+	total_high_water_mark.add(used - previous);
+}
+
+void *FrameArena::realloc(void *p_ptr, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+
+	uint8_t *mem = (uint8_t *)p_ptr;
+	uint64_t *bytes = (uint64_t *)(mem - ALLOC_HEADER_SIZE);
+	if (_is_last(mem, *bytes)) {
+		// Grow or shrink in place.
+		const uint64_t old_size = _alloc_size(*bytes);
+		const uint64_t new_size = _alloc_size(p_bytes);
+		if (current->used - old_size + new_size <= current->size) {
+			current->used = current->used - old_size + new_size;
+			used = used - old_size + new_size;
+			if (used > high_water_mark.get()) {
+				_update_high_water_mark();
+			}
+			*bytes = p_bytes;
+			return p_ptr;
+		}
+	}
+
+	const uint64_t old_bytes = *bytes;
+	void *new_mem = alloc(p_bytes);
+	memcpy(new_mem, p_ptr, MIN(old_bytes, (uint64_t)p_bytes));
+	free(p_ptr);
+	return new_mem;
+}
+
+void FrameArena::rewind(const Marker &p_marker) {
+	// Everything allocated after the marker is in its chunk or the ones following it, up to the current one.
+	Chunk *chunk = p_marker.chunk ? p_marker.chunk->next : first;
+	if (current && current != p_marker.chunk) {
+		while (chunk) {
+			chunk->used = 0;
+			if (chunk == current) {
+				break;
+			}
+			chunk = chunk->next;
+		}
+	}
+
+	current = p_marker.chunk;
+	if (current) {
+		current->used = p_marker.chunk_used;
+	}
+	used = p_marker.used;
+
+	if (used == 0 && first && first->next) {
+		// Replace the chain with a single chunk big enough for everything, so the next
+		// frame's allocations are contiguous.
+		const uint64_t size = reserved.get();
+		_free_chunks();
+		first = _alloc_chunk(size);
+	}
+}
+
+FrameArena *FrameArena::get_thread_arena() {
+	static thread_local FrameArena thread_arena("Thread");
+	return &thread_arena;
+}
+
+LocalVector<FrameArena::Stats> FrameArena::get_arena_stats() {
+	LocalVector<Stats> stats;
+	MutexLock lock(arenas_mutex);
+	for (FrameArena *arena = arenas_first; arena; arena = arena->next_arena) {
+		Stats arena_stats;
+		arena_stats.name = arena->name;
+		arena_stats.thread_id = arena->thread_id;
+		arena_stats.reserved = arena->reserved.get();
+		arena_stats.high_water_mark = arena->high_water_mark.get();
+		stats.push_back(arena_stats);
+	}
+	return stats;
+}
+
+FrameArena::FrameArena(const char *p_name) :
+		name(p_name) {
+	thread_id = Thread::get_caller_id();
+
+	MutexLock lock(arenas_mutex);
+	next_arena = arenas_first;
+	if (arenas_first) {
+		arenas_first->prev_arena = this;
+	}
+	arenas_first = this;
+}
+
+FrameArena::~FrameArena() {
+	{
+		MutexLock lock(arenas_mutex);
+		if (prev_arena) {
+			prev_arena->next_arena = next_arena;
+		} else {
+			arenas_first = next_arena;
+		}
+		if (next_arena) {
+			next_arena->prev_arena = prev_arena;
+		}
+	}
+
+	_free_chunks();
+	total_high_water_mark.sub(high_water_mark.get());
+}
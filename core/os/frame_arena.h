@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Bump-pointer allocator for short-lived, per-frame temporaries.
+// - Allocating is just moving a pointer forward; memory is given back in bulk
+//   by rewinding to a marker, usually with a FrameArenaScope.
+// - Memory comes in chunks that are kept around, so once an arena has grown to
+//   the peak a subsystem needs, it stops touching the global heap.
+// - An arena is not thread-safe. Each thread has its own one, returned by
+//   get_thread_arena(), which is what the allocator adapters below use.
+class FrameArena {
+	struct Chunk {
+		Chunk *next = nullptr;
+		uint64_t size = 0; // Usable bytes, after the header.
+		uint64_t used = 0;
+	};
+
+	static constexpr uint64_t CHUNK_HEADER_SIZE = Memory::get_aligned_address(sizeof(Chunk), Memory::MAX_ALIGN);
+	// Each allocation is prefixed with its size, so it can be reallocated without
+	// the caller knowing it (as LocalVector requires).
+	static constexpr uint64_t ALLOC_HEADER_SIZE = Memory::get_aligned_address(sizeof(uint64_t), Memory::MAX_ALIGN);
+	static constexpr uint64_t MIN_CHUNK_SIZE = 64 * 1024;
+
+	const char *name = nullptr;
+	uint64_t thread_id = 0;
+	Chunk *first = nullptr;
+	Chunk *current = nullptr;
+	uint64_t used = 0;
+
+	// Read from other threads for stats, hence atomic; they only change when the arena grows.
+	SafeNumeric<uint64_t> reserved;
+	SafeNumeric<uint64_t> high_water_mark;
+
+	FrameArena *prev_arena = nullptr;
+	FrameArena *next_arena = nullptr;
+
+	static SafeNumeric<uint64_t> total_reserved;
+	static SafeNumeric<uint64_t> total_high_water_mark;
+
+	_FORCE_INLINE_ static uint8_t *_chunk_data(Chunk *p_chunk) { return (uint8_t *)p_chunk + CHUNK_HEADER_SIZE; }
+	_FORCE_INLINE_ static uint64_t _alloc_size(uint64_t p_bytes) { return ALLOC_HEADER_SIZE + Memory::get_aligned_address(p_bytes, Memory::MAX_ALIGN); }
+
+	Chunk *_alloc_chunk(uint64_t p_size);
+	void _free_chunks();
+	void _grow(uint64_t p_size);
+	void _update_high_water_mark();
+
+	// Whether p_ptr is the most recent allocation, which can be resized or popped in place.
+	_FORCE_INLINE_ bool _is_last(const uint8_t *p_ptr, uint64_t p_bytes) const {
+		return current && p_ptr - ALLOC_HEADER_SIZE + _alloc_size(p_bytes) == _chunk_data(current) + current->used;
+	}
+
+public:
+	struct Marker {
+		Chunk *chunk = nullptr;
+		uint64_t chunk_used = 0;
+		uint64_t used = 0;
+	};
+
+	struct Stats {
+		const char *name = nullptr;
+		uint64_t thread_id = 0; // Of the thread that created the arena.
+		uint64_t reserved = 0;
+		uint64_t high_water_mark = 0;
+	};
+
+	_FORCE_INLINE_ void *alloc(size_t p_bytes) {
+		const uint64_t size = _alloc_size(p_bytes);
+		if (unlikely(!current || current->used + size > current->size)) {
+			_grow(size);
+		}
+		uint8_t *mem = _chunk_data(current) + current->used;
+		current->used += size;
+		used += size;
+		if (unlikely(used > high_water_mark.get())) {
+			_update_high_water_mark();
+		}
+		*(uint64_t *)mem = p_bytes;
+		return mem + ALLOC_HEADER_SIZE;
+	}
+
+	void *realloc(void *p_ptr, size_t p_bytes);
+
+	// Memory is only given back when freeing the most recent allocation; otherwise it's reclaimed on rewind.
+	_FORCE_INLINE_ void free(void *p_ptr) {
+		if (!p_ptr) {
+			return;
+		}
+		const uint8_t *mem = (const uint8_t *)p_ptr;
+		const uint64_t bytes = *(const uint64_t *)(mem - ALLOC_HEADER_SIZE);
+		if (_is_last(mem, bytes)) {
+			current->used -= _alloc_size(bytes);
+			used -= _alloc_size(bytes);
+		}
+	}
+
+	_FORCE_INLINE_ Marker get_marker() const {
+		Marker marker;
+		marker.chunk = current;
+		marker.chunk_used = current ? current->used : 0;
+		marker.used = used;
+		return marker;
+	}
+
+	// Frees everything allocated after the marker was taken.
+	// When the arena ends up empty and has grown into several chunks, they're merged into one.
+	void rewind(const Marker &p_marker);
+	void reset() { rewind(Marker()); }
+
+	_FORCE_INLINE_ uint64_t get_used() const { return used; }
+	_FORCE_INLINE_ uint64_t get_reserved() const { return reserved.get(); }
+	_FORCE_INLINE_ uint64_t get_high_water_mark() const { return high_water_mark.get(); }
+
+	// The arena of the calling thread, created on first use.
+	static FrameArena *get_thread_arena();
+
+	static uint64_t get_total_reserved() { return total_reserved.get(); }
+	// Sum of the high-water marks of all live arenas.
+	static uint64_t get_total_high_water_mark() { return total_high_water_mark.get(); }
+	static LocalVector<Stats> get_arena_stats();
+
+	FrameArena(const char *p_name);
+	~FrameArena();
+
+	FrameArena(const FrameArena &) = delete;
+	FrameArena &operator=(const FrameArena &) = delete;
+};
+
+// Rewinds the arena to where it was when the scope was entered.
+class FrameArenaScope {
+	FrameArena *arena = nullptr;
+	FrameArena::Marker marker;
+
+public:
+	_FORCE_INLINE_ FrameArena *get_arena() const { return arena; }
+
+	_FORCE_INLINE_ explicit FrameArenaScope(FrameArena *p_arena = FrameArena::get_thread_arena()) :
+			arena(p_arena), marker(p_arena->get_marker()) {}
+	_FORCE_INLINE_ ~FrameArenaScope() { arena->rewind(marker); }
+
+	FrameArenaScope(const FrameArenaScope &) = delete;
+	FrameArenaScope &operator=(const FrameArenaScope &) = delete;
+};
+
+// Allocator adapters, using the arena of the calling thread.
+// Containers using them must not outlive the FrameArenaScope they were created in,
+// and must not grow while a nested scope is active (the nested scope would reclaim
+// the new storage on exit).
+
+class FrameArenaAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_bytes) { return FrameArena::get_thread_arena()->alloc(p_bytes); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_bytes) { return FrameArena::get_thread_arena()->realloc(p_ptr, p_bytes); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { FrameArena::get_thread_arena()->free(p_ptr); }
+};
+
+// For HashMap elements, e.g. `HashMap<K, V, HashMapHasherDefault, HashMapComparatorDefault<K>, FrameArenaTypedAllocator<HashMapElement<K, V>>>`.
+// Note that the hash table itself is still allocated from the heap.
+template <typename T>
+class FrameArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArenaAllocator::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		p_allocation->~T();
+		FrameArenaAllocator::free(p_allocation);
+	}
+};
+
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArenaAllocator>;
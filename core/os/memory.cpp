@@ -30,13 +30,27 @@
 
 #include "memory.h"
 
+#include "core/os/spin_lock.h"
 #include "core/profiling/profiling.h"
 #include "core/templates/safe_refcount.h"
 
 #include <cstdlib>
 
+#ifdef DEBUG_ENABLED
+#if defined(_MSC_VER)
+extern "C" __declspec(dllimport) unsigned short __stdcall RtlCaptureStackBackTrace(unsigned long p_frames_to_skip, unsigned long p_frames_to_capture, void **r_back_trace, unsigned long *r_back_trace_hash);
+#define HAS_CALL_STACK_CAPTURE
+#elif (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#include <unwind.h>
+#define HAS_CALL_STACK_CAPTURE
+#endif
+#endif
+
+template <bool p_ensure_zero>
+static _FORCE_INLINE_ void *_alloc_static(size_t p_bytes, bool p_pad_align);
+
 void *operator new(size_t p_size, const char *p_description) {
-	return Memory::alloc_static(p_size, false);
+	return _alloc_static<false>(p_size, false);
 }
 
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)) {
@@ -60,6 +74,119 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
+
+// The tag is stored in the top bits of the allocation size, in the header.
+static constexpr int TAG_SHIFT = 56;
+static constexpr uint64_t SIZE_MASK = (uint64_t(1) << TAG_SHIFT) - 1;
+
+struct TagCounters {
+	SafeNumeric<uint64_t> bytes;
+	SafeNumeric<uint64_t> max_bytes;
+	SafeNumeric<uint64_t> allocations;
+	SafeNumeric<uint64_t> total_allocations;
+};
+
+static TagCounters _tag_counters[Memory::TAG_MAX];
+static thread_local Memory::Tag _thread_tag = Memory::TAG_UNTAGGED;
+
+static std::atomic<uint32_t> _sample_interval = 0;
+static thread_local uint32_t _sample_countdown = 0;
+static constexpr uint32_t SAMPLE_TABLE_SIZE = 1024; // Power of two.
+static SpinLock _samples_lock;
+static Memory::AllocationSample _samples[SAMPLE_TABLE_SIZE];
+
+static constexpr int CALL_STACK_DEPTH = Memory::AllocationSample::CALL_STACK_DEPTH;
+// Frames belonging to the allocator itself: _capture_call_stack(), _sample_alloc(), and the entry point
+// (alloc_static(), realloc_static() or operator new), which all inline _alloc_static() so they're one frame deep.
+static constexpr int ALLOCATOR_FRAMES = 3;
+
+#if defined(HAS_CALL_STACK_CAPTURE) && !defined(_MSC_VER)
+struct CallStackCapture {
+	const void **frames = nullptr;
+	int skip = 0;
+	int count = 0;
+};
+
+static _Unwind_Reason_Code _unwind_frame(_Unwind_Context *p_context, void *p_capture) {
+	CallStackCapture *capture = (CallStackCapture *)p_capture;
+	const uintptr_t ip = _Unwind_GetIP(p_context);
+	if (ip == 0) {
+		return _URC_END_OF_STACK;
+	}
+	if (capture->skip > 0) {
+		capture->skip--;
+		return _URC_NO_REASON;
+	}
+	capture->frames[capture->count++] = (const void *)ip;
+	return capture->count == CALL_STACK_DEPTH ? _URC_END_OF_STACK : _URC_NO_REASON;
+}
+#endif
+
+// Only a single return address would attribute everything to the containers and allocator wrappers
+// (CowData, LocalVector, memnew_arr...), so a few frames are kept to tell their callers apart.
+// Neither unwinder allocates through Memory, so this can't recurse.
+static _NO_INLINE_ void _capture_call_stack(const void **r_frames) {
+#if defined(HAS_CALL_STACK_CAPTURE) && defined(_MSC_VER)
+	RtlCaptureStackBackTrace(ALLOCATOR_FRAMES, CALL_STACK_DEPTH, (void **)r_frames, nullptr);
+#elif defined(HAS_CALL_STACK_CAPTURE)
+	CallStackCapture capture;
+	capture.frames = r_frames;
+	capture.skip = ALLOCATOR_FRAMES;
+	_Unwind_Backtrace(_unwind_frame, &capture);
+#endif
+}
+
+static _FORCE_INLINE_ void _track_alloc(Memory::Tag p_tag, uint64_t p_bytes) {
+	uint64_t new_mem_usage = _current_mem_usage.add(p_bytes);
+	_max_mem_usage.exchange_if_greater(new_mem_usage);
+
+	TagCounters &counters = _tag_counters[p_tag];
+	counters.max_bytes.exchange_if_greater(counters.bytes.add(p_bytes));
+	counters.allocations.increment();
+	counters.total_allocations.increment();
+}
+
+static _FORCE_INLINE_ void _track_free(Memory::Tag p_tag, uint64_t p_bytes) {
+	_current_mem_usage.sub(p_bytes);
+
+	TagCounters &counters = _tag_counters[p_tag];
+	counters.bytes.sub(p_bytes);
+	counters.allocations.decrement();
+}
+
+static _NO_INLINE_ void _sample_alloc(Memory::Tag p_tag, uint64_t p_bytes) {
+	uint32_t interval = _sample_interval.load(std::memory_order_relaxed);
+	if (_sample_countdown == 0 || _sample_countdown > interval) {
+		_sample_countdown = interval;
+	}
+	if (--_sample_countdown != 0) {
+		return;
+	}
+
+	const void *call_stack[CALL_STACK_DEPTH] = {};
+	_capture_call_stack(call_stack);
+
+	uint32_t hash = p_tag;
+	for (int i = 0; i < CALL_STACK_DEPTH; i++) {
+		hash = (hash ^ (uint32_t)((uintptr_t)call_stack[i] >> 2)) * 2654435761u;
+	}
+
+	// Open addressing on the call stack; samples are dropped if the table is full.
+	uint32_t idx = hash & (SAMPLE_TABLE_SIZE - 1);
+	_samples_lock.lock();
+	for (uint32_t i = 0; i < SAMPLE_TABLE_SIZE; i++) {
+		Memory::AllocationSample &sample = _samples[idx];
+		if (sample.count == 0 || (sample.tag == p_tag && memcmp(sample.call_stack, call_stack, sizeof(call_stack)) == 0)) {
+			memcpy(sample.call_stack, call_stack, sizeof(call_stack));
+			sample.tag = p_tag;
+			sample.count++;
+			sample.bytes += p_bytes;
+			break;
+		}
+		idx = (idx + 1) & (SAMPLE_TABLE_SIZE - 1);
+	}
+	_samples_lock.unlock();
+}
 #endif
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
@@ -96,8 +223,9 @@ void Memory::free_aligned_static(void *p_memory) {
 	free(p);
 }
 
+// Inlined in every entry point, so that sampled call stacks always start at the same depth.
 template <bool p_ensure_zero>
-void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+static _FORCE_INLINE_ void *_alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
 #else
@@ -106,36 +234,46 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
 	void *mem;
 	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
+		mem = calloc(1, p_bytes + (prepad ? Memory::DATA_OFFSET : 0));
 	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+		mem = malloc(p_bytes + (prepad ? Memory::DATA_OFFSET : 0));
 	}
 
 	ERR_FAIL_NULL_V(mem, nullptr);
-	GodotProfileAlloc(mem, p_bytes + (prepad ? DATA_OFFSET : 0));
+	GodotProfileAlloc(mem, p_bytes + (prepad ? Memory::DATA_OFFSET : 0));
 
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
 
-		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
-		*s = p_bytes;
+		uint64_t *s = (uint64_t *)(s8 + Memory::SIZE_OFFSET);
 
 #ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = _current_mem_usage.add(p_bytes);
-		_max_mem_usage.exchange_if_greater(new_mem_usage);
+		const Memory::Tag tag = _thread_tag;
+		*s = p_bytes | ((uint64_t)tag << TAG_SHIFT);
+		_track_alloc(tag, p_bytes);
+		if (unlikely(_sample_interval.load(std::memory_order_relaxed) != 0)) {
+			_sample_alloc(tag, p_bytes);
+		}
+#else
+		*s = p_bytes;
 #endif
-		return s8 + DATA_OFFSET;
+		return s8 + Memory::DATA_OFFSET;
 	} else {
 		return mem;
 	}
 }
 
+template <bool p_ensure_zero>
+void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+	return _alloc_static<p_ensure_zero>(p_bytes, p_pad_align);
+}
+
 template void *Memory::alloc_static<true>(size_t p_bytes, bool p_pad_align);
 template void *Memory::alloc_static<false>(size_t p_bytes, bool p_pad_align);
 
 void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (p_memory == nullptr) {
-		return alloc_static(p_bytes, p_pad_align);
+		return _alloc_static<false>(p_bytes, p_pad_align);
 	}
 
 	uint8_t *mem = (uint8_t *)p_memory;
@@ -151,12 +289,23 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - *s);
+		// Reallocations keep the tag of the original allocation.
+		const Memory::Tag tag = Memory::Tag(*s >> TAG_SHIFT);
+		const uint64_t prev_bytes = *s & SIZE_MASK;
+		const uint64_t header = p_bytes | ((uint64_t)tag << TAG_SHIFT);
+		if (p_bytes == 0) {
+			_track_free(tag, prev_bytes);
+		} else if (p_bytes > prev_bytes) {
+			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - prev_bytes);
 			_max_mem_usage.exchange_if_greater(new_mem_usage);
+			TagCounters &counters = _tag_counters[tag];
+			counters.max_bytes.exchange_if_greater(counters.bytes.add(p_bytes - prev_bytes));
 		} else {
-			_current_mem_usage.sub(*s - p_bytes);
+			_current_mem_usage.sub(prev_bytes - p_bytes);
+			_tag_counters[tag].bytes.sub(prev_bytes - p_bytes);
 		}
+#else
+		const uint64_t header = p_bytes;
 #endif
 
 		if (p_bytes == 0) {
@@ -164,7 +313,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			free(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
+			*s = header;
 
 			GodotProfileFree(mem);
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
@@ -173,7 +322,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
 
-			*s = p_bytes;
+			*s = header;
 
 			return mem + DATA_OFFSET;
 		}
@@ -204,7 +353,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		_current_mem_usage.sub(*s);
+		_track_free(Memory::Tag(*s >> TAG_SHIFT), *s & SIZE_MASK);
 #endif
 
 		GodotProfileFree(mem);
@@ -235,6 +384,89 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+Memory::Tag Memory::set_thread_tag(Tag p_tag) {
+#ifdef DEBUG_ENABLED
+	Tag previous = _thread_tag;
+	_thread_tag = p_tag;
+	return previous;
+#else
+	return TAG_UNTAGGED;
+#endif
+}
+
+Memory::Tag Memory::get_thread_tag() {
+#ifdef DEBUG_ENABLED
+	return _thread_tag;
+#else
+	return TAG_UNTAGGED;
+#endif
+}
+
+const char *Memory::get_tag_name(Tag p_tag) {
+	static const char *names[TAG_MAX] = {
+		"untagged",
+		"rendering",
+		"physics",
+		"scripting",
+		"resources",
+		"audio",
+		"navigation",
+	};
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	return names[p_tag];
+}
+
+Memory::TagUsage Memory::get_tag_usage(Tag p_tag) {
+	TagUsage usage;
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, usage);
+	const TagCounters &counters = _tag_counters[p_tag];
+	usage.bytes = counters.bytes.get();
+	usage.max_bytes = counters.max_bytes.get();
+	usage.allocations = counters.allocations.get();
+	usage.total_allocations = counters.total_allocations.get();
+#endif
+	return usage;
+}
+
+void Memory::set_allocation_sample_interval(uint32_t p_interval) {
+#ifdef DEBUG_ENABLED
+	_sample_interval.store(p_interval, std::memory_order_relaxed);
+#endif
+}
+
+uint32_t Memory::get_allocation_sample_interval() {
+#ifdef DEBUG_ENABLED
+	return _sample_interval.load(std::memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+uint32_t Memory::get_allocation_samples(AllocationSample *r_samples, uint32_t p_max) {
+	uint32_t written = 0;
+#ifdef DEBUG_ENABLED
+	_samples_lock.lock();
+	for (uint32_t i = 0; i < SAMPLE_TABLE_SIZE && written < p_max; i++) {
+		if (_samples[i].count > 0) {
+			r_samples[written++] = _samples[i];
+		}
+	}
+	_samples_lock.unlock();
+#endif
+	return written;
+}
+
+void Memory::clear_allocation_samples() {
+#ifdef DEBUG_ENABLED
+	_samples_lock.lock();
+	for (uint32_t i = 0; i < SAMPLE_TABLE_SIZE; i++) {
+		_samples[i] = AllocationSample();
+	}
+	_samples_lock.unlock();
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -96,14 +96,77 @@ void free_aligned_static(void *p_memory);
 uint64_t get_mem_available();
 uint64_t get_mem_usage();
 uint64_t get_mem_max_usage();
+
+// Per-subsystem accounting, only available with DEBUG_ENABLED.
+// Allocations are tagged with the innermost MemoryTagScope of the calling thread,
+// and count towards that tag until they're freed, whichever thread frees them.
+enum Tag : uint8_t {
+	TAG_UNTAGGED,
+	TAG_RENDERING,
+	TAG_PHYSICS,
+	TAG_SCRIPTING,
+	TAG_RESOURCES,
+	TAG_AUDIO,
+	TAG_NAVIGATION,
+	TAG_MAX,
+};
+
+struct TagUsage {
+	uint64_t bytes = 0;
+	uint64_t max_bytes = 0;
+	uint64_t allocations = 0; // Currently alive.
+	uint64_t total_allocations = 0; // Since startup.
+};
+
+struct AllocationSample {
+	static constexpr int CALL_STACK_DEPTH = 8;
+
+	// Return addresses, starting at the caller of the allocator. Unused frames are null.
+	const void *call_stack[CALL_STACK_DEPTH] = {};
+	Tag tag = TAG_UNTAGGED;
+	uint64_t count = 0;
+	uint64_t bytes = 0;
+};
+
+Tag set_thread_tag(Tag p_tag); // Returns the previous tag.
+Tag get_thread_tag();
+const char *get_tag_name(Tag p_tag);
+TagUsage get_tag_usage(Tag p_tag);
+
+// Records the call stack of one in every p_interval allocations of each thread.
+// 0 (the default) disables sampling. Call stacks are return addresses, to be symbolized externally.
+void set_allocation_sample_interval(uint32_t p_interval);
+uint32_t get_allocation_sample_interval();
+// Writes up to p_max samples, aggregated by call stack, and returns how many were written.
+uint32_t get_allocation_samples(AllocationSample *r_samples, uint32_t p_max);
+void clear_allocation_samples();
 }; //namespace Memory
 
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return Memory::realloc_static(p_ptr, p_memory, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
+// Tags the allocations made by the current thread while in scope (see Memory::Tag).
+// Scopes nest, so the innermost one wins.
+class MemoryTagScope {
+#ifdef DEBUG_ENABLED
+	Memory::Tag previous;
+
+public:
+	_FORCE_INLINE_ explicit MemoryTagScope(Memory::Tag p_tag) { previous = Memory::set_thread_tag(p_tag); }
+	_FORCE_INLINE_ ~MemoryTagScope() { Memory::set_thread_tag(previous); }
+#else
+public:
+	_FORCE_INLINE_ explicit MemoryTagScope(Memory::Tag p_tag) {}
+#endif
+
+	MemoryTagScope(const MemoryTagScope &) = delete;
+	MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+};
+
 // Works around an issue where memnew_placement (char *) would call the p_description version.
 inline void *operator new(size_t p_size, char *p_dest) {
 	return operator new(p_size, (void *)p_dest);
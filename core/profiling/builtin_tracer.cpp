@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  builtin_tracer.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "builtin_tracer.h"
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/templates/local_vector.h"
+
+static_assert((BuiltinTracer::EVENTS_PER_THREAD & (BuiltinTracer::EVENTS_PER_THREAD - 1)) == 0, "EVENTS_PER_THREAD must be a power of two.");
+
+namespace {
+
+const uint32_t THREAD_NAME_SIZE = 64;
+
+struct ThreadBuffer {
+	BuiltinTracer::Event events[BuiltinTracer::EVENTS_PER_THREAD];
+	// Total number of events recorded; the ring index is this modulo the capacity.
+	// Only written by the owning thread, after the event itself.
+	SafeNumeric<uint64_t> written;
+	SafeNumeric<uint64_t> cleared; // Events before this one were cleared.
+	uint64_t thread_id = 0;
+	char thread_name[THREAD_NAME_SIZE] = {};
+	ThreadBuffer *next = nullptr;
+};
+
+BinaryMutex buffers_mutex;
+ThreadBuffer *buffers = nullptr; // Kept after their thread exits, so their zones can still be exported.
+
+thread_local ThreadBuffer *thread_buffer = nullptr;
+thread_local char thread_name[THREAD_NAME_SIZE] = {};
+
+ThreadBuffer *create_thread_buffer() {
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->thread_id = Thread::get_caller_id();
+	memcpy(buffer->thread_name, thread_name, THREAD_NAME_SIZE);
+
+	MutexLock lock(buffers_mutex);
+	buffer->next = buffers;
+	buffers = buffer;
+	return buffer;
+}
+
+} // namespace
+
+SafeFlag BuiltinTracer::enabled;
+
+void BuiltinTracer::_record(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec) {
+	if (unlikely(!thread_buffer)) {
+		thread_buffer = create_thread_buffer();
+	}
+	const uint64_t index = thread_buffer->written.get();
+	Event &event = thread_buffer->events[index & (EVENTS_PER_THREAD - 1)];
+	event.name = p_name;
+	event.begin_usec = p_begin_usec;
+	event.end_usec = p_end_usec;
+	thread_buffer->written.set(index + 1);
+}
+
+void BuiltinTracer::set_enabled(bool p_enabled) {
+	enabled.set_to(p_enabled);
+}
+
+void BuiltinTracer::clear() {
+	// The owning threads may still be recording, so only move the start of the buffers forward.
+	MutexLock lock(buffers_mutex);
+	for (ThreadBuffer *buffer = buffers; buffer; buffer = buffer->next) {
+		buffer->cleared.set(buffer->written.get());
+	}
+}
+
+uint64_t BuiltinTracer::get_ticks_usec() {
+	const OS *os = OS::get_singleton();
+	return likely(os) ? os->get_ticks_usec() : 0;
+}
+
+void BuiltinTracer::set_thread_name(const String &p_name) {
+	const CharString name = p_name.utf8();
+	const uint32_t length = MIN((uint32_t)name.length(), THREAD_NAME_SIZE - 1);
+	memcpy(thread_name, name.get_data(), length);
+	thread_name[length] = '\0';
+	if (thread_buffer) {
+		memcpy(thread_buffer->thread_name, thread_name, THREAD_NAME_SIZE);
+	}
+}
+
+String BuiltinTracer::get_chrome_trace() {
+	StringBuilder json;
+	json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+
+	MutexLock lock(buffers_mutex);
+	LocalVector<Event> events;
+	for (ThreadBuffer *buffer = buffers; buffer; buffer = buffer->next) {
+		const String tid = itos(buffer->thread_id);
+
+		// Copy the ring before formatting it, as the owning thread may be wrapping around meanwhile.
+		const uint64_t written = buffer->written.get();
+		const uint64_t begin = MAX(written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0, buffer->cleared.get());
+		events.resize(written - begin);
+		for (uint64_t i = begin; i < written; i++) {
+			events[i - begin] = buffer->events[i & (EVENTS_PER_THREAD - 1)];
+		}
+		// Drop the events that may have been overwritten while copying, including the one being written now.
+		const uint64_t written_after = buffer->written.get();
+		const uint64_t valid_begin = written_after >= EVENTS_PER_THREAD ? written_after - EVENTS_PER_THREAD + 1 : 0;
+
+		String thread_name = buffer->thread_name[0] ? String::utf8(buffer->thread_name) : (buffer->thread_id == Thread::get_main_id() ? String("Main Thread") : "Thread " + tid);
+		json.append(first ? "" : ",\n");
+		json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"" + thread_name.json_escape() + "\"}}");
+		first = false;
+
+		for (uint64_t i = MAX(begin, valid_begin); i < written; i++) {
+			const Event &event = events[i - begin];
+			if (event.name) {
+				json.append(",\n{\"name\":\"" + String::utf8(event.name).json_escape() + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":" + itos(event.begin_usec) + ",\"dur\":" + itos(event.end_usec - event.begin_usec) + "}");
+			} else {
+				json.append(",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" + tid + ",\"ts\":" + itos(event.begin_usec) + "}");
+			}
+		}
+	}
+
+	json.append("\n]}\n");
+	return json.as_string();
+}
+
+Error BuiltinTracer::save_chrome_trace(const String &p_path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't open trace file for writing: \"%s\".", p_path));
+	file->store_string(get_chrome_trace());
+	return OK;
+}
+
+void BuiltinTracer::finish() {
+	enabled.clear();
+	MutexLock lock(buffers_mutex);
+	while (buffers) {
+		ThreadBuffer *buffer = buffers;
+		buffers = buffer->next;
+		memdelete(buffer);
+	}
+	thread_buffer = nullptr; // Only the calling thread's; others must not record anymore.
+}
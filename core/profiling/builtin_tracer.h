@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  builtin_tracer.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_list.h"
+#include "core/templates/safe_refcount.h"
+#include "core/typedefs.h"
+
+class String;
+
+// Always-available tracer backing the profiling macros when no external profiler is used.
+// - Zones are recorded as they end, into a ring buffer owned by the calling thread, so
+//   recording takes no locks; once a buffer is full, the oldest zones are overwritten.
+// - While disabled (the default), a zone costs a single flag check.
+// - The recorded zones can be exported in the Chrome trace event format, which can be
+//   opened in Perfetto UI or chrome://tracing.
+class BuiltinTracer {
+public:
+	static constexpr uint32_t EVENTS_PER_THREAD = 16384; // Must be a power of two.
+
+	struct Event {
+		const char *name = nullptr; // Zone names must be string literals, or outlive the tracer.
+		uint64_t begin_usec = 0;
+		uint64_t end_usec = 0; // Same as the beginning for frame marks.
+	};
+
+private:
+	static SafeFlag enabled;
+
+	static void _record(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec);
+
+public:
+	_FORCE_INLINE_ static bool is_enabled() { return enabled.is_set(); }
+	static void set_enabled(bool p_enabled);
+	// Forgets everything recorded so far.
+	static void clear();
+
+	static uint64_t get_ticks_usec();
+	_FORCE_INLINE_ static void record_zone(const char *p_name, uint64_t p_begin_usec) { _record(p_name, p_begin_usec, get_ticks_usec()); }
+	_FORCE_INLINE_ static void frame_mark() {
+		if (unlikely(is_enabled())) {
+			const uint64_t now = get_ticks_usec();
+			_record(nullptr, now, now);
+		}
+	}
+
+	// Names the calling thread in exported traces. Can be called before tracing is enabled.
+	static void set_thread_name(const String &p_name);
+
+	static String get_chrome_trace();
+	static Error save_chrome_trace(const String &p_path);
+
+	// Frees the buffers of all threads. Nothing may be recorded concurrently.
+	static void finish();
+
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ void end() {
+			if (unlikely(name)) {
+				record_zone(name, begin_usec);
+				name = nullptr;
+			}
+		}
+
+		_FORCE_INLINE_ void next(const char *p_name) {
+			end();
+			if (unlikely(is_enabled())) {
+				name = p_name;
+				begin_usec = get_ticks_usec();
+			}
+		}
+
+		_FORCE_INLINE_ explicit Zone(const char *p_name) { next(p_name); }
+		_FORCE_INLINE_ ~Zone() { end(); }
+
+		Zone(const Zone &) = delete;
+		Zone &operator=(const Zone &) = delete;
+	};
+};
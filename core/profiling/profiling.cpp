@@ -247,6 +247,6 @@ void godot_init_profiler() {
 }
 
 void godot_cleanup_profiler() {
-	// Stub
+	BuiltinTracer::finish();
 }
 #endif
@@ -33,7 +33,7 @@
 #include "profiling.gen.h"
 
 // This header provides profiling primitives (implemented as macros) for various backends.
-// See the "No profiling" branch at the bottom for a short description of the functions.
+// See the built-in tracer branch at the bottom for a short description of the functions.
 
 // To configure / use the profiler, use the --profiler_path and other --profiler_* arguments
 // when compiling Godot. You can also find details in the SCSub file (in this folder).
@@ -102,7 +102,7 @@ struct PerfettoGroupedEventEnder {
 	}
 };
 
-#define GodotProfileFrameMark // TODO
+#define GodotProfileFrameMark TRACE_EVENT_INSTANT("godot", "Frame")
 #define GodotProfileZone(m_zone_name) TRACE_EVENT("godot", m_zone_name);
 #define GodotProfileZoneGroupedFirst(m_group_name, m_zone_name) \
 	TRACE_EVENT_BEGIN("godot", m_zone_name);                    \
@@ -179,23 +179,28 @@ void godot_init_profiler();
 void godot_cleanup_profiler();
 
 #else
-// No profiling; all macros are stubs.
+// No external profiler; zones go to the built-in tracer, which does nothing until enabled
+// (e.g. with the --trace-file command line argument). See builtin_tracer.h.
+
+#define GODOT_USE_BUILTIN_TRACER
+
+#include "core/profiling/builtin_tracer.h"
 
 void godot_init_profiler();
 void godot_cleanup_profiler();
 
 // Tell the profiling backend that a new frame has started.
-#define GodotProfileFrameMark
+#define GodotProfileFrameMark BuiltinTracer::frame_mark()
 // Defines a profile zone from here to the end of the scope.
-#define GodotProfileZone(m_zone_name)
+#define GodotProfileZone(m_zone_name) BuiltinTracer::Zone GD_UNIQUE_NAME(__godot_builtin_zone_)(m_zone_name)
 // Defines a profile zone group. The first profile zone starts immediately,
 // and ends either when the next zone starts, or when the scope ends.
-#define GodotProfileZoneGroupedFirst(m_group_name, m_zone_name)
+#define GodotProfileZoneGroupedFirst(m_group_name, m_zone_name) BuiltinTracer::Zone __godot_builtin_zone_##m_group_name(m_zone_name)
 // End the profile zone group's current profile zone now.
-#define GodotProfileZoneGroupedEndEarly(m_group_name, m_zone_name)
+#define GodotProfileZoneGroupedEndEarly(m_group_name, m_zone_name) __godot_builtin_zone_##m_group_name.end()
 // Replace the profile zone group's current profile zone.
 // The new zone ends either when the next zone starts, or when the scope ends.
-#define GodotProfileZoneGrouped(m_group_name, m_zone_name)
+#define GodotProfileZoneGrouped(m_group_name, m_zone_name) __godot_builtin_zone_##m_group_name.next(m_zone_name)
 // Tell the profiling backend that an allocation happened, with its location and size.
 #define GodotProfileAlloc(m_ptr, m_size)
 // Tell the profiling backend that an allocation was freed.
@@ -203,6 +208,7 @@ void godot_cleanup_profiler();
 #define GodotProfileFree(m_ptr)
 
 // Define a zone with custom source information (for scripting)
+// Not recorded by the built-in tracer, which needs names that outlive it.
 // m_varname is equivalent to GodotProfileZoneGrouped varnames.
 // m_ptr is a pointer to the function instance, which will be used for the lookup.
 // m_file, m_function are StringNames, m_line is a uint32_t, all used for the source location.
@@ -32,6 +32,7 @@
 
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 
 struct StringName::Table {
@@ -39,30 +40,168 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	// Buckets are split across shards, each with its own mutex, so inserting and
+	// removing names only contends with threads touching the same shard.
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_LEN = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_MASK = SHARD_LEN - 1;
+
+	// Removed entries waiting in a shard before waiting for the lookups in progress to free them.
+	constexpr static uint32_t GRAVEYARD_MAX = 64;
+
+	struct Shard {
+		BinaryMutex mutex;
+		// Lock-free lookups in progress, counted in the slot of the epoch they started in.
+		// Removed entries are only freed once the lookups that may still be walking through them are done.
+		std::atomic<uint32_t> epoch;
+		std::atomic<uint32_t> readers[2];
+		_Data *graveyard; // Linked through prev, which is unused once unlinked.
+		uint32_t graveyard_size;
+
+		Shard() :
+				epoch(0), graveyard(nullptr), graveyard_size(0) {
+			readers[0].store(0);
+			readers[1].store(0);
+		}
+	};
+
+	static inline std::atomic<_Data *> table[TABLE_LEN];
+	static inline Shard shards[SHARD_LEN];
+	static inline PagedAllocator<_Data, true> allocator;
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_idx) {
+		return shards[p_idx & SHARD_MASK];
+	}
+
+	// Finds an existing entry and references it, without locking. Returns null if the name
+	// isn't interned, or its entry is about to be removed; the caller must then lock and recheck.
+	template <typename T>
+	static _Data *find_and_ref(const T &p_name, uint32_t p_hash, uint32_t p_idx) {
+		Shard &shard = get_shard(p_idx);
+		const uint32_t epoch = begin_lookup(shard);
+
+		_Data *data = table[p_idx].load();
+		while (data) {
+			if (data->hash == p_hash && data->name == p_name && data->refcount.ref()) {
+				break;
+			}
+			data = data->next.load();
+		}
+
+		shard.readers[epoch].fetch_sub(1);
+		return data;
+	}
+
+	// Counts a lock-free lookup in the current epoch, and returns the slot to release it from.
+	static uint32_t begin_lookup(Shard &p_shard) {
+		while (true) {
+			const uint32_t epoch = p_shard.epoch.load();
+			p_shard.readers[epoch].fetch_add(1);
+			// If the epoch changed meanwhile, a writer may already be done waiting for this slot.
+			if (likely(p_shard.epoch.load() == epoch)) {
+				return epoch;
+			}
+			p_shard.readers[epoch].fetch_sub(1);
+		}
+	}
+
+	// Must be called with the shard mutex held. Returns once the lookups that started before are done.
+	// Those starting meanwhile are counted in the other slot, so this doesn't wait for more than one lookup per thread.
+	static void wait_for_lookups(Shard &p_shard) {
+		const uint32_t epoch = p_shard.epoch.load();
+		p_shard.epoch.store(epoch ^ 1);
+		while (p_shard.readers[epoch].load() != 0) {
+#ifdef THREADS_ENABLED
+			Thread::yield();
+#endif
+		}
+	}
+
+	// Must be called with the shard mutex held.
+	template <typename T>
+	static _Data *find_locked(const T &p_name, uint32_t p_hash, uint32_t p_idx) {
+		_Data *data = table[p_idx].load();
+		while (data) {
+			// compare hash first
+			if (data->hash == p_hash && data->name == p_name) {
+				break;
+			}
+			data = data->next.load();
+		}
+		return data;
+	}
+
+	// Must be called with the shard mutex held.
+	static void insert_locked(_Data *p_data, uint32_t p_idx) {
+		_Data *head = table[p_idx].load();
+		p_data->next.store(head);
+		p_data->prev = nullptr;
+		if (head) {
+			head->prev = p_data;
+		}
+		table[p_idx].store(p_data); // Publishes the entry to lock-free readers.
+	}
+
+	// Must be called with the shard mutex held.
+	static void remove_locked(_Data *p_data, uint32_t p_idx) {
+		_Data *next = p_data->next.load();
+		if (p_data->prev) {
+			p_data->prev->next.store(next);
+		} else {
+			table[p_idx].store(next);
+		}
+		if (next) {
+			next->prev = p_data->prev;
+		}
+
+		// Keep next intact, in case a reader is currently on this entry.
+		Shard &shard = get_shard(p_idx);
+		p_data->prev = shard.graveyard;
+		shard.graveyard = p_data;
+		shard.graveyard_size++;
+
+		// Readers arriving after the unlink above can't reach any entry in the graveyard,
+		// so if there are none now it's safe to free them all.
+		if (shard.readers[0].load() == 0 && shard.readers[1].load() == 0) {
+			free_graveyard(shard);
+		} else if (shard.graveyard_size >= GRAVEYARD_MAX) {
+			// Lookups keep overlapping, so there may never be a moment without any.
+			wait_for_lookups(shard);
+			free_graveyard(shard);
+		}
+	}
+
+	static void free_graveyard(Shard &p_shard) {
+		while (p_shard.graveyard) {
+			_Data *d = p_shard.graveyard;
+			p_shard.graveyard = d->prev;
+			allocator.free(d);
+		}
+		p_shard.graveyard_size = 0;
+	}
 };
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+		Table::table[i].store(nullptr);
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (uint32_t i = 0; i < Table::SHARD_LEN; i++) {
+		Table::shards[i].mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
+			_Data *d = Table::table[i].load();
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load();
 			}
 		}
 
@@ -86,8 +225,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
+		while (Table::table[i].load()) {
+			_Data *d = Table::table[i].load();
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -96,36 +235,34 @@ void StringName::cleanup() {
 				}
 			}
 
-			Table::table[i] = Table::table[i]->next;
+			Table::table[i].store(d->next.load());
 			Table::allocator.free(d);
 		}
 	}
+	for (uint32_t i = 0; i < Table::SHARD_LEN; i++) {
+		Table::free_graveyard(Table::shards[i]);
+	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (uint32_t i = 0; i < Table::SHARD_LEN; i++) {
+		Table::shards[i].mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		const uint32_t idx = _data->hash & Table::TABLE_MASK;
+		MutexLock lock(Table::get_shard(idx).mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
 		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		Table::allocator.free(_data);
+		Table::remove_locked(_data, idx);
 	}
 
 	_data = nullptr;
@@ -210,55 +347,22 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
+	_intern(p_name, String::hash(p_name), p_static);
+}
 
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
+StringName::StringName(const String &p_name, bool p_static) {
+	_data = nullptr;
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
+	ERR_FAIL_COND(!configured);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
+	if (p_name.is_empty()) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_intern(p_name, p_name.hash(), p_static);
 }
 
-StringName::StringName(const String &p_name, bool p_static) {
+StringName::StringName(const Span<char32_t> &p_name, bool p_static) {
 	_data = nullptr;
 
 	ERR_FAIL_COND(!configured);
@@ -267,19 +371,31 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
+	_intern(p_name, String::hash(p_name.ptr(), p_name.size()), p_static);
+}
 
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
+template <typename T>
+void StringName::_intern(const T &p_name, uint32_t p_hash, bool p_static) {
+	const uint32_t idx = p_hash & Table::TABLE_MASK;
 
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
+#ifdef DEBUG_ENABLED
+	// Reference counting for debugging isn't atomic, so it needs the lock.
+	if (likely(!debug_stringname))
+#endif
+	{
+		// Most names already exist, so try without locking first.
+		_data = Table::find_and_ref(p_name, p_hash, idx);
+		if (_data) {
+			if (p_static) {
+				_data->static_count.increment();
+			}
+			return;
 		}
-		_data = _data->next;
 	}
 
+	MutexLock lock(Table::get_shard(idx).mutex);
+	_data = Table::find_locked(p_name, p_hash, idx);
+
 	if (_data && _data->refcount.ref()) {
 		// exists
 		if (p_static) {
@@ -294,12 +410,15 @@ StringName::StringName(const String &p_name, bool p_static) {
 	}
 
 	_data = Table::allocator.alloc();
-	_data->name = p_name;
+	if constexpr (std::is_same_v<T, Span<char32_t>>) {
+		_data->name = String::utf32(p_name);
+	} else {
+		_data->name = p_name;
+	}
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
+	_data->hash = p_hash;
+
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		// Keep in memory, force static.
@@ -308,10 +427,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 	}
 #endif
 
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	Table::insert_locked(_data, idx);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -49,13 +49,15 @@ class [[nodiscard]] StringName {
 #endif
 
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		_Data *prev = nullptr; // Only accessed with the shard mutex held.
+		std::atomic<_Data *> next = nullptr; // Followed by lock-free lookups.
 	};
 
 	_Data *_data = nullptr;
 
 	void unref();
+	template <typename T>
+	void _intern(const T &p_name, uint32_t p_hash, bool p_static);
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
@@ -170,6 +172,8 @@ public:
 		p_name._data = nullptr;
 	}
 	StringName(const String &p_name, bool p_static = false);
+	// Only allocates a String if the name isn't interned yet.
+	explicit StringName(const Span<char32_t> &p_name, bool p_static = false);
 	StringName() {}
 
 #ifdef SIZE_EXTRA
@@ -0,0 +1,698 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_TABLE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define FLAT_HASH_TABLE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * Open-addressing hash tables probed a group of slots at a time, after Abseil's SwissTable.
+ *
+ * Each slot has a control byte, either empty, deleted, or holding 7 bits of the hash of its key.
+ * Lookups compare a whole group of 16 control bytes at once (with SSE2 or NEON when available),
+ * so keys are only compared for the few slots whose hash bits match. Probing stops at the first
+ * group with an empty slot, which keeps failed lookups short even at high load.
+ *
+ * Elements are stored densely, in insertion order, apart from the slots, like in AHashMap:
+ * - Iterating is as fast as iterating an array.
+ * - Inserting may move elements, invalidating pointers and iterators. Use HashMap if values must
+ *   stay in place (e.g. when handing out pointers to them).
+ * - Erasing moves the last element into the gap, unless KEEP_ORDER is set, in which case the
+ *   following elements are shifted instead, keeping insertion order at an O(n) cost.
+ */
+
+namespace FlatHashTableGroup {
+
+static constexpr uint32_t WIDTH = 16;
+
+// Full slots hold the low 7 bits of the hash, so only empty and deleted slots have the sign bit set.
+static constexpr int8_t CTRL_EMPTY = -128;
+static constexpr int8_t CTRL_DELETED = -2;
+
+_FORCE_INLINE_ uint32_t count_trailing_zeros(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(p_value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanForward64(&index, p_value);
+	return index;
+#else
+	uint32_t count = 0;
+	while (!(p_value & 1)) {
+		p_value >>= 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+// Slots of a group that matched, iterated from the lowest one.
+struct Mask {
+#ifdef FLAT_HASH_TABLE_NEON
+	static constexpr uint32_t SHIFT = 2; // One bit in every nibble.
+#else
+	static constexpr uint32_t SHIFT = 0;
+#endif
+
+	uint64_t bits = 0;
+
+	_FORCE_INLINE_ explicit operator bool() const { return bits != 0; }
+	_FORCE_INLINE_ uint32_t lowest() const { return count_trailing_zeros(bits) >> SHIFT; }
+	_FORCE_INLINE_ void clear_lowest() { bits &= bits - 1; }
+};
+
+struct Group {
+#if defined(FLAT_HASH_TABLE_SSE2)
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) :
+			ctrl(_mm_loadu_si128((const __m128i *)p_ctrl)) {}
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const { return Mask{ (uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(p_h2))) }; }
+	_FORCE_INLINE_ Mask match_empty() const { return match(CTRL_EMPTY); }
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const { return Mask{ (uint64_t)_mm_movemask_epi8(ctrl) }; }
+#elif defined(FLAT_HASH_TABLE_NEON)
+	int8x16_t ctrl;
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) :
+			ctrl(vld1q_s8(p_ctrl)) {}
+
+	// NEON has no movemask, so narrow each byte of the comparison to a nibble instead.
+	static _FORCE_INLINE_ Mask _to_mask(uint8x16_t p_cmp) {
+		const uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4)), 0);
+		return Mask{ nibbles & 0x8888888888888888ull };
+	}
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const { return _to_mask(vceqq_s8(ctrl, vdupq_n_s8(p_h2))); }
+	_FORCE_INLINE_ Mask match_empty() const { return match(CTRL_EMPTY); }
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const { return _to_mask(vcltzq_s8(ctrl)); }
+#else
+	int8_t ctrl[WIDTH];
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) { memcpy(ctrl, p_ctrl, WIDTH); }
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			bits |= uint64_t(ctrl[i] == p_h2) << i;
+		}
+		return Mask{ bits };
+	}
+	_FORCE_INLINE_ Mask match_empty() const { return match(CTRL_EMPTY); }
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			bits |= uint64_t(ctrl[i] < 0) << i;
+		}
+		return Mask{ bits };
+	}
+#endif
+};
+
+} // namespace FlatHashTableGroup
+
+// Common implementation of FlatHashMap and FlatHashSet.
+template <typename TKey, typename TElement, typename Hasher, typename Comparator, bool KEEP_ORDER>
+class FlatHashTable {
+public:
+	// Must be a power of two, and at least a group.
+	static constexpr uint32_t MIN_CAPACITY = FlatHashTableGroup::WIDTH;
+
+protected:
+	typedef FlatHashTableGroup::Group Group;
+	typedef FlatHashTableGroup::Mask Mask;
+	static constexpr uint32_t GROUP_WIDTH = FlatHashTableGroup::WIDTH;
+
+	TElement *_elements = nullptr;
+	// Control bytes, followed by a copy of the first group so that groups can be loaded from any slot.
+	int8_t *_ctrl = nullptr;
+	// Index of the element in each full slot. Shares an allocation with the control bytes.
+	uint32_t *_indices = nullptr;
+
+	uint32_t _capacity_mask = MIN_CAPACITY - 1;
+	uint32_t _size = 0;
+	uint32_t _tombstones = 0;
+
+	static _FORCE_INLINE_ const TKey &_get_key(const TElement &p_element) {
+		if constexpr (std::is_same_v<TKey, TElement>) {
+			return p_element;
+		} else {
+			return p_element.key;
+		}
+	}
+
+	static _FORCE_INLINE_ uint32_t _h1(uint32_t p_hash) { return p_hash >> 7; }
+	static _FORCE_INLINE_ int8_t _h2(uint32_t p_hash) { return int8_t(p_hash & 0x7F); }
+
+	// 7/8 of the capacity, so that probing always ends on an empty slot.
+	static _FORCE_INLINE_ uint32_t _get_max_size(uint32_t p_capacity_mask) {
+		return p_capacity_mask + 1 - ((p_capacity_mask + 1) >> 3);
+	}
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_slot, int8_t p_ctrl) {
+		_ctrl[p_slot] = p_ctrl;
+		// Same slot unless it's in the first group, then its copy after the end.
+		_ctrl[((p_slot - GROUP_WIDTH) & _capacity_mask) + GROUP_WIDTH] = p_ctrl;
+	}
+
+	bool _lookup_slot(const TKey &p_key, uint32_t p_hash, uint32_t &r_slot) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+
+		const int8_t h2 = _h2(p_hash);
+		uint32_t pos = _h1(p_hash) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			const Group group(_ctrl + pos);
+			for (Mask match = group.match(h2); match; match.clear_lowest()) {
+				const uint32_t slot = (pos + match.lowest()) & _capacity_mask;
+				if (likely(Comparator::compare(_get_key(_elements[_indices[slot]]), p_key))) {
+					r_slot = slot;
+					return true;
+				}
+			}
+			if (likely(group.match_empty())) {
+				return false;
+			}
+			// Triangular probing visits every group, as the capacity is a power of two.
+			step += GROUP_WIDTH;
+			pos = (pos + step) & _capacity_mask;
+		}
+	}
+
+	_FORCE_INLINE_ bool _lookup_index(const TKey &p_key, uint32_t &r_element_idx) const {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return false;
+		}
+		r_element_idx = _indices[slot];
+		return true;
+	}
+
+	uint32_t _find_free_slot(uint32_t p_hash) const {
+		uint32_t pos = _h1(p_hash) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			const Mask free = Group(_ctrl + pos).match_empty_or_deleted();
+			if (likely(free)) {
+				return (pos + free.lowest()) & _capacity_mask;
+			}
+			step += GROUP_WIDTH;
+			pos = (pos + step) & _capacity_mask;
+		}
+	}
+
+	// Finds the slot pointing to an element without comparing keys, for when the element is being moved.
+	uint32_t _find_element_slot(uint32_t p_hash, uint32_t p_element_idx) const {
+		const int8_t h2 = _h2(p_hash);
+		uint32_t pos = _h1(p_hash) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			for (Mask match = Group(_ctrl + pos).match(h2); match; match.clear_lowest()) {
+				const uint32_t slot = (pos + match.lowest()) & _capacity_mask;
+				if (_indices[slot] == p_element_idx) {
+					return slot;
+				}
+			}
+			step += GROUP_WIDTH;
+			pos = (pos + step) & _capacity_mask;
+		}
+	}
+
+	void _allocate_slots(uint32_t p_capacity) {
+		_capacity_mask = p_capacity - 1;
+		// The capacity is a multiple of the group width, so the indices stay aligned.
+		uint8_t *slots = (uint8_t *)Memory::alloc_static(p_capacity + GROUP_WIDTH + sizeof(uint32_t) * p_capacity);
+		_ctrl = (int8_t *)slots;
+		_indices = (uint32_t *)(slots + p_capacity + GROUP_WIDTH);
+		memset(_ctrl, (uint8_t)FlatHashTableGroup::CTRL_EMPTY, p_capacity + GROUP_WIDTH);
+		_tombstones = 0;
+	}
+
+	_FORCE_INLINE_ void _place(uint32_t p_element_idx, uint32_t p_hash) {
+		const uint32_t slot = _find_free_slot(p_hash);
+		if (_ctrl[slot] == FlatHashTableGroup::CTRL_DELETED) {
+			_tombstones--;
+		}
+		_set_ctrl(slot, _h2(p_hash));
+		_indices[slot] = p_element_idx;
+	}
+
+	void _rehash(uint32_t p_capacity) {
+		if (p_capacity != _capacity_mask + 1) {
+			_elements = reinterpret_cast<TElement *>(Memory::realloc_static(_elements, sizeof(TElement) * _get_max_size(p_capacity - 1)));
+		}
+		Memory::free_static(_ctrl);
+		_allocate_slots(p_capacity);
+		for (uint32_t i = 0; i < _size; i++) {
+			_place(i, Hasher::hash(_get_key(_elements[i])));
+		}
+	}
+
+	// The key must not be in the table yet.
+	template <typename... Args>
+	uint32_t _insert_element(uint32_t p_hash, const Args &...p_args) {
+		if (unlikely(_elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_elements = reinterpret_cast<TElement *>(Memory::alloc_static(sizeof(TElement) * _get_max_size(_capacity_mask)));
+			_allocate_slots(_capacity_mask + 1);
+		} else if (unlikely(_size + _tombstones >= _get_max_size(_capacity_mask))) {
+			// When tombstones make up a good part of the load, getting rid of them is enough.
+			const uint32_t capacity = _capacity_mask + 1;
+			_rehash(_size >= _get_max_size(_capacity_mask) / 2 ? capacity * 2 : capacity);
+		}
+
+		memnew_placement(&_elements[_size], TElement(p_args...));
+		_place(_size, p_hash);
+		return _size++;
+	}
+
+	void _erase_slot(uint32_t p_slot) {
+		const uint32_t element_idx = _indices[p_slot];
+		// Probe sequences may go through this slot, so it can't be marked as empty.
+		_set_ctrl(p_slot, FlatHashTableGroup::CTRL_DELETED);
+		_tombstones++;
+		_elements[element_idx].~TElement();
+		_size--;
+
+		if (element_idx == _size) {
+			return;
+		}
+		if constexpr (KEEP_ORDER) {
+			memmove((void *)&_elements[element_idx], (const void *)&_elements[element_idx + 1], sizeof(TElement) * (_size - element_idx));
+			for (uint32_t i = 0; i <= _capacity_mask; i++) {
+				if (_ctrl[i] >= 0 && _indices[i] > element_idx) {
+					_indices[i]--;
+				}
+			}
+		} else {
+			memcpy((void *)&_elements[element_idx], (const void *)&_elements[_size], sizeof(TElement));
+			_indices[_find_element_slot(Hasher::hash(_get_key(_elements[element_idx])), _size)] = element_idx;
+		}
+	}
+
+	void _destroy_elements() {
+		if constexpr (!std::is_trivially_destructible_v<TElement>) {
+			for (uint32_t i = 0; i < _size; i++) {
+				_elements[i].~TElement();
+			}
+		}
+	}
+
+	void _init_from(const FlatHashTable &p_other) {
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_tombstones = p_other._tombstones;
+
+		if (p_other._elements == nullptr) {
+			return;
+		}
+
+		const uint32_t capacity = _capacity_mask + 1;
+		_elements = reinterpret_cast<TElement *>(Memory::alloc_static(sizeof(TElement) * _get_max_size(_capacity_mask)));
+		if constexpr (std::is_trivially_copyable_v<TElement>) {
+			memcpy((void *)_elements, (const void *)p_other._elements, sizeof(TElement) * _size);
+		} else {
+			for (uint32_t i = 0; i < _size; i++) {
+				memnew_placement(&_elements[i], TElement(p_other._elements[i]));
+			}
+		}
+
+		const uint32_t slots_size = capacity + GROUP_WIDTH + sizeof(uint32_t) * capacity;
+		uint8_t *slots = (uint8_t *)Memory::alloc_static(slots_size);
+		memcpy(slots, p_other._ctrl, slots_size);
+		_ctrl = (int8_t *)slots;
+		_indices = (uint32_t *)(slots + capacity + GROUP_WIDTH);
+	}
+
+	void _move_from(FlatHashTable &p_other) {
+		_elements = p_other._elements;
+		_ctrl = p_other._ctrl;
+		_indices = p_other._indices;
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_tombstones = p_other._tombstones;
+
+		p_other._elements = nullptr;
+		p_other._ctrl = nullptr;
+		p_other._indices = nullptr;
+		p_other._capacity_mask = MIN_CAPACITY - 1;
+		p_other._size = 0;
+		p_other._tombstones = 0;
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity_mask + 1; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+	_FORCE_INLINE_ bool is_empty() const { return _size == 0; }
+
+	bool has(const TKey &p_key) const {
+		uint32_t slot = 0;
+		return _lookup_slot(p_key, Hasher::hash(p_key), slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return false;
+		}
+		_erase_slot(slot);
+		return true;
+	}
+
+	void clear() {
+		if (_elements == nullptr || (_size == 0 && _tombstones == 0)) {
+			return;
+		}
+		_destroy_elements();
+		memset(_ctrl, (uint8_t)FlatHashTableGroup::CTRL_EMPTY, _capacity_mask + 1 + GROUP_WIDTH);
+		_size = 0;
+		_tombstones = 0;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_count) {
+		uint32_t capacity = MAX(MIN_CAPACITY, next_power_of_2(p_count));
+		if (_get_max_size(capacity - 1) < p_count) {
+			capacity <<= 1;
+		}
+		if (capacity <= _capacity_mask + 1) {
+			return;
+		}
+		if (_elements == nullptr) {
+			_capacity_mask = capacity - 1;
+			return; // Unallocated yet.
+		}
+		_rehash(capacity);
+	}
+
+	void reset() {
+		if (_elements != nullptr) {
+			_destroy_elements();
+			Memory::free_static(_elements);
+			Memory::free_static(_ctrl);
+			_elements = nullptr;
+			_ctrl = nullptr;
+			_indices = nullptr;
+		}
+		_capacity_mask = MIN_CAPACITY - 1;
+		_size = 0;
+		_tombstones = 0;
+	}
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const TElement &operator*() const { return *element; }
+		_FORCE_INLINE_ const TElement *operator->() const { return element; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			element++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_it) const { return element == p_it.element; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_it) const { return element != p_it.element; }
+
+		_FORCE_INLINE_ explicit operator bool() const { return element != end; }
+
+		_FORCE_INLINE_ ConstIterator(const TElement *p_element, const TElement *p_end) :
+				element(p_element), end(p_end) {}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const TElement *element = nullptr;
+		const TElement *end = nullptr;
+	};
+
+	_FORCE_INLINE_ ConstIterator begin() const { return ConstIterator(_elements, _elements + _size); }
+	_FORCE_INLINE_ ConstIterator end() const { return ConstIterator(_elements + _size, _elements + _size); }
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		if (!_lookup_index(p_key, element_idx)) {
+			return end();
+		}
+		return ConstIterator(_elements + element_idx, _elements + _size);
+	}
+
+	/* Constructors */
+
+	FlatHashTable() {}
+
+	FlatHashTable(const FlatHashTable &p_other) {
+		_init_from(p_other);
+	}
+
+	FlatHashTable(FlatHashTable &&p_other) {
+		_move_from(p_other);
+	}
+
+	FlatHashTable &operator=(const FlatHashTable &p_other) {
+		if (this != &p_other) {
+			reset();
+			_init_from(p_other);
+		}
+		return *this;
+	}
+
+	FlatHashTable &operator=(FlatHashTable &&p_other) {
+		if (this != &p_other) {
+			reset();
+			_move_from(p_other);
+		}
+		return *this;
+	}
+
+	~FlatHashTable() {
+		reset();
+	}
+};
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>,
+		bool KEEP_ORDER = false>
+class FlatHashMap : public FlatHashTable<TKey, KeyValue<TKey, TValue>, Hasher, Comparator, KEEP_ORDER> {
+	typedef FlatHashTable<TKey, KeyValue<TKey, TValue>, Hasher, Comparator, KEEP_ORDER> Table;
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+public:
+	using typename Table::ConstIterator;
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const { return *element; }
+		_FORCE_INLINE_ MapKeyValue *operator->() const { return element; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			element++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &p_it) const { return element == p_it.element; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &p_it) const { return element != p_it.element; }
+
+		_FORCE_INLINE_ explicit operator bool() const { return element != end; }
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_element, MapKeyValue *p_end) :
+				element(p_element), end(p_end) {}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const { return ConstIterator(element, end); }
+
+	private:
+		MapKeyValue *element = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() { return Iterator(this->_elements, this->_elements + this->_size); }
+	_FORCE_INLINE_ Iterator end() { return Iterator(this->_elements + this->_size, this->_elements + this->_size); }
+	_FORCE_INLINE_ ConstIterator begin() const { return Table::begin(); }
+	_FORCE_INLINE_ ConstIterator end() const { return Table::end(); }
+
+	Iterator find(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		if (!this->_lookup_index(p_key, element_idx)) {
+			return end();
+		}
+		return Iterator(this->_elements + element_idx, this->_elements + this->_size);
+	}
+	ConstIterator find(const TKey &p_key) const { return Table::find(p_key); }
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			this->erase(p_iter->key);
+		}
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		if (!this->_lookup_index(p_key, element_idx)) {
+			return nullptr;
+		}
+		return &this->_elements[element_idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		if (!this->_lookup_index(p_key, element_idx)) {
+			return nullptr;
+		}
+		return &this->_elements[element_idx].value;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		bool exists = this->_lookup_index(p_key, element_idx);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return this->_elements[element_idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		bool exists = this->_lookup_index(p_key, element_idx);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return this->_elements[element_idx].value;
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		bool exists = this->_lookup_index(p_key, element_idx);
+		CRASH_COND(!exists);
+		return this->_elements[element_idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		const uint32_t hash = Hasher::hash(p_key);
+		uint32_t slot = 0;
+		if (this->_lookup_slot(p_key, hash, slot)) {
+			return this->_elements[this->_indices[slot]].value;
+		}
+		const uint32_t element_idx = this->_insert_element(hash, p_key, TValue());
+		return this->_elements[element_idx].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		const uint32_t hash = Hasher::hash(p_key);
+		uint32_t slot = 0;
+		uint32_t element_idx;
+		if (this->_lookup_slot(p_key, hash, slot)) {
+			element_idx = this->_indices[slot];
+			this->_elements[element_idx].value = p_value;
+		} else {
+			element_idx = this->_insert_element(hash, p_key, p_value);
+		}
+		return Iterator(this->_elements + element_idx, this->_elements + this->_size);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!this->has(p_key));
+		const uint32_t element_idx = this->_insert_element(Hasher::hash(p_key), p_key, p_value);
+		return Iterator(this->_elements + element_idx, this->_elements + this->_size);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(uint32_t p_reserve) {
+		this->reserve(p_reserve);
+	}
+	FlatHashMap() {}
+
+	FlatHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		this->reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+};
+
+template <typename TKey,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>,
+		bool KEEP_ORDER = false>
+class FlatHashSet : public FlatHashTable<TKey, TKey, Hasher, Comparator, KEEP_ORDER> {
+	typedef FlatHashTable<TKey, TKey, Hasher, Comparator, KEEP_ORDER> Table;
+
+public:
+	using typename Table::ConstIterator;
+	typedef ConstIterator Iterator;
+
+	void remove(const ConstIterator &p_iter) {
+		if (p_iter) {
+			this->erase(*p_iter);
+		}
+	}
+
+	ConstIterator insert(const TKey &p_key) {
+		const uint32_t hash = Hasher::hash(p_key);
+		uint32_t slot = 0;
+		uint32_t element_idx;
+		if (this->_lookup_slot(p_key, hash, slot)) {
+			element_idx = this->_indices[slot];
+		} else {
+			element_idx = this->_insert_element(hash, p_key);
+		}
+		return ConstIterator(this->_elements + element_idx, this->_elements + this->_size);
+	}
+
+	/* Constructors */
+
+	FlatHashSet(uint32_t p_reserve) {
+		this->reserve(p_reserve);
+	}
+	FlatHashSet() {}
+
+	FlatHashSet(std::initializer_list<TKey> p_init) {
+		this->reserve(p_init.size());
+		for (const TKey &E : p_init) {
+			insert(E);
+		}
+	}
+};
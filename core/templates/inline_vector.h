@@ -0,0 +1,252 @@
+/**************************************************************************/
+/*  inline_vector.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/span.h"
+
+#include <initializer_list>
+#include <type_traits>
+
+GODOT_GCC_WARNING_PUSH_AND_IGNORE("-Warray-bounds")
+
+/**
+ * A vector that keeps up to INLINE_CAPACITY elements inside itself, and only moves them to the heap
+ * when it outgrows that. Unlike Vector, it isn't reference counted, so it never touches atomics.
+ *
+ * Useful for short temporary arrays whose usual size is known but which have no hard limit
+ * (use FixedVector if they do).
+ *
+ * Elements are relocated with memcpy, as in LocalVector, and the vector itself can be relocated
+ * the same way (it doesn't point into itself).
+ */
+template <typename T, uint32_t INLINE_CAPACITY>
+class InlineVector {
+	static_assert(INLINE_CAPACITY > 0);
+
+	uint32_t _size = 0;
+	uint32_t _capacity = INLINE_CAPACITY;
+	T *_heap = nullptr; // Only set when the elements don't fit inline.
+	alignas(T) uint8_t _inline[INLINE_CAPACITY * sizeof(T)];
+
+	template <bool p_init>
+	void _resize(uint32_t p_size) {
+		if (p_size < _size) {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				for (uint32_t i = p_size; i < _size; i++) {
+					ptr()[i].~T();
+				}
+			}
+		} else if (p_size > _size) {
+			reserve(p_size);
+			if constexpr (p_init) {
+				memnew_arr_placement(ptr() + _size, p_size - _size);
+			} else {
+				static_assert(std::is_trivially_destructible_v<T>, "T must be trivially destructible to resize uninitialized");
+			}
+		}
+		_size = p_size;
+	}
+
+	void _grow(uint32_t p_size) {
+		uint32_t capacity = MAX(_capacity + (_capacity >> 1), p_size);
+		T *heap = (T *)Memory::alloc_static(capacity * sizeof(T));
+		CRASH_COND_MSG(!heap, "Out of memory");
+		memcpy((void *)heap, (const void *)ptr(), _size * sizeof(T));
+		if (_heap) {
+			Memory::free_static(_heap);
+		}
+		_heap = heap;
+		_capacity = capacity;
+	}
+
+	void _copy_from(const InlineVector &p_from) {
+		reserve(p_from._size);
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			memcpy((void *)ptr(), (const void *)p_from.ptr(), p_from._size * sizeof(T));
+		} else {
+			for (uint32_t i = 0; i < p_from._size; i++) {
+				memnew_placement(ptr() + i, T(p_from.ptr()[i]));
+			}
+		}
+		_size = p_from._size;
+	}
+
+	void _move_from(InlineVector &p_from) {
+		if (p_from._heap) {
+			_heap = p_from._heap;
+			_capacity = p_from._capacity;
+			p_from._heap = nullptr;
+			p_from._capacity = INLINE_CAPACITY;
+		} else {
+			memcpy((void *)_inline, (const void *)p_from._inline, p_from._size * sizeof(T));
+		}
+		_size = p_from._size;
+		p_from._size = 0;
+	}
+
+public:
+	_FORCE_INLINE_ T *ptr() { return _heap ? _heap : (T *)_inline; }
+	_FORCE_INLINE_ const T *ptr() const { return _heap ? _heap : (const T *)_inline; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+	_FORCE_INLINE_ bool is_empty() const { return _size == 0; }
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity; }
+	// Whether the elements are still stored inline, without any heap allocation.
+	_FORCE_INLINE_ bool is_inline() const { return _heap == nullptr; }
+
+	_FORCE_INLINE_ Span<T> span() const { return Span(ptr(), _size); }
+	_FORCE_INLINE_ operator Span<T>() const { return span(); }
+
+	// Must take a copy instead of a reference (see GH-31736).
+	_FORCE_INLINE_ void push_back(T p_elem) {
+		if (unlikely(_size == _capacity)) {
+			_grow(_size + 1);
+		}
+		memnew_placement(ptr() + _size++, T(std::move(p_elem)));
+	}
+
+	void pop_back() {
+		ERR_FAIL_COND(_size == 0);
+		_size--;
+		ptr()[_size].~T();
+	}
+
+	void remove_at(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, _size);
+		T *data = ptr();
+		_size--;
+		for (uint32_t i = p_index; i < _size; i++) {
+			data[i] = std::move(data[i + 1]);
+		}
+		data[_size].~T();
+	}
+
+	void remove_at_unordered(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, _size);
+		T *data = ptr();
+		_size--;
+		if (_size > p_index) {
+			data[p_index] = std::move(data[_size]);
+		}
+		data[_size].~T();
+	}
+
+	bool erase(const T &p_val) {
+		int64_t idx = find(p_val);
+		if (idx >= 0) {
+			remove_at(idx);
+			return true;
+		}
+		return false;
+	}
+
+	int64_t find(const T &p_val, uint32_t p_from = 0) const {
+		const T *data = ptr();
+		for (uint32_t i = p_from; i < _size; i++) {
+			if (data[i] == p_val) {
+				return int64_t(i);
+			}
+		}
+		return -1;
+	}
+
+	bool has(const T &p_val) const { return find(p_val) != -1; }
+
+	_FORCE_INLINE_ void clear() { resize(0); }
+	// Also gives the heap memory back, if any.
+	void reset() {
+		clear();
+		if (_heap) {
+			Memory::free_static(_heap);
+			_heap = nullptr;
+			_capacity = INLINE_CAPACITY;
+		}
+	}
+
+	void reserve(uint32_t p_size) {
+		if (p_size > _capacity) {
+			_grow(p_size);
+		}
+	}
+
+	/// Resize the vector.
+	/// Elements are initialized (or not) depending on what the default C++ behavior for T is.
+	void resize(uint32_t p_size) { _resize<!std::is_trivially_constructible_v<T>>(p_size); }
+	/// Resize and set all values to 0 / false / nullptr.
+	_FORCE_INLINE_ void resize_initialized(uint32_t p_size) { _resize<true>(p_size); }
+	/// Resize without initializing new values, only available for trivially destructible types.
+	_FORCE_INLINE_ void resize_uninitialized(uint32_t p_size) { _resize<false>(p_size); }
+
+	_FORCE_INLINE_ const T &operator[](uint32_t p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return ptr()[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return ptr()[p_index];
+	}
+
+	_FORCE_INLINE_ T *begin() { return ptr(); }
+	_FORCE_INLINE_ T *end() { return ptr() + _size; }
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + _size; }
+
+	InlineVector &operator=(const InlineVector &p_from) {
+		if (this != &p_from) {
+			clear();
+			_copy_from(p_from);
+		}
+		return *this;
+	}
+
+	InlineVector &operator=(InlineVector &&p_from) {
+		if (this != &p_from) {
+			reset();
+			_move_from(p_from);
+		}
+		return *this;
+	}
+
+	InlineVector() {}
+	InlineVector(std::initializer_list<T> p_init) {
+		reserve(p_init.size());
+		for (const T &element : p_init) {
+			push_back(element);
+		}
+	}
+	InlineVector(const InlineVector &p_from) { _copy_from(p_from); }
+	InlineVector(InlineVector &&p_from) { _move_from(p_from); }
+
+	~InlineVector() { reset(); }
+};
+
+GODOT_GCC_WARNING_POP
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  lock_free_queue.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <atomic>
+#include <type_traits>
+
+// Bounded multi-producer, multi-consumer queue (after Dmitry Vyukov's design).
+// - Any thread may push or pop; neither operation ever blocks or allocates.
+// - push() fails when the queue is full and pop() fails when it's empty, so
+//   callers are expected to keep a locked fallback path for the overflow case.
+// - Each cell carries a sequence number, so producers and consumers only
+//   contend on the cell they are claiming, not on a global lock.
+
+template <typename T, uint32_t CAPACITY>
+class LockFreeQueue {
+	static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "LockFreeQueue capacity must be a power of two.");
+	static_assert(std::is_trivially_copyable_v<T>);
+
+	static constexpr uint32_t MASK = CAPACITY - 1;
+
+	struct Cell {
+		std::atomic<uint32_t> sequence;
+		T data;
+	};
+
+	// Keep producers and consumers on separate cache lines. Padding is used instead of
+	// alignas() because queues may be embedded in memalloc()'ed structures.
+	std::atomic<uint32_t> enqueue_pos;
+	uint8_t _pad0[64 - sizeof(std::atomic<uint32_t>)];
+	std::atomic<uint32_t> dequeue_pos;
+	uint8_t _pad1[64 - sizeof(std::atomic<uint32_t>)];
+	Cell cells[CAPACITY];
+
+public:
+	_FORCE_INLINE_ static constexpr uint32_t get_capacity() { return CAPACITY; }
+
+	bool push(const T &p_value) {
+		Cell *cell = nullptr;
+		uint32_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		while (true) {
+			cell = &cells[pos & MASK];
+			uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+			int32_t diff = (int32_t)(seq - pos);
+			if (diff == 0) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // Full.
+			} else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->data = p_value;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T &r_value) {
+		Cell *cell = nullptr;
+		uint32_t pos = dequeue_pos.load(std::memory_order_relaxed);
+		while (true) {
+			cell = &cells[pos & MASK];
+			uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+			int32_t diff = (int32_t)(seq - (pos + 1));
+			if (diff == 0) {
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // Empty.
+			} else {
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		r_value = cell->data;
+		cell->sequence.store(pos + MASK + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Only a hint while other threads are pushing or popping.
+	_FORCE_INLINE_ uint32_t size_approx() const {
+		uint32_t enq = enqueue_pos.load(std::memory_order_acquire);
+		uint32_t deq = dequeue_pos.load(std::memory_order_acquire);
+		int32_t diff = (int32_t)(enq - deq);
+		return diff > 0 ? (uint32_t)diff : 0;
+	}
+
+	_FORCE_INLINE_ bool is_empty_approx() const { return size_approx() == 0; }
+
+	LockFreeQueue() {
+		for (uint32_t i = 0; i < CAPACITY; i++) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		enqueue_pos.store(0, std::memory_order_relaxed);
+		dequeue_pos.store(0, std::memory_order_release);
+	}
+
+	LockFreeQueue(const LockFreeQueue &) = delete;
+	LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+};
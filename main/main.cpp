@@ -277,6 +277,9 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+#ifdef GODOT_USE_BUILTIN_TRACER
+static String trace_file_path;
+#endif
 #ifdef TOOLS_ENABLED
 static bool editor_pseudolocalization = false;
 static bool dump_gdextension_interface = false;
@@ -641,6 +644,13 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--ignore-error-breaks", "If debugger is connected, prevents sending error breakpoints.\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
+#ifdef GODOT_USE_BUILTIN_TRACER
+	print_help_option("--trace-file <file>", "Record the engine's profiling zones and save them to the given file when quitting, in the Chrome trace format (viewable in Perfetto UI).\n");
+#endif
+#ifdef MODULE_GDSCRIPT_ENABLED
+	print_help_option("--gdscript-sampling-profiler <file>", "Sample the call stacks of the running GDScript code and save them to the given file when quitting, in the folded format used by flame graph tools.\n");
+	print_help_option("--gdscript-sampling-interval <usec>", "Interval between the samples of --gdscript-sampling-profiler, in microseconds (default: 1000).\n");
+#endif
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
 	print_help_option("--gpu-abort", "Abort on graphics API usage errors (usually validation layer errors). May help see the problem if your system freezes.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
@@ -1902,6 +1912,18 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 #endif // TOOLS_ENABLED
 		} else if (arg == "--gpu-profile") {
 			profile_gpu = true;
+#ifdef GODOT_USE_BUILTIN_TRACER
+		} else if (arg == "--trace-file") {
+			if (N) {
+				// Made absolute now, as --path changes the working directory.
+				trace_file_path = N->get().is_relative_path() ? OS::get_singleton()->get_cwd().path_join(N->get()) : N->get();
+				BuiltinTracer::set_enabled(true);
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing trace file argument, aborting.\n");
+				goto error;
+			}
+#endif
 		} else if (arg == "--disable-crash-handler") {
 			OS::get_singleton()->disable_crash_handler();
 		} else if (arg == "--skip-breakpoints") {
@@ -5051,6 +5073,15 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+#ifdef GODOT_USE_BUILTIN_TRACER
+	if (!trace_file_path.is_empty()) {
+		BuiltinTracer::set_enabled(false);
+		if (BuiltinTracer::save_chrome_trace(trace_file_path) == OK) {
+			print_line(vformat("Trace saved to \"%s\".", trace_file_path));
+		}
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	if (input) {
 		input->flush_frame_parsed_events();
@@ -121,6 +121,14 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		MEMORY_FRAME_ARENA,
+		MEMORY_FRAME_ARENA_MAX,
+		MEMORY_RENDERING,
+		MEMORY_PHYSICS,
+		MEMORY_SCRIPTING,
+		MEMORY_RESOURCES,
+		MEMORY_AUDIO,
+		MEMORY_NAVIGATION,
 		MONITOR_MAX
 	};
 
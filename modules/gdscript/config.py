@@ -3,6 +3,19 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    from SCons.Variables import PathVariable
+
+    return [
+        PathVariable(
+            "gdscript_native_code",
+            "Path to the C++ file made by the 'gdscript/native_code' export option, to build into the export template",
+            "",
+            PathVariable.PathAccept,
+        ),
+    ]
+
+
 def configure(env):
     pass
 
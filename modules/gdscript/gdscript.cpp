@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -666,6 +667,80 @@ String GDScript::_get_debug_path() const {
 	}
 }
 
+static uint32_t _hash_data_type(const GDScriptDataType &p_type, uint32_t p_hash) {
+	p_hash = hash_murmur3_one_32(p_type.kind, p_hash);
+	p_hash = hash_murmur3_one_32(p_type.builtin_type, p_hash);
+	p_hash = hash_murmur3_one_32(p_type.native_type.hash(), p_hash);
+	p_hash = hash_murmur3_one_64((uint64_t)p_type.script_type, p_hash);
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		p_hash = _hash_data_type(element_type, p_hash);
+	}
+	return p_hash;
+}
+
+static uint32_t _hash_property_info(const PropertyInfo &p_info, uint32_t p_hash) {
+	p_hash = hash_murmur3_one_32(p_info.name.hash(), p_hash);
+	p_hash = hash_murmur3_one_32(p_info.type, p_hash);
+	p_hash = hash_murmur3_one_32(p_info.class_name.hash(), p_hash);
+	p_hash = hash_murmur3_one_32(p_info.hint, p_hash);
+	p_hash = hash_murmur3_one_32(p_info.hint_string.hash(), p_hash);
+	return hash_murmur3_one_32(p_info.usage, p_hash);
+}
+
+uint32_t GDScript::_get_interface_hash() const {
+	// Function bodies are left out: they're called by name, so the code using them doesn't depend on them.
+	// Constants are in, since their values can be folded into that code.
+	uint32_t hash = hash_murmur3_one_32(tool);
+	hash = hash_murmur3_one_32(_is_abstract, hash);
+	// The base stays the same object when reloaded, so its interface is hashed rather than its address,
+	// for the scripts further down the inheritance chain to be reloaded along with it.
+	hash = hash_murmur3_one_32(base.is_valid() ? base->interface_hash : 0, hash);
+	hash = hash_murmur3_one_32(native.is_valid() ? native->get_name().hash() : 0, hash);
+	hash = hash_murmur3_one_32(global_name.hash(), hash);
+
+	for (const KeyValue<StringName, MemberInfo> &E : member_indices) {
+		hash = hash_murmur3_one_32(E.key.hash(), hash);
+		hash = hash_murmur3_one_32(E.value.index, hash);
+		hash = hash_murmur3_one_32(E.value.setter.hash(), hash);
+		hash = hash_murmur3_one_32(E.value.getter.hash(), hash);
+		hash = _hash_data_type(E.value.data_type, hash);
+		hash = _hash_property_info(E.value.property_info, hash);
+	}
+	for (const KeyValue<StringName, MemberInfo> &E : static_variables_indices) {
+		hash = hash_murmur3_one_32(E.key.hash(), hash);
+		hash = hash_murmur3_one_32(E.value.index, hash);
+		hash = _hash_data_type(E.value.data_type, hash);
+	}
+	for (const KeyValue<StringName, Variant> &E : constants) {
+		hash = hash_murmur3_one_32(E.key.hash(), hash);
+		hash = hash_murmur3_one_32(E.value.hash(), hash);
+	}
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		const MethodInfo info = E.value->get_method_info();
+		hash = hash_murmur3_one_32(E.key.hash(), hash);
+		hash = hash_murmur3_one_32(info.flags, hash);
+		hash = hash_murmur3_one_32(info.default_arguments.size(), hash);
+		hash = _hash_property_info(info.return_val, hash);
+		for (const PropertyInfo &argument : info.arguments) {
+			hash = _hash_property_info(argument, hash);
+		}
+		hash = _hash_data_type(E.value->return_type, hash);
+	}
+	for (const KeyValue<StringName, MethodInfo> &E : _signals) {
+		hash = hash_murmur3_one_32(E.key.hash(), hash);
+		for (const PropertyInfo &argument : E.value.arguments) {
+			hash = _hash_property_info(argument, hash);
+		}
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : subclasses) {
+		hash = hash_murmur3_one_32(E.key.hash(), hash);
+		hash = hash_murmur3_one_32(E.value->_get_interface_hash(), hash);
+	}
+	hash = hash_murmur3_one_32(rpc_config.hash(), hash);
+
+	return hash_fmix32(hash);
+}
+
 Error GDScript::_static_init() {
 	if (likely(valid) && static_initializer) {
 		Callable::CallError call_err;
@@ -742,6 +817,9 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 	reloading = true;
 
+	// Members and functions are about to change, the inline caches referring to them can't be used anymore.
+	_invalidate_inline_caches();
+
 	bool has_instances;
 	{
 		MutexLock lock(GDScriptLanguage::singleton->mutex);
@@ -795,7 +873,9 @@ Error GDScript::reload(bool p_keep_state) {
 						source_hash = source.hash();
 					}
 					if (parser_ref->get_source_hash() != source_hash) {
-						GDScriptCache::remove_parser(source_path);
+						// The scripts depending on this one are only analyzed again if its interface changes, see below.
+						GDScriptCache::remove_parser(source_path, false);
+						dependent_parsers_outdated = true;
 					}
 				}
 			}
@@ -811,6 +891,25 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+
+	if (!bytecode_cache.is_empty()) {
+		// Only used once, later reloads compile the script.
+		const Vector<uint8_t> cache = bytecode_cache;
+		bytecode_cache.clear();
+		if (GDScriptBytecodeCache::load(this, cache, p_keep_state) == OK) {
+			if (ScriptServer::is_scripting_enabled() || tool) {
+				Error err = _static_init();
+				if (err) {
+					reloading = false;
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+		print_verbose(vformat(R"(GDScript: The bytecode cache of "%s" can't be used, compiling it instead.)", path));
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -865,6 +964,16 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	const uint32_t previous_interface_hash = interface_hash;
+	interface_hash = _get_interface_hash();
+	if (dependent_parsers_outdated) {
+		// Kept when only the bodies of the functions changed, which is the most common edit.
+		if (interface_hash != previous_interface_hash || previous_interface_hash == 0) {
+			GDScriptCache::remove_dependent_parsers(path.is_empty() ? get_path() : path);
+		}
+		dependent_parsers_outdated = false;
+	}
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1423,8 +1532,16 @@ void GDScript::_collect_dependencies(RBSet<GDScript *> &p_dependencies, const GD
 	}
 }
 
+void GDScript::_invalidate_inline_caches() {
+	// Always greater than the previous versions of any script, so it also changes the versions of the inheriting scripts.
+	static SafeNumeric<uint64_t> last_version;
+	inline_cache_version = last_version.increment();
+}
+
 GDScript::GDScript() :
 		script_list(this) {
+	_invalidate_inline_caches(); // Another script may have been allocated at the same address.
+
 	{
 		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 
@@ -1551,6 +1668,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	_invalidate_inline_caches();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -2304,6 +2422,23 @@ void GDScriptLanguage::init() {
 	}
 #endif // DEBUG_ENABLED
 
+	// The global classes and autoloads are what most projects load first, and what other scripts depend on.
+	// Parse them in parallel now, so loading them only has to analyze and compile them.
+	Vector<String> project_scripts;
+	LocalVector<StringName> global_classes;
+	ScriptServer::get_global_class_list(global_classes);
+	for (const StringName &class_name : global_classes) {
+		if (ScriptServer::get_global_class_language(class_name) == get_name()) {
+			project_scripts.push_back(ScriptServer::get_global_class_path(class_name));
+		}
+	}
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		if (E.value.path.has_extension("gd") && !project_scripts.has(E.value.path)) {
+			project_scripts.push_back(E.value.path);
+		}
+	}
+	GDScriptCache::parse_scripts(project_scripts);
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif // TESTS_ENABLED
@@ -2345,6 +2480,14 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	if (!sampling_profiler_path.is_empty()) {
+		GDScriptSamplingProfiler::stop();
+		if (GDScriptSamplingProfiler::save_folded_stacks(sampling_profiler_path) == OK) {
+			print_line(vformat("Saved %d GDScript samples to \"%s\".", GDScriptSamplingProfiler::get_sample_count(), sampling_profiler_path));
+		}
+		sampling_profiler_path = String();
+	}
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2656,8 +2799,16 @@ void GDScriptLanguage::reload_scripts(const Array &p_scripts, bool p_soft_reload
 		}
 	}
 
+	// Reloaded scripts whose interface changed. Scripts inheriting from other ones only have to be reloaded
+	// along with them in that case, since the code of the functions they inherit isn't compiled into theirs.
+	HashSet<const Script *> changed_interfaces;
+
 	for (KeyValue<Ref<GDScript>, HashMap<ObjectID, List<Pair<StringName, Variant>>>> &E : to_reload) {
 		Ref<GDScript> scr = E.key;
+		if (p_soft_reload && !p_scripts.has(scr) && !changed_interfaces.has(scr->get_base().ptr())) {
+			print_verbose("GDScript: Not reloading: " + scr->get_path() + " (the interface of its base didn't change)");
+			continue;
+		}
 		print_verbose("GDScript: Reloading: " + scr->get_path());
 		if (scr->is_built_in()) {
 			// TODO: It would be nice to do it more efficiently than loading the whole scene again.
@@ -2672,7 +2823,12 @@ void GDScriptLanguage::reload_scripts(const Array &p_scripts, bool p_soft_reload
 		} else {
 			scr->load_source_code(scr->get_path());
 		}
-		scr->reload(p_soft_reload);
+		const uint32_t previous_interface_hash = scr->interface_hash;
+		const bool base_changed = changed_interfaces.has(scr->get_base().ptr());
+		if (scr->reload(p_soft_reload) != OK || scr->interface_hash != previous_interface_hash || base_changed) {
+			// What it inherits changed too, even if its own declarations didn't.
+			changed_interfaces.insert(scr.ptr());
+		}
 
 		//restore state if saved
 		for (KeyValue<ObjectID, List<Pair<StringName, Variant>>> &F : E.value) {
@@ -2725,6 +2881,9 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 }
 
 void GDScriptLanguage::frame() {
+	// Scripts that weren't loaded during startup are parsed again if they're loaded later.
+	GDScriptCache::release_preparsed_parsers();
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(mutex);
@@ -2976,6 +3135,21 @@ GDScriptLanguage::GDScriptLanguage() {
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
 
+	uint64_t sampling_interval_usec = GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC;
+	const List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (E->get() == "--gdscript-sampling-profiler" && E->next()) {
+			sampling_profiler_path = E->next()->get();
+		} else if (E->get() == "--gdscript-sampling-interval" && E->next()) {
+			sampling_interval_usec = MAX(E->next()->get().to_int(), 1);
+		}
+	}
+	if (!sampling_profiler_path.is_empty()) {
+		// The samples need the lines and the call stack, also in release builds.
+		track_call_stack = true;
+		GDScriptSamplingProfiler::start(sampling_interval_usec);
+	}
+
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
 	track_locals = track_locals || EngineDebugger::is_active();
@@ -3008,6 +3182,7 @@ GDScriptLanguage::GDScriptLanguage() {
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
+	GDScriptFunction::clear_await_frame_pool();
 	singleton = nullptr;
 }
 
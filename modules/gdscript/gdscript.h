@@ -31,6 +31,7 @@
 #pragma once
 
 #include "gdscript_function.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
@@ -85,6 +86,7 @@ class GDScript : public Script {
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
 	friend class GDScriptCompiler;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
@@ -165,6 +167,10 @@ private:
 	void _clear_doc();
 #endif
 
+	// Changes whenever the members or functions of the script are replaced, see `GDScriptFunction::InlineCache`.
+	uint64_t inline_cache_version = 0;
+	void _invalidate_inline_caches();
+
 	GDScriptFunction *initializer = nullptr; // Direct pointer to `new()`/`_init()` member function, faster to locate.
 
 	GDScriptFunction *implicit_initializer = nullptr; // `@implicit_new()` special function.
@@ -180,6 +186,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode_cache; // Used by the next reload instead of compiling, if possible.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -196,6 +203,12 @@ private:
 
 	String _get_debug_path() const;
 
+	// Hash of what the scripts inheriting from or using this one are analyzed and compiled against.
+	// As long as it doesn't change, reloading this script doesn't require reloading them.
+	uint32_t interface_hash = 0;
+	bool dependent_parsers_outdated = false; // The parser was removed, but not yet the parsers depending on it.
+	uint32_t _get_interface_hash() const;
+
 #ifdef TOOLS_ENABLED
 	HashSet<PlaceHolderScriptInstance *> placeholders;
 	//void _update_placeholder(PlaceHolderScriptInstance *p_placeholder);
@@ -240,6 +253,16 @@ public:
 
 	_FORCE_INLINE_ StringName get_local_name() const { return local_name; }
 
+	// Also changes when one of the base scripts changes, as their members and functions are found through this one.
+	// The versions are never reused, even by scripts allocated where a freed one was.
+	_FORCE_INLINE_ uint64_t get_inline_cache_version() const {
+		uint64_t version = inline_cache_version;
+		for (const GDScript *script = base.ptr(); script; script = script->base.ptr()) {
+			version = MAX(version, script->inline_cache_version);
+		}
+		return version;
+	}
+
 	void clear(GDScript::ClearData *p_clear_data = nullptr);
 
 	// Cancels all functions of the script that are are waiting to be resumed after using await.
@@ -318,6 +341,8 @@ public:
 	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
 	const Vector<uint8_t> &get_binary_tokens_source() const;
 	Vector<uint8_t> get_as_binary_tokens() const;
+	void set_bytecode_cache(const Vector<uint8_t> &p_contents) { bytecode_cache = p_contents; }
+	const Vector<uint8_t> &get_bytecode_cache() const { return bytecode_cache; }
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
 
@@ -418,6 +443,7 @@ public:
 
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptSamplingProfiler;
 
 	static GDScriptLanguage *singleton;
 
@@ -449,6 +475,8 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool track_call_stack = false;
 	bool track_locals = false;
 
+	String sampling_profiler_path; // From `--gdscript-sampling-profiler`, saved when finishing.
+
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
@@ -513,6 +541,10 @@ public:
 		call_level->ip = p_ip;
 		call_level->line = p_line;
 		_call_stack_size++;
+
+		if (_call_stack_size == 1) {
+			GDScriptSamplingProfiler::thread_entered();
+		}
 	}
 
 	_FORCE_INLINE_ void exit_function() {
@@ -32,6 +32,110 @@
 
 #include "core/debugger/engine_debugger.h"
 
+// Whether values of the type are stored inside the Variant, so writing one never frees anything.
+static bool _is_inline_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::COLOR:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Typed `int`, `float` and `Vector3` operations the VM does directly on the values, without calling the validated evaluator.
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+			default:
+				break; // Integer division and modulo need to check for division by zero.
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::VECTOR3) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3;
+			default:
+				break; // Component-wise multiplication and division are rare enough to keep using the evaluator.
+		}
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::FLOAT && p_operator == Variant::OP_MULTIPLY) {
+		return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT;
+	}
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+}
+
+// Comparisons of typed `int` and `float` values the VM can do while testing the condition of a jump.
+static GDScriptFunction::Opcode _get_typed_jump_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_EQUAL;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_LESS;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_GREATER;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_EQUAL;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_NOT_EQUAL;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_LESS;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+}
+
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
 	function->_argument_count++;
 	function->argument_types.push_back(p_type);
@@ -564,6 +668,11 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
+		if (p_target.mode == Address::TEMPORARY) {
+			last_operator_pos = opcodes.size() - 5;
+			last_operator_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
+			last_operator_jump_opcode = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+		}
 		return;
 	}
 
@@ -573,6 +682,9 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	append(Address());
 	append(p_target);
 	append(p_operator);
+#ifdef TOOLS_ENABLED
+	function->operator_cache_positions.push_back(opcodes.size());
+#endif
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -613,7 +725,8 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+		// The evaluator is still stored with the typed opcodes, for the disassembler and the bytecode cache.
+		append_opcode(_get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type));
 		append(p_left_operand);
 		append(p_right_operand);
 		append(p_target);
@@ -621,6 +734,11 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
+		if (p_target.mode == Address::TEMPORARY) {
+			last_operator_pos = opcodes.size() - 5;
+			last_operator_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+			last_operator_jump_opcode = _get_typed_jump_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		}
 		return;
 	}
 
@@ -630,6 +748,9 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	append(p_right_operand);
 	append(p_target);
 	append(p_operator);
+#ifdef TOOLS_ENABLED
+	function->operator_cache_positions.push_back(opcodes.size());
+#endif
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -859,6 +980,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -877,6 +999,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -966,6 +1089,23 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (is_last_operator_result(p_source) && _is_inline_type(last_operator_type) && (p_target.mode == Address::LOCAL_VARIABLE || p_target.mode == Address::FUNCTION_PARAMETER || p_target.mode == Address::MEMBER)) {
+		const bool same_type = p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == last_operator_type;
+		if (same_type || !p_target.type.has_type()) {
+			// Make the operator write into the target instead of copying its result from the temporary.
+			// Limited to types stored inside the Variant, so the target can also be one of the operands.
+			Vector<int> &indices = temporaries.write[p_source.address].bytecode_indices;
+			indices.remove_at(indices.size() - 1);
+			opcodes.write[last_operator_pos + 3] = address_of(p_target);
+			if (opcodes[last_operator_pos] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+				opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+				append(last_operator_type);
+			} // Typed `int` and `float` operators already set the type of their result.
+			last_operator_pos = -1;
+			return;
+		}
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type(0);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -1026,10 +1166,16 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+#ifdef TOOLS_ENABLED
+	function->global_index_positions.push_back(opcodes.size());
+#endif
 	append(p_global_index);
 }
 
 void GDScriptByteCodeGenerator::write_store_named_global(const Address &p_dst, const StringName &p_global) {
+#ifdef TOOLS_ENABLED
+	function->named_global_positions.push_back(opcodes.size());
+#endif
 	append_opcode(GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL);
 	append(p_dst);
 	append(p_global);
@@ -1090,6 +1236,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1115,6 +1262,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1349,6 +1497,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1362,6 +1511,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1375,6 +1525,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1509,6 +1660,15 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	if (is_last_operator_result(p_condition) && last_operator_type == Variant::BOOL) {
+		// Test the result of the comparison in the same instruction.
+		opcodes.write[last_operator_pos] = last_operator_jump_opcode;
+		last_operator_pos = -1;
+		if_jmp_addrs.push_back(opcodes.size());
+		append(0); // Jump destination, will be patched.
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
@@ -1780,10 +1940,19 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator_pos = -1; // Jumped to by `continue`.
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
+	if (is_last_operator_result(p_condition) && last_operator_type == Variant::BOOL) {
+		opcodes.write[last_operator_pos] = last_operator_jump_opcode;
+		last_operator_pos = -1;
+		while_jmp_addrs.push_back(opcodes.size());
+		append(0); // End of loop address, will be patched.
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
@@ -1927,10 +2096,22 @@ void GDScriptByteCodeGenerator::write_return(const Address &p_return_value) {
 	}
 }
 
+void GDScriptByteCodeGenerator::start_assert() {
+#ifdef TOOLS_ENABLED
+	assert_start = opcodes.size();
+#endif
+}
+
 void GDScriptByteCodeGenerator::write_assert(const Address &p_test, const Address &p_message) {
 	append_opcode(GDScriptFunction::OPCODE_ASSERT);
 	append(p_test);
 	append(p_message);
+#ifdef TOOLS_ENABLED
+	if (assert_start >= 0) {
+		function->assert_ranges.push_back(Pair<int, int>(assert_start, opcodes.size()));
+		assert_start = -1;
+	}
+#endif
 }
 
 void GDScriptByteCodeGenerator::start_block() {
@@ -100,6 +100,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int current_line = 0;
 	int instr_args_max = 0;
 
+	// Set when the last instruction is a validated operator writing into a temporary,
+	// so the instruction consuming its result can be fused into it.
+	int last_operator_pos = -1;
+	Variant::Type last_operator_type = Variant::NIL;
+	GDScriptFunction::Opcode last_operator_jump_opcode = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
 #endif
@@ -108,6 +114,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<StringName, int> name_map;
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
+	int assert_start = -1;
 #endif
 	RBMap<Variant::ValidatedOperatorEvaluator, int> operator_func_map;
 	RBMap<Variant::ValidatedSetter, int> setters_map;
@@ -378,10 +385,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		last_operator_pos = -1;
 		opcodes.push_back(p_code);
 	}
 
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
+		last_operator_pos = -1;
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
 		instr_args_max = MAX(instr_args_max, p_argument_count);
@@ -451,8 +460,26 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+#ifdef TOOLS_ENABLED
+		function->inline_cache_positions.push_back(opcodes.size());
+#endif
+		for (int i = 0; i < GDScriptFunction::INLINE_CACHE_SIZE; i++) {
+			opcodes.push_back(0); // Space for the cache, filled when run.
+		}
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_operator_pos = -1; // Code is jumping here, the previous instruction can't be fused anymore.
+	}
+
+	bool is_last_operator_result(const Address &p_address) const {
+		if (last_operator_pos < 0 || last_operator_pos + 5 != opcodes.size() || p_address.mode != Address::TEMPORARY) {
+			return false;
+		}
+		const Vector<int> &indices = temporaries[p_address.address].bytecode_indices;
+		return !indices.is_empty() && indices[indices.size() - 1] == last_operator_pos + 3;
 	}
 
 public:
@@ -553,6 +580,7 @@ public:
 	virtual void write_breakpoint() override;
 	virtual void write_newline(int p_line) override;
 	virtual void write_return(const Address &p_return_value) override;
+	virtual void start_assert() override;
 	virtual void write_assert(const Address &p_test, const Address &p_message) override;
 
 	virtual ~GDScriptByteCodeGenerator();
@@ -0,0 +1,1642 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/object/class_db.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+namespace {
+
+const uint32_t HEADER_SIZE = 24;
+
+enum HeaderFlags : uint32_t {
+	FLAG_DEBUG = 1 << 0,
+};
+
+enum ScriptRefKind : uint8_t {
+	SCRIPT_NONE,
+	SCRIPT_LOCAL, // A class of the script being loaded.
+	SCRIPT_GDSCRIPT, // A class of another GDScript file.
+	SCRIPT_RESOURCE, // Any other script, loaded by path.
+};
+
+enum ValueKind : uint8_t {
+	VALUE_PLAIN, // Stored with `encode_variant()`.
+	VALUE_NULL_OBJECT,
+	VALUE_SCRIPT,
+	VALUE_GLOBAL, // An object of the global array, such as a native class.
+	VALUE_RESOURCE,
+	VALUE_ARRAY,
+	VALUE_DICTIONARY,
+};
+
+enum FunctionFlags : uint8_t {
+	FUNCTION_STATIC = 1 << 0,
+	FUNCTION_LAMBDA = 1 << 1,
+	FUNCTION_LAMBDA_USES_SELF = 1 << 2,
+};
+
+enum FunctionSlot {
+	SLOT_MEMBER,
+	SLOT_IMPLICIT_INITIALIZER,
+	SLOT_IMPLICIT_READY,
+	SLOT_STATIC_INITIALIZER,
+	SLOT_LAMBDA,
+};
+
+// Signature storage, return type storage and the evaluator pointer (see `OPCODE_OPERATOR`).
+constexpr int OPERATOR_CACHE_SIZE = 2 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+
+uint32_t _get_build_hash() {
+	return (String(GODOT_VERSION_FULL_CONFIG) + "." + String(GODOT_VERSION_HASH)).hash();
+}
+
+uint32_t _get_build_flags() {
+#ifdef DEBUG_ENABLED
+	return FLAG_DEBUG;
+#else
+	return 0;
+#endif
+}
+
+} // namespace
+
+class GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	uint32_t size = 0;
+	uint32_t position = 0;
+	bool failed = false;
+
+	_FORCE_INLINE_ bool _has(uint32_t p_bytes) {
+		if (unlikely(failed || size - position < p_bytes)) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+public:
+	bool has_failed() const { return failed; }
+	uint32_t get_position() const { return position; }
+
+	void seek(uint32_t p_position) {
+		if (p_position > size) {
+			failed = true;
+			return;
+		}
+		position = p_position;
+	}
+
+	void skip(uint32_t p_bytes) {
+		if (_has(p_bytes)) {
+			position += p_bytes;
+		}
+	}
+
+	uint8_t get_u8() {
+		return _has(1) ? data[position++] : 0;
+	}
+
+	uint32_t get_u32() {
+		if (!_has(4)) {
+			return 0;
+		}
+		const uint32_t value = decode_uint32(&data[position]);
+		position += 4;
+		return value;
+	}
+
+	int32_t get_32() { return (int32_t)get_u32(); }
+
+	// Fails when the elements can't fit in the remaining data, so corrupted counts don't cause huge allocations.
+	uint32_t get_count(uint32_t p_min_element_size = 1) {
+		const uint32_t count = get_u32();
+		if (count > (size - position) / p_min_element_size) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		const uint32_t length = get_u32();
+		if (!_has(length)) {
+			return String();
+		}
+		String string = String::utf8((const char *)&data[position], length);
+		position += length;
+		return string;
+	}
+
+	StringName get_name() { return StringName(get_string()); }
+
+	PropertyInfo get_property_info() {
+		PropertyInfo info;
+		info.type = (Variant::Type)get_u32();
+		info.name = get_string();
+		info.class_name = get_name();
+		info.hint = (PropertyHint)get_u32();
+		info.hint_string = get_string();
+		info.usage = get_u32();
+		return info;
+	}
+
+	Variant get_plain_value() {
+		Variant value;
+		int length = 0;
+		if (failed || decode_variant(value, &data[position], size - position, &length, false) != OK) {
+			failed = true;
+			return Variant();
+		}
+		position += length;
+		return value;
+	}
+
+	Reader(const Vector<uint8_t> &p_data) :
+			data(p_data.ptr()), size(p_data.size()) {}
+};
+
+struct GDScriptBytecodeCache::LoadContext {
+	GDScript *root = nullptr;
+	StringName source;
+	const Vector<uint8_t> *contents = nullptr;
+	LocalVector<GDScript *> classes; // Outer classes first.
+	HashMap<GDScript *, uint32_t> body_positions;
+	HashSet<GDScript *> loading;
+	HashSet<GDScript *> loaded;
+	String error;
+
+	bool has_failed() const { return !error.is_empty(); }
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+};
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_binary_tokens_path) {
+	return p_binary_tokens_path.get_basename() + ".gdbc";
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::open(const Vector<uint8_t> &p_cache, const Vector<uint8_t> &p_binary_tokens) {
+	if (p_cache.size() < (int)HEADER_SIZE || p_binary_tokens.is_empty()) {
+		return Vector<uint8_t>();
+	}
+	const uint8_t *buf = p_cache.ptr();
+	if (buf[0] != 'G' || buf[1] != 'D' || buf[2] != 'B' || buf[3] != 'C') {
+		return Vector<uint8_t>();
+	}
+	if (decode_uint32(&buf[4]) != FORMAT_VERSION || decode_uint32(&buf[8]) != _get_build_hash() || decode_uint32(&buf[12]) != _get_build_flags()) {
+		return Vector<uint8_t>();
+	}
+	if (decode_uint32(&buf[16]) != hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size())) {
+		return Vector<uint8_t>();
+	}
+
+	const uint32_t decompressed_size = decode_uint32(&buf[20]);
+	if (decompressed_size == 0) {
+		return p_cache.slice(HEADER_SIZE);
+	}
+	Vector<uint8_t> contents;
+	contents.resize(decompressed_size);
+	const int64_t result = Compression::decompress(contents.ptrw(), contents.size(), &buf[HEADER_SIZE], p_cache.size() - HEADER_SIZE, Compression::MODE_ZSTD);
+	ERR_FAIL_COND_V_MSG(result != decompressed_size, Vector<uint8_t>(), "Error decompressing GDScript bytecode cache.");
+	return contents;
+}
+
+/* Loading */
+
+Ref<Script> GDScriptBytecodeCache::_read_script_ref(LoadContext &p_context, Reader &p_reader, bool *r_local) {
+	if (r_local) {
+		*r_local = false;
+	}
+
+	const uint8_t kind = p_reader.get_u8();
+	switch (kind) {
+		case SCRIPT_NONE: {
+			return Ref<Script>();
+		}
+		case SCRIPT_LOCAL:
+		case SCRIPT_GDSCRIPT: {
+			GDScript *script = p_context.root;
+			if (kind == SCRIPT_GDSCRIPT) {
+				const String path = p_reader.get_string();
+				Error err = OK;
+				Ref<GDScript> root = GDScriptCache::get_shallow_script(path, err, p_context.root->path);
+				if (err != OK || root.is_null()) {
+					p_context.fail(vformat(R"(Could not load script "%s".)", path));
+					return Ref<Script>();
+				}
+				script = root.ptr();
+			}
+			const uint32_t class_count = p_reader.get_count(4);
+			for (uint32_t i = 0; i < class_count && script; i++) {
+				HashMap<StringName, Ref<GDScript>>::Iterator E = script->subclasses.find(p_reader.get_name());
+				script = E ? E->value.ptr() : nullptr;
+			}
+			if (script == nullptr) {
+				p_context.fail("Could not find an inner class.");
+				return Ref<Script>();
+			}
+			if (r_local) {
+				*r_local = kind == SCRIPT_LOCAL;
+			}
+			return Ref<Script>(script);
+		}
+		case SCRIPT_RESOURCE: {
+			const String path = p_reader.get_string();
+			Ref<Script> script = ResourceLoader::load(path);
+			if (script.is_null()) {
+				p_context.fail(vformat(R"(Could not load script "%s".)", path));
+			}
+			return script;
+		}
+		default: {
+			p_context.fail("Invalid script reference.");
+			return Ref<Script>();
+		}
+	}
+}
+
+Variant GDScriptBytecodeCache::_read_value(LoadContext &p_context, Reader &p_reader) {
+	switch (p_reader.get_u8()) {
+		case VALUE_PLAIN: {
+			return p_reader.get_plain_value();
+		}
+		case VALUE_NULL_OBJECT: {
+			return Variant((Object *)nullptr);
+		}
+		case VALUE_SCRIPT: {
+			return _read_script_ref(p_context, p_reader);
+		}
+		case VALUE_GLOBAL: {
+			const StringName name = p_reader.get_name();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (index == nullptr) {
+				p_context.fail(vformat(R"(Global "%s" doesn't exist.)", name));
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[*index];
+		}
+		case VALUE_RESOURCE: {
+			const String path = p_reader.get_string();
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				p_context.fail(vformat(R"(Could not load resource "%s".)", path));
+			}
+			return resource;
+		}
+		case VALUE_ARRAY: {
+			Array array;
+			if (p_reader.get_u8()) {
+				const uint32_t builtin_type = p_reader.get_u32();
+				const StringName class_name = p_reader.get_name();
+				const Ref<Script> script = _read_script_ref(p_context, p_reader);
+				array.set_typed(builtin_type, class_name, script);
+			}
+			const uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_context.has_failed() && !p_reader.has_failed(); i++) {
+				array.push_back(_read_value(p_context, p_reader));
+			}
+			if (p_reader.get_u8()) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case VALUE_DICTIONARY: {
+			Dictionary dictionary;
+			if (p_reader.get_u8()) {
+				const uint32_t key_type = p_reader.get_u32();
+				const StringName key_class_name = p_reader.get_name();
+				const Ref<Script> key_script = _read_script_ref(p_context, p_reader);
+				const uint32_t value_type = p_reader.get_u32();
+				const StringName value_class_name = p_reader.get_name();
+				const Ref<Script> value_script = _read_script_ref(p_context, p_reader);
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			const uint32_t size = p_reader.get_count(2);
+			for (uint32_t i = 0; i < size && !p_context.has_failed() && !p_reader.has_failed(); i++) {
+				const Variant key = _read_value(p_context, p_reader);
+				dictionary[key] = _read_value(p_context, p_reader);
+			}
+			if (p_reader.get_u8()) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		default: {
+			p_context.fail("Invalid value.");
+			return Variant();
+		}
+	}
+}
+
+GDScriptDataType GDScriptBytecodeCache::_read_data_type(LoadContext &p_context, Reader &p_reader) {
+	GDScriptDataType type;
+	const uint8_t kind = p_reader.get_u8();
+	const uint32_t builtin_type = p_reader.get_u32();
+	if (kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX) {
+		p_context.fail("Invalid data type.");
+		return type;
+	}
+	type.kind = (GDScriptDataType::Kind)kind;
+	type.builtin_type = (Variant::Type)builtin_type;
+	type.native_type = p_reader.get_name();
+
+	bool local = false;
+	Ref<Script> script = _read_script_ref(p_context, p_reader, &local);
+	type.script_type = script.ptr();
+	// Like the compiler, only hold a reference to classes of other files, to avoid cyclic references.
+	if (!local) {
+		type.script_type_ref = script;
+	}
+
+	const uint32_t container_count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < container_count && !p_context.has_failed(); i++) {
+		type.set_container_element_type(i, _read_data_type(p_context, p_reader));
+	}
+	return type;
+}
+
+MethodInfo GDScriptBytecodeCache::_read_method_info(LoadContext &p_context, Reader &p_reader) {
+	MethodInfo info;
+	info.name = p_reader.get_string();
+	info.return_val = p_reader.get_property_info();
+	info.flags = p_reader.get_u32();
+	info.id = p_reader.get_32();
+	const uint32_t argument_count = p_reader.get_count(24);
+	for (uint32_t i = 0; i < argument_count; i++) {
+		info.arguments.push_back(p_reader.get_property_info());
+	}
+	const uint32_t default_count = p_reader.get_count();
+	for (uint32_t i = 0; i < default_count && !p_context.has_failed(); i++) {
+		info.default_arguments.push_back(_read_value(p_context, p_reader));
+	}
+	info.return_val_metadata = p_reader.get_32();
+	const uint32_t metadata_count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < metadata_count; i++) {
+		info.arguments_metadata.push_back(p_reader.get_32());
+	}
+	return info;
+}
+
+GDScript::MemberInfo GDScriptBytecodeCache::_read_member_info(LoadContext &p_context, Reader &p_reader) {
+	GDScript::MemberInfo info;
+	info.index = p_reader.get_32();
+	info.setter = p_reader.get_name();
+	info.getter = p_reader.get_name();
+	info.data_type = _read_data_type(p_context, p_reader);
+	info.property_info = p_reader.get_property_info();
+	return info;
+}
+
+bool GDScriptBytecodeCache::_read_function(LoadContext &p_context, Reader &p_reader, GDScript *p_script, int p_slot, GDScriptFunction *p_parent) {
+	const StringName name = p_reader.get_name();
+	if (p_slot == SLOT_MEMBER && p_script->member_functions.has(name)) {
+		p_context.fail(vformat(R"(Function "%s" is defined twice.)", name));
+		return false;
+	}
+
+	// Owned by the script right away, so it's freed with it whatever happens next.
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->name = name;
+	function->source = p_context.source;
+	switch (p_slot) {
+		case SLOT_MEMBER:
+			p_script->member_functions[name] = function;
+			break;
+		case SLOT_IMPLICIT_INITIALIZER:
+			p_script->implicit_initializer = function;
+			break;
+		case SLOT_IMPLICIT_READY:
+			p_script->implicit_ready = function;
+			break;
+		case SLOT_STATIC_INITIALIZER:
+			p_script->static_initializer = function;
+			break;
+		case SLOT_LAMBDA:
+			p_parent->lambdas.push_back(function);
+			break;
+	}
+
+	const uint8_t flags = p_reader.get_u8();
+	const int capture_count = p_reader.get_32();
+	function->_static = flags & FUNCTION_STATIC;
+	if (flags & FUNCTION_LAMBDA) {
+		p_script->lambda_info.insert(function, { capture_count, bool(flags & FUNCTION_LAMBDA_USES_SELF) });
+	}
+
+	function->_initial_line = p_reader.get_32();
+	function->_argument_count = p_reader.get_32();
+	function->_vararg_index = p_reader.get_32();
+	function->_stack_size = p_reader.get_32();
+	function->_instruction_args_size = p_reader.get_32();
+	function->return_type = _read_data_type(p_context, p_reader);
+	const uint32_t argument_count = p_reader.get_count(10);
+	for (uint32_t i = 0; i < argument_count && !p_context.has_failed(); i++) {
+		function->argument_types.push_back(_read_data_type(p_context, p_reader));
+	}
+	function->method_info = _read_method_info(p_context, p_reader);
+	function->rpc_config = _read_value(p_context, p_reader);
+
+	const uint32_t code_size = p_reader.get_count(4);
+	function->code.resize(code_size);
+	int *code = function->code.ptrw();
+	for (uint32_t i = 0; i < code_size; i++) {
+		code[i] = p_reader.get_32();
+	}
+	if (GDScriptNativeCode::get_function_count() > 0 && !(flags & FUNCTION_LAMBDA)) {
+		// Looked up before the relocations, like the code was when it was translated.
+		const uint64_t key = GDScriptNativeCode::get_key(p_script->fully_qualified_name, name, code, code_size);
+		function->native_code = GDScriptNativeCode::get_function(key, function->_stack_size);
+	}
+	const uint32_t relocation_count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < relocation_count; i++) {
+		const uint32_t position = p_reader.get_u32();
+		const StringName global = p_reader.get_name();
+		const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(global);
+		if (index == nullptr || position >= code_size) {
+			p_context.fail(vformat(R"(Global "%s" doesn't exist.)", global));
+			return false;
+		}
+		code[position] = *index;
+	}
+
+	const uint32_t default_argument_count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < default_argument_count; i++) {
+		function->default_arguments.push_back(p_reader.get_32());
+	}
+
+	const uint32_t temporary_count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < temporary_count; i++) {
+		const int slot = p_reader.get_32();
+		function->temporary_slots[slot] = (Variant::Type)p_reader.get_u32();
+	}
+
+	const uint32_t constant_count = p_reader.get_count();
+	function->constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count && !p_context.has_failed(); i++) {
+		function->constants.write[i] = _read_value(p_context, p_reader);
+	}
+
+	const uint32_t global_name_count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < global_name_count; i++) {
+		function->global_names.push_back(p_reader.get_name());
+	}
+
+	// Native functions, looked up by name.
+	const uint32_t operator_count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < operator_count; i++) {
+		const uint32_t key = p_reader.get_u32();
+		const uint32_t op = key & 0xFF;
+		const uint32_t type_a = (key >> 8) & 0xFF;
+		const uint32_t type_b = key >> 16;
+		Variant::ValidatedOperatorEvaluator evaluator = nullptr;
+		if (op < Variant::OP_MAX && type_a < Variant::VARIANT_MAX && type_b < Variant::VARIANT_MAX) {
+			evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)type_a, (Variant::Type)type_b);
+		}
+		if (evaluator == nullptr) {
+			p_context.fail("Unknown operator.");
+			return false;
+		}
+		function->operator_funcs.push_back(evaluator);
+#ifdef DEBUG_ENABLED
+		function->operator_names.push_back(Variant::get_operator_name((Variant::Operator)op));
+#endif
+	}
+
+#ifdef DEBUG_ENABLED
+#define DEBUG_NAME(m_code) m_code
+#else
+#define DEBUG_NAME(m_code)
+#endif
+
+#define READ_MEMBER_FUNCTIONS(m_functions, m_names, m_lookup)                                          \
+	{                                                                                                  \
+		const uint32_t count = p_reader.get_count(8);                                                  \
+		for (uint32_t i = 0; i < count; i++) {                                                         \
+			const uint32_t type = p_reader.get_u32();                                                  \
+			const StringName member = p_reader.get_name();                                             \
+			if (type >= Variant::VARIANT_MAX || !Variant::m_lookup((Variant::Type)type, member)) {     \
+				p_context.fail(vformat(R"(Unknown builtin member "%s".)", member));                     \
+				return false;                                                                          \
+			}                                                                                          \
+			function->m_functions.push_back(Variant::m_lookup((Variant::Type)type, member));            \
+			DEBUG_NAME(function->m_names.push_back(member));                                           \
+		}                                                                                              \
+	}
+
+#define READ_TYPE_FUNCTIONS(m_functions, m_lookup)                                       \
+	{                                                                                    \
+		const uint32_t count = p_reader.get_count(4);                                    \
+		for (uint32_t i = 0; i < count; i++) {                                           \
+			const uint32_t type = p_reader.get_u32();                                    \
+			if (type >= Variant::VARIANT_MAX || !Variant::m_lookup((Variant::Type)type)) { \
+				p_context.fail("Unknown keyed or indexed member.");                      \
+				return false;                                                            \
+			}                                                                            \
+			function->m_functions.push_back(Variant::m_lookup((Variant::Type)type));      \
+		}                                                                                \
+	}
+
+	READ_MEMBER_FUNCTIONS(setters, setter_names, get_member_validated_setter);
+	READ_MEMBER_FUNCTIONS(getters, getter_names, get_member_validated_getter);
+	READ_TYPE_FUNCTIONS(keyed_setters, get_member_validated_keyed_setter);
+	READ_TYPE_FUNCTIONS(keyed_getters, get_member_validated_keyed_getter);
+	READ_TYPE_FUNCTIONS(indexed_setters, get_member_validated_indexed_setter);
+	READ_TYPE_FUNCTIONS(indexed_getters, get_member_validated_indexed_getter);
+	READ_MEMBER_FUNCTIONS(builtin_methods, builtin_methods_names, get_validated_builtin_method);
+
+#undef READ_MEMBER_FUNCTIONS
+#undef READ_TYPE_FUNCTIONS
+
+	const uint32_t constructor_count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < constructor_count; i++) {
+		const uint32_t type = p_reader.get_u32();
+		const int index = p_reader.get_32();
+		if (type >= Variant::VARIANT_MAX || index < 0 || index >= Variant::get_constructor_count((Variant::Type)type)) {
+			p_context.fail("Unknown constructor.");
+			return false;
+		}
+		function->constructors.push_back(Variant::get_validated_constructor((Variant::Type)type, index));
+		DEBUG_NAME(function->constructors_names.push_back(Variant::get_type_name((Variant::Type)type)));
+	}
+
+	const uint32_t utility_count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < utility_count; i++) {
+		const StringName utility = p_reader.get_name();
+		if (!Variant::get_validated_utility_function(utility)) {
+			p_context.fail(vformat(R"(Unknown utility function "%s".)", utility));
+			return false;
+		}
+		function->utilities.push_back(Variant::get_validated_utility_function(utility));
+		DEBUG_NAME(function->utilities_names.push_back(utility));
+	}
+
+	const uint32_t gds_utility_count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < gds_utility_count; i++) {
+		const StringName utility = p_reader.get_name();
+		if (!GDScriptUtilityFunctions::get_function(utility)) {
+			p_context.fail(vformat(R"(Unknown utility function "%s".)", utility));
+			return false;
+		}
+		function->gds_utilities.push_back(GDScriptUtilityFunctions::get_function(utility));
+		DEBUG_NAME(function->gds_utilities_names.push_back(utility));
+	}
+
+#undef DEBUG_NAME
+
+	const uint32_t method_count = p_reader.get_count(12);
+	for (uint32_t i = 0; i < method_count; i++) {
+		const StringName class_name = p_reader.get_name();
+		const StringName method_name = p_reader.get_name();
+		const uint32_t hash = p_reader.get_u32();
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		if (method == nullptr || method->get_hash() != hash) {
+			p_context.fail(vformat(R"(Method "%s.%s" doesn't exist.)", class_name, method_name));
+			return false;
+		}
+		function->methods.push_back(method);
+	}
+
+	const uint32_t lambda_count = p_reader.get_count();
+	for (uint32_t i = 0; i < lambda_count; i++) {
+		if (!_read_function(p_context, p_reader, p_script, SLOT_LAMBDA, function)) {
+			return false;
+		}
+	}
+
+	const uint32_t stack_debug_count = p_reader.get_count(13);
+	const bool track_locals = GDScriptLanguage::get_singleton()->should_track_locals();
+	for (uint32_t i = 0; i < stack_debug_count; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = p_reader.get_32();
+		stack_debug.pos = p_reader.get_32();
+		stack_debug.added = p_reader.get_u8();
+		stack_debug.identifier = p_reader.get_name();
+		if (track_locals) {
+			function->stack_debug.push_back(stack_debug);
+		}
+	}
+
+	if (p_reader.has_failed()) {
+		p_context.fail("Unexpected end of data.");
+	}
+	if (p_context.has_failed()) {
+		return false;
+	}
+
+	_finish_function(function, flags & FUNCTION_LAMBDA);
+	return true;
+}
+
+void GDScriptBytecodeCache::_finish_function(GDScriptFunction *p_function, bool p_lambda) {
+	// Same as `GDScriptByteCodeGenerator::write_end()`.
+	p_function->_code_ptr = p_function->code.ptrw();
+	p_function->_code_size = p_function->code.size();
+	p_function->_default_arg_ptr = p_function->default_arguments.ptr();
+	p_function->_default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+	p_function->_constants_ptr = p_function->constants.ptrw();
+	p_function->_constant_count = p_function->constants.size();
+	p_function->_global_names_ptr = p_function->global_names.ptr();
+	p_function->_global_names_count = p_function->global_names.size();
+	p_function->_operator_funcs_ptr = p_function->operator_funcs.ptr();
+	p_function->_operator_funcs_count = p_function->operator_funcs.size();
+	p_function->_setters_ptr = p_function->setters.ptr();
+	p_function->_setters_count = p_function->setters.size();
+	p_function->_getters_ptr = p_function->getters.ptr();
+	p_function->_getters_count = p_function->getters.size();
+	p_function->_keyed_setters_ptr = p_function->keyed_setters.ptr();
+	p_function->_keyed_setters_count = p_function->keyed_setters.size();
+	p_function->_keyed_getters_ptr = p_function->keyed_getters.ptr();
+	p_function->_keyed_getters_count = p_function->keyed_getters.size();
+	p_function->_indexed_setters_ptr = p_function->indexed_setters.ptr();
+	p_function->_indexed_setters_count = p_function->indexed_setters.size();
+	p_function->_indexed_getters_ptr = p_function->indexed_getters.ptr();
+	p_function->_indexed_getters_count = p_function->indexed_getters.size();
+	p_function->_builtin_methods_ptr = p_function->builtin_methods.ptr();
+	p_function->_builtin_methods_count = p_function->builtin_methods.size();
+	p_function->_constructors_ptr = p_function->constructors.ptr();
+	p_function->_constructors_count = p_function->constructors.size();
+	p_function->_utilities_ptr = p_function->utilities.ptr();
+	p_function->_utilities_count = p_function->utilities.size();
+	p_function->_gds_utilities_ptr = p_function->gds_utilities.ptr();
+	p_function->_gds_utilities_count = p_function->gds_utilities.size();
+	p_function->_methods_ptr = p_function->methods.ptrw();
+	p_function->_methods_count = p_function->methods.size();
+	p_function->_lambdas_ptr = p_function->lambdas.ptrw();
+	p_function->_lambdas_count = p_function->lambdas.size();
+
+#ifdef DEBUG_ENABLED
+	p_function->func_cname = (String(p_function->source) + " - " + String(p_function->name)).utf8();
+	p_function->_func_cname = p_function->func_cname.get_data();
+
+	if (EngineDebugger::is_active()) {
+		// Same as the compiler, except that functions start at their declaration instead of their body.
+		String signature = String(p_function->source) + "::" + itos(p_function->_initial_line) + "::";
+		if (p_function->_script->local_name != StringName()) {
+			signature += String(p_function->_script->local_name) + ".";
+		}
+		signature += String(p_function->name);
+		if (p_lambda) {
+			signature += "(lambda)";
+		}
+		p_function->profile.signature = signature;
+	}
+#endif
+}
+
+Error GDScriptBytecodeCache::_load_class(LoadContext &p_context, GDScript *p_script) {
+	if (p_context.loaded.has(p_script)) {
+		return OK;
+	}
+	if (p_context.loading.has(p_script)) {
+		p_context.fail("Cyclic inheritance.");
+		return ERR_CYCLIC_LINK;
+	}
+	p_context.loading.insert(p_script);
+
+	Reader reader(*p_context.contents);
+	reader.seek(p_context.body_positions[p_script]);
+
+	p_script->tool = reader.get_u8();
+	p_script->_is_abstract = reader.get_u8();
+
+	const StringName native_name = reader.get_name();
+	const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+	if (native_index) {
+		p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+	}
+	if (p_script->native.is_null()) {
+		p_context.fail(vformat(R"(Native class "%s" doesn't exist.)", native_name));
+		return ERR_CANT_RESOLVE;
+	}
+
+	bool local_base = false;
+	Ref<GDScript> base = _read_script_ref(p_context, reader, &local_base);
+	const uint32_t inherited_member_count = reader.get_u32();
+	if (p_context.has_failed()) {
+		return ERR_CANT_RESOLVE;
+	}
+	if (base.is_valid()) {
+		if (local_base) {
+			Error err = _load_class(p_context, base.ptr());
+			if (err != OK) {
+				return err;
+			}
+		} else if (!base->is_valid()) {
+			Error err = OK;
+			GDScriptCache::get_full_script(base->get_root_script()->path, err, p_context.root->path);
+		}
+		if (!local_base && !base->is_valid()) {
+			p_context.fail(vformat(R"(Base class "%s" could not be loaded.)", base->fully_qualified_name));
+			return ERR_CANT_RESOLVE;
+		}
+		p_script->base = base;
+		p_script->member_indices = base->member_indices;
+	}
+	if (p_script->member_indices.size() != inherited_member_count) {
+		// The members of the base class changed since the cache was made.
+		p_context.fail("The base class doesn't match.");
+		return ERR_INVALID_DATA;
+	}
+
+	const uint32_t member_count = reader.get_count();
+	for (uint32_t i = 0; i < member_count && !p_context.has_failed(); i++) {
+		const StringName name = reader.get_name();
+		p_script->member_indices[name] = _read_member_info(p_context, reader);
+		p_script->members.insert(name);
+	}
+
+	const uint32_t static_variable_count = reader.get_count();
+	for (uint32_t i = 0; i < static_variable_count && !p_context.has_failed(); i++) {
+		const StringName name = reader.get_name();
+		p_script->static_variables_indices[name] = _read_member_info(p_context, reader);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	const uint32_t constant_count = reader.get_count();
+	for (uint32_t i = 0; i < constant_count && !p_context.has_failed(); i++) {
+		const StringName name = reader.get_name();
+		p_script->constants.insert(name, _read_value(p_context, reader));
+	}
+
+	const uint32_t signal_count = reader.get_count();
+	for (uint32_t i = 0; i < signal_count && !p_context.has_failed(); i++) {
+		const StringName name = reader.get_name();
+		p_script->_signals[name] = _read_method_info(p_context, reader);
+	}
+
+	p_script->rpc_config = _read_value(p_context, reader);
+
+	const uint32_t function_count = reader.get_count();
+	for (uint32_t i = 0; i < function_count && !p_context.has_failed(); i++) {
+		_read_function(p_context, reader, p_script, SLOT_MEMBER);
+	}
+	if (reader.get_u8()) {
+		_read_function(p_context, reader, p_script, SLOT_IMPLICIT_INITIALIZER);
+	}
+	if (reader.get_u8()) {
+		_read_function(p_context, reader, p_script, SLOT_IMPLICIT_READY);
+	}
+	if (reader.get_u8()) {
+		_read_function(p_context, reader, p_script, SLOT_STATIC_INITIALIZER);
+	}
+
+	if (reader.has_failed()) {
+		p_context.fail("Unexpected end of data.");
+	}
+	if (p_context.has_failed()) {
+		return ERR_INVALID_DATA;
+	}
+
+	GDScriptFunction *const *initializer = p_script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+	p_script->initializer = initializer ? *initializer : nullptr;
+
+	p_context.loading.erase(p_script);
+	p_context.loaded.insert(p_script);
+	return OK;
+}
+
+void GDScriptBytecodeCache::_make_scripts(Reader &p_reader, GDScript *p_script, bool p_keep_state, LoadContext *r_context) {
+	p_script->local_name = p_reader.get_name();
+	p_script->global_name = p_reader.get_name();
+	p_script->fully_qualified_name = p_reader.get_string();
+	p_script->simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses;
+	if (p_keep_state) {
+		old_subclasses = p_script->subclasses;
+	}
+	p_script->subclasses.clear();
+
+	if (r_context) {
+		r_context->classes.push_back(p_script);
+	}
+
+	const uint32_t subclass_count = p_reader.get_count();
+	for (uint32_t i = 0; i < subclass_count && !p_reader.has_failed(); i++) {
+		const StringName name = p_reader.get_name();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(p_script->fully_qualified_name + "::" + String(name));
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_make_scripts(p_reader, subclass.ptr(), p_keep_state, r_context);
+	}
+
+	const uint32_t body_size = p_reader.get_u32();
+	if (r_context) {
+		r_context->body_positions[p_script] = p_reader.get_position();
+	}
+	p_reader.skip(body_size);
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_contents, bool p_keep_state) {
+	Reader reader(p_contents);
+	reader.skip(1); // Static data flag.
+	_make_scripts(reader, p_script, p_keep_state, nullptr);
+	return reader.has_failed() ? ERR_FILE_CORRUPT : OK;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const Vector<uint8_t> &p_contents, bool p_keep_state) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	LoadContext context;
+	context.root = p_script;
+	context.source = p_script->get_path();
+	context.contents = &p_contents;
+
+	Reader reader(p_contents);
+	const bool has_static_data = reader.get_u8();
+	_make_scripts(reader, p_script, p_keep_state, &context);
+	if (reader.has_failed()) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	// Only scripts that were never compiled are loaded, hot-reloading is left to the compiler.
+	for (GDScript *script : context.classes) {
+		if (script->valid || !script->member_functions.is_empty() || script->implicit_initializer || script->implicit_ready || script->static_initializer || !script->instances.is_empty()) {
+			return ERR_ALREADY_IN_USE;
+		}
+		script->_invalidate_inline_caches();
+		script->native = Ref<GDScriptNativeClass>();
+		script->base = Ref<GDScript>();
+		script->members.clear();
+		script->member_indices.clear();
+		script->static_variables_indices.clear();
+		script->static_variables.clear();
+		script->constants.clear();
+		script->_signals.clear();
+		script->rpc_config.clear();
+		script->lambda_info.clear();
+	}
+
+	for (GDScript *script : context.classes) {
+		Error err = _load_class(context, script);
+		if (err != OK) {
+			print_verbose(vformat(R"(GDScript: Can't load the bytecode cache of "%s": %s)", p_script->path, context.error));
+			return err;
+		}
+	}
+
+	for (GDScript *script : context.classes) {
+		script->_static_default_init();
+		script->valid = true;
+	}
+
+	if (has_static_data) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+/* Saving */
+
+#ifdef TOOLS_ENABLED
+
+class GDScriptBytecodeCache::Writer {
+	LocalVector<uint8_t> data;
+
+public:
+	const LocalVector<uint8_t> &get_data() const { return data; }
+
+	void put_u8(uint8_t p_value) { data.push_back(p_value); }
+
+	void put_u32(uint32_t p_value) {
+		const uint32_t position = data.size();
+		data.resize(position + 4);
+		encode_uint32(p_value, &data[position]);
+	}
+
+	void put_32(int32_t p_value) { put_u32((uint32_t)p_value); }
+
+	void put_bytes(const uint8_t *p_data, uint32_t p_size) {
+		const uint32_t position = data.size();
+		data.resize(position + p_size);
+		if (p_size > 0) {
+			memcpy(&data[position], p_data, p_size);
+		}
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	Error put_plain_value(const Variant &p_value) {
+		int length = 0;
+		Error err = encode_variant(p_value, nullptr, length, false);
+		if (err != OK) {
+			return err;
+		}
+		const uint32_t position = data.size();
+		data.resize(position + length);
+		return encode_variant(p_value, &data[position], length, false);
+	}
+
+	void put_property_info(const PropertyInfo &p_info) {
+		put_u32(p_info.type);
+		put_string(p_info.name);
+		put_string(p_info.class_name);
+		put_u32(p_info.hint);
+		put_string(p_info.hint_string);
+		put_u32(p_info.usage);
+	}
+};
+
+// Reverse lookups of the native functions that the bytecode points to.
+struct NativeFunctionNames {
+	RBMap<Variant::ValidatedOperatorEvaluator, uint32_t> operators; // Operator and operand types, 8 bits each.
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	template <typename K, typename V>
+	static const V *lookup(const RBMap<K, V> &p_map, K p_key) {
+		const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+		return E ? &E->value() : nullptr;
+	}
+
+	NativeFunctionNames() {
+		for (int type_index = 0; type_index < Variant::VARIANT_MAX; type_index++) {
+			const Variant::Type type = (Variant::Type)type_index;
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int type_b = 0; type_b < Variant::VARIANT_MAX; type_b++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)type_b);
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, op | (type_index << 8) | (type_b << 16));
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				if (Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member)) {
+					setters.insert(setter, Pair<Variant::Type, StringName>(type, member));
+				}
+				if (Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member)) {
+					getters.insert(getter, Pair<Variant::Type, StringName>(type, member));
+				}
+			}
+
+			if (Variant::ValidatedKeyedSetter setter = Variant::get_member_validated_keyed_setter(type)) {
+				keyed_setters.insert(setter, type);
+			}
+			if (Variant::ValidatedKeyedGetter getter = Variant::get_member_validated_keyed_getter(type)) {
+				keyed_getters.insert(getter, type);
+			}
+			if (Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(type)) {
+				indexed_setters.insert(setter, type);
+			}
+			if (Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(type)) {
+				indexed_getters.insert(getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				if (Variant::ValidatedBuiltInMethod function = Variant::get_validated_builtin_method(type, method)) {
+					builtin_methods.insert(function, Pair<Variant::Type, StringName>(type, method));
+				}
+			}
+
+			for (int i = 0; i < Variant::get_constructor_count(type); i++) {
+				if (Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, i)) {
+					constructors.insert(constructor, Pair<Variant::Type, int>(type, i));
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			if (Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(function)) {
+				utilities.insert(utility, function);
+			}
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			if (GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(function)) {
+				gds_utilities.insert(utility, function);
+			}
+		}
+	}
+};
+
+struct GDScriptBytecodeCache::SaveContext {
+	const GDScript *root = nullptr;
+	bool debug = false;
+	const NativeFunctionNames *native_functions = nullptr;
+	GDScriptNativeCode::Writer *native_code = nullptr;
+	HashMap<const Object *, StringName> global_objects;
+	Vector<StringName> global_names; // By index in the global array.
+	String error; // Why the script can't be cached.
+
+	bool fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+		return false;
+	}
+};
+
+bool GDScriptBytecodeCache::_write_script_ref(SaveContext &p_context, Writer &p_writer, const Script *p_script) {
+	if (p_script == nullptr) {
+		p_writer.put_u8(SCRIPT_NONE);
+		return true;
+	}
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript == nullptr) {
+		if (p_script->get_path().is_empty() || p_script->is_built_in()) {
+			return p_context.fail("Refers to a built-in script.");
+		}
+		p_writer.put_u8(SCRIPT_RESOURCE);
+		p_writer.put_string(p_script->get_path());
+		return true;
+	}
+
+	Vector<StringName> class_names;
+	const GDScript *root = gdscript;
+	while (root->_owner) {
+		class_names.push_back(root->local_name);
+		root = root->_owner;
+	}
+	class_names.reverse();
+
+	if (root == p_context.root) {
+		p_writer.put_u8(SCRIPT_LOCAL);
+	} else {
+		if (root->path.is_empty() || root->path.contains("::")) {
+			return p_context.fail("Refers to a built-in script.");
+		}
+		p_writer.put_u8(SCRIPT_GDSCRIPT);
+		p_writer.put_string(root->path);
+	}
+	p_writer.put_u32(class_names.size());
+	for (const StringName &name : class_names) {
+		p_writer.put_string(name);
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_value(SaveContext &p_context, Writer &p_writer, const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			const Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_u8(VALUE_NULL_OBJECT);
+				return true;
+			}
+			if (const Script *script = Object::cast_to<Script>(object)) {
+				p_writer.put_u8(VALUE_SCRIPT);
+				return _write_script_ref(p_context, p_writer, script);
+			}
+			if (const StringName *global = p_context.global_objects.getptr(object)) {
+				p_writer.put_u8(VALUE_GLOBAL);
+				p_writer.put_string(*global);
+				return true;
+			}
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource && !resource->get_path().is_empty() && !resource->is_built_in()) {
+				p_writer.put_u8(VALUE_RESOURCE);
+				p_writer.put_string(resource->get_path());
+				return true;
+			}
+			return p_context.fail(vformat(R"(Can't store a constant of class "%s".)", object->get_class_name()));
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			p_writer.put_u8(VALUE_ARRAY);
+			p_writer.put_u8(array.is_typed());
+			if (array.is_typed()) {
+				p_writer.put_u32(array.get_typed_builtin());
+				p_writer.put_string(array.get_typed_class_name());
+				if (!_write_script_ref(p_context, p_writer, Object::cast_to<Script>(array.get_typed_script()))) {
+					return false;
+				}
+			}
+			p_writer.put_u32(array.size());
+			for (const Variant &element : array) {
+				if (!_write_value(p_context, p_writer, element)) {
+					return false;
+				}
+			}
+			p_writer.put_u8(array.is_read_only());
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			p_writer.put_u8(VALUE_DICTIONARY);
+			p_writer.put_u8(dictionary.is_typed());
+			if (dictionary.is_typed()) {
+				p_writer.put_u32(dictionary.get_typed_key_builtin());
+				p_writer.put_string(dictionary.get_typed_key_class_name());
+				if (!_write_script_ref(p_context, p_writer, Object::cast_to<Script>(dictionary.get_typed_key_script()))) {
+					return false;
+				}
+				p_writer.put_u32(dictionary.get_typed_value_builtin());
+				p_writer.put_string(dictionary.get_typed_value_class_name());
+				if (!_write_script_ref(p_context, p_writer, Object::cast_to<Script>(dictionary.get_typed_value_script()))) {
+					return false;
+				}
+			}
+			p_writer.put_u32(dictionary.size());
+			for (const KeyValue<Variant, Variant> &kv : dictionary) {
+				if (!_write_value(p_context, p_writer, kv.key) || !_write_value(p_context, p_writer, kv.value)) {
+					return false;
+				}
+			}
+			p_writer.put_u8(dictionary.is_read_only());
+			return true;
+		}
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID: {
+			return p_context.fail(vformat(R"(Can't store a constant of type "%s".)", Variant::get_type_name(p_value.get_type())));
+		}
+		default: {
+			p_writer.put_u8(VALUE_PLAIN);
+			if (p_writer.put_plain_value(p_value) != OK) {
+				return p_context.fail("Can't encode a constant.");
+			}
+			return true;
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::_write_data_type(SaveContext &p_context, Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	if (!_write_script_ref(p_context, p_writer, p_type.script_type)) {
+		return false;
+	}
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		if (!_write_data_type(p_context, p_writer, element_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_method_info(SaveContext &p_context, Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	p_writer.put_property_info(p_info.return_val);
+	p_writer.put_u32(p_info.flags);
+	p_writer.put_32(p_info.id);
+	p_writer.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		p_writer.put_property_info(argument);
+	}
+	p_writer.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		if (!_write_value(p_context, p_writer, default_argument)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_info.return_val_metadata);
+	p_writer.put_u32(p_info.arguments_metadata.size());
+	for (int metadata : p_info.arguments_metadata) {
+		p_writer.put_32(metadata);
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_member_info(SaveContext &p_context, Writer &p_writer, const GDScript::MemberInfo &p_info) {
+	p_writer.put_32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	if (!_write_data_type(p_context, p_writer, p_info.data_type)) {
+		return false;
+	}
+	p_writer.put_property_info(p_info.property_info);
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_function(SaveContext &p_context, Writer &p_writer, const GDScriptFunction *p_function) {
+	const NativeFunctionNames &native_functions = *p_context.native_functions;
+
+	p_writer.put_string(p_function->name);
+	const GDScript::LambdaInfo *lambda_info = p_function->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(p_function));
+	uint8_t flags = p_function->_static ? FUNCTION_STATIC : 0;
+	if (lambda_info) {
+		flags |= FUNCTION_LAMBDA | (lambda_info->use_self ? FUNCTION_LAMBDA_USES_SELF : 0);
+	}
+	p_writer.put_u8(flags);
+	p_writer.put_32(lambda_info ? lambda_info->capture_count : 0);
+
+	p_writer.put_32(p_function->_initial_line);
+	p_writer.put_32(p_function->_argument_count);
+	p_writer.put_32(p_function->_vararg_index);
+	p_writer.put_32(p_function->_stack_size);
+	p_writer.put_32(p_function->_instruction_args_size);
+	if (!_write_data_type(p_context, p_writer, p_function->return_type)) {
+		return false;
+	}
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		if (!_write_data_type(p_context, p_writer, argument_type)) {
+			return false;
+		}
+	}
+	if (!_write_method_info(p_context, p_writer, p_function->method_info) || !_write_value(p_context, p_writer, p_function->rpc_config)) {
+		return false;
+	}
+
+	// Replace what is only valid in this process.
+	Vector<int> code = p_function->code;
+	int *code_ptr = code.ptrw();
+	const int code_size = code.size();
+	LocalVector<Pair<int, StringName>> global_relocations;
+
+	for (int position : p_function->operator_cache_positions) {
+		ERR_FAIL_COND_V(position + OPERATOR_CACHE_SIZE > code_size, false);
+		for (int i = 0; i < OPERATOR_CACHE_SIZE; i++) {
+			code_ptr[position + i] = 0;
+		}
+	}
+	for (int position : p_function->inline_cache_positions) {
+		ERR_FAIL_COND_V(position + GDScriptFunction::INLINE_CACHE_SIZE > code_size, false);
+		for (int i = 0; i < GDScriptFunction::INLINE_CACHE_SIZE; i++) {
+			code_ptr[position + i] = 0;
+		}
+	}
+	for (int position : p_function->global_index_positions) {
+		ERR_FAIL_INDEX_V(position, code_size, false);
+		const int index = code_ptr[position];
+		if (index < 0 || index >= p_context.global_names.size()) {
+			return p_context.fail("Uses an unknown global.");
+		}
+		global_relocations.push_back(Pair<int, StringName>(position, p_context.global_names[index]));
+	}
+	for (int position : p_function->named_global_positions) {
+		// Named globals only exist in the editor (e.g. autoloads), exported projects have them in the global array.
+		ERR_FAIL_COND_V(position + 2 >= code_size, false);
+		const int name_index = code_ptr[position + 2];
+		ERR_FAIL_INDEX_V(name_index, p_function->global_names.size(), false);
+		code_ptr[position] = GDScriptFunction::OPCODE_STORE_GLOBAL;
+		code_ptr[position + 2] = 0;
+		global_relocations.push_back(Pair<int, StringName>(position + 2, p_function->global_names[name_index]));
+	}
+	if (!p_context.debug) {
+		// Release builds don't compile asserts at all, including their conditions.
+		for (const Pair<int, int> &range : p_function->assert_ranges) {
+			ERR_FAIL_COND_V(range.first + 1 >= code_size || range.second > code_size, false);
+			code_ptr[range.first] = GDScriptFunction::OPCODE_JUMP;
+			code_ptr[range.first + 1] = range.second;
+		}
+	}
+	if (p_context.native_code && !lambda_info) {
+		// Translated from the code as it's stored, which is what `_read_function()` looks it up with.
+		p_context.native_code->add_function(p_function, p_function->_script->fully_qualified_name, code);
+	}
+
+	p_writer.put_u32(code_size);
+	for (int i = 0; i < code_size; i++) {
+		p_writer.put_32(code_ptr[i]);
+	}
+	p_writer.put_u32(global_relocations.size());
+	for (const Pair<int, StringName> &relocation : global_relocations) {
+		p_writer.put_u32(relocation.first);
+		p_writer.put_string(relocation.second);
+	}
+
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (int position : p_function->default_arguments) {
+		p_writer.put_32(position);
+	}
+
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &slot : p_function->temporary_slots) {
+		p_writer.put_32(slot.key);
+		p_writer.put_u32(slot.value);
+	}
+
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_write_value(p_context, p_writer, constant)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &name : p_function->global_names) {
+		p_writer.put_string(name);
+	}
+
+	// Native functions, stored by name.
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const uint32_t *key = NativeFunctionNames::lookup(native_functions.operators, evaluator);
+		if (key == nullptr) {
+			return p_context.fail("Uses an unknown operator.");
+		}
+		p_writer.put_u32(*key);
+	}
+
+#define WRITE_MEMBER_FUNCTIONS(m_functions)                                                      \
+	p_writer.put_u32(p_function->m_functions.size());                                            \
+	for (const auto &function : p_function->m_functions) {                                       \
+		const Pair<Variant::Type, StringName> *member = NativeFunctionNames::lookup(native_functions.m_functions, function); \
+		if (member == nullptr) {                                                                 \
+			return p_context.fail("Uses an unknown builtin member.");                            \
+		}                                                                                        \
+		p_writer.put_u32(member->first);                                                         \
+		p_writer.put_string(member->second);                                                     \
+	}
+
+#define WRITE_TYPE_FUNCTIONS(m_functions)                                              \
+	p_writer.put_u32(p_function->m_functions.size());                                  \
+	for (const auto &function : p_function->m_functions) {                             \
+		const Variant::Type *type = NativeFunctionNames::lookup(native_functions.m_functions, function);     \
+		if (type == nullptr) {                                                         \
+			return p_context.fail("Uses an unknown keyed or indexed member.");         \
+		}                                                                              \
+		p_writer.put_u32(*type);                                                       \
+	}
+
+	WRITE_MEMBER_FUNCTIONS(setters);
+	WRITE_MEMBER_FUNCTIONS(getters);
+	WRITE_TYPE_FUNCTIONS(keyed_setters);
+	WRITE_TYPE_FUNCTIONS(keyed_getters);
+	WRITE_TYPE_FUNCTIONS(indexed_setters);
+	WRITE_TYPE_FUNCTIONS(indexed_getters);
+	WRITE_MEMBER_FUNCTIONS(builtin_methods);
+
+#undef WRITE_MEMBER_FUNCTIONS
+#undef WRITE_TYPE_FUNCTIONS
+
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const Pair<Variant::Type, int> *key = NativeFunctionNames::lookup(native_functions.constructors, constructor);
+		if (key == nullptr) {
+			return p_context.fail("Uses an unknown constructor.");
+		}
+		p_writer.put_u32(key->first);
+		p_writer.put_32(key->second);
+	}
+
+	p_writer.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *name = NativeFunctionNames::lookup(native_functions.utilities, utility);
+		if (name == nullptr) {
+			return p_context.fail("Uses an unknown utility function.");
+		}
+		p_writer.put_string(*name);
+	}
+
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		const StringName *name = NativeFunctionNames::lookup(native_functions.gds_utilities, utility);
+		if (name == nullptr) {
+			return p_context.fail("Uses an unknown utility function.");
+		}
+		p_writer.put_string(*name);
+	}
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+		p_writer.put_u32(method->get_hash());
+	}
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		if (!_write_function(p_context, p_writer, lambda)) {
+			return false;
+		}
+	}
+
+	// Only debug builds use the names of local variables.
+	p_writer.put_u32(p_context.debug ? p_function->stack_debug.size() : 0);
+	if (p_context.debug) {
+		for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+			p_writer.put_32(stack_debug.line);
+			p_writer.put_32(stack_debug.pos);
+			p_writer.put_u8(stack_debug.added);
+			p_writer.put_string(stack_debug.identifier);
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_class(SaveContext &p_context, Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		if (!_write_class(p_context, p_writer, E.value.ptr())) {
+			return false;
+		}
+	}
+
+	// The body can be skipped when only making the inner classes.
+	Writer body;
+	body.put_u8(p_script->tool);
+	body.put_u8(p_script->_is_abstract);
+	if (p_script->native.is_null()) {
+		return p_context.fail("Has no native base class.");
+	}
+	body.put_string(p_script->native->get_name());
+	if (!_write_script_ref(p_context, body, p_script->base.ptr())) {
+		return false;
+	}
+	body.put_u32(p_script->base.is_valid() ? p_script->base->member_indices.size() : 0);
+
+	// Sorted by index, so they are inserted in the same order as when compiling.
+	LocalVector<Pair<int, StringName>> members;
+	for (const StringName &name : p_script->members) {
+		members.push_back(Pair<int, StringName>(p_script->member_indices[name].index, name));
+	}
+	members.sort_custom<PairSort<int, StringName>>();
+	body.put_u32(members.size());
+	for (const Pair<int, StringName> &member : members) {
+		body.put_string(member.second);
+		if (!_write_member_info(p_context, body, p_script->member_indices[member.second])) {
+			return false;
+		}
+	}
+
+	body.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		body.put_string(E.key);
+		if (!_write_member_info(p_context, body, E.value)) {
+			return false;
+		}
+	}
+
+	body.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		body.put_string(E.key);
+		if (!_write_value(p_context, body, E.value)) {
+			return false;
+		}
+	}
+
+	body.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		body.put_string(E.key);
+		if (!_write_method_info(p_context, body, E.value)) {
+			return false;
+		}
+	}
+
+	if (!_write_value(p_context, body, p_script->rpc_config)) {
+		return false;
+	}
+
+	body.put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		if (!_write_function(p_context, body, E.value)) {
+			return false;
+		}
+	}
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : special_functions) {
+		body.put_u8(function != nullptr);
+		if (function && !_write_function(p_context, body, function)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(body.get_data().size());
+	p_writer.put_bytes(body.get_data().ptr(), body.get_data().size());
+	return true;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug, GDScriptTokenizerBuffer::CompressMode p_compress_mode, GDScriptNativeCode::Writer *r_native_code) {
+	ERR_FAIL_COND_V(p_script.is_null() || !p_script->is_root_script(), Vector<uint8_t>());
+	if (!p_script->is_valid()) {
+		return Vector<uint8_t>();
+	}
+
+	static const NativeFunctionNames native_functions;
+
+	SaveContext context;
+	context.root = p_script.ptr();
+	context.debug = p_debug;
+	context.native_functions = &native_functions;
+	context.native_code = r_native_code;
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	context.global_names.resize(language->get_global_array_size());
+	for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+		context.global_names.write[E.value] = E.key;
+		const Variant &global = language->get_global_array()[E.value];
+		if (global.get_type() == Variant::OBJECT && global.get_validated_object()) {
+			context.global_objects[global.get_validated_object()] = E.key;
+		}
+	}
+
+	bool has_static_data;
+	{
+		MutexLock lock(GDScriptCache::singleton->mutex);
+		has_static_data = GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name);
+	}
+
+	Writer writer;
+	writer.put_u8(has_static_data);
+	if (!_write_class(context, writer, p_script.ptr())) {
+		print_verbose(vformat(R"(GDScript: Can't make a bytecode cache for "%s": %s)", p_script->path, context.error));
+		return Vector<uint8_t>();
+	}
+	const LocalVector<uint8_t> &contents = writer.get_data();
+
+	Vector<uint8_t> buf;
+	buf.resize(HEADER_SIZE);
+	buf.write[0] = 'G';
+	buf.write[1] = 'D';
+	buf.write[2] = 'B';
+	buf.write[3] = 'C';
+	encode_uint32(FORMAT_VERSION, &buf.write[4]);
+	encode_uint32(_get_build_hash(), &buf.write[8]);
+	encode_uint32(p_debug ? FLAG_DEBUG : 0, &buf.write[12]);
+	encode_uint32(hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size()), &buf.write[16]);
+
+	switch (p_compress_mode) {
+		case GDScriptTokenizerBuffer::COMPRESS_NONE: {
+			encode_uint32(0u, &buf.write[20]);
+			buf.resize(HEADER_SIZE + contents.size());
+			memcpy(&buf.write[HEADER_SIZE], contents.ptr(), contents.size());
+		} break;
+
+		case GDScriptTokenizerBuffer::COMPRESS_ZSTD: {
+			encode_uint32(contents.size(), &buf.write[20]);
+			const int64_t max_size = Compression::get_max_compressed_buffer_size(contents.size(), Compression::MODE_ZSTD);
+			buf.resize(HEADER_SIZE + max_size);
+			const int64_t compressed_size = Compression::compress(&buf.write[HEADER_SIZE], contents.ptr(), contents.size(), Compression::MODE_ZSTD);
+			ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "Error compressing GDScript bytecode cache.");
+			buf.resize(HEADER_SIZE + compressed_size);
+		} break;
+	}
+
+	return buf;
+}
+
+#endif // TOOLS_ENABLED
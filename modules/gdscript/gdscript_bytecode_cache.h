@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript.h"
+#include "gdscript_native_code.h"
+#include "gdscript_tokenizer_buffer.h"
+
+// Compiled bytecode of a script, stored next to its binary tokens in exported projects, so the
+// scripts can be loaded without running the parser, analyzer and compiler on every start.
+//
+// The cache is made from the scripts compiled by the editor. The parts of their code that are
+// only valid in the current process (pointers to native functions, indices into the global array)
+// are stored by name, and resolved again when loading.
+// A cache is only used when it was made by the same engine build, for the same kind of build
+// (debug or release), and from the same binary tokens. Otherwise, or if anything it refers to
+// can't be found, the binary tokens are compiled as usual.
+class GDScriptBytecodeCache {
+	class Reader;
+	struct LoadContext;
+
+	static Ref<Script> _read_script_ref(LoadContext &p_context, Reader &p_reader, bool *r_local = nullptr);
+	static Variant _read_value(LoadContext &p_context, Reader &p_reader);
+	static GDScriptDataType _read_data_type(LoadContext &p_context, Reader &p_reader);
+	static MethodInfo _read_method_info(LoadContext &p_context, Reader &p_reader);
+	static GDScript::MemberInfo _read_member_info(LoadContext &p_context, Reader &p_reader);
+	static bool _read_function(LoadContext &p_context, Reader &p_reader, GDScript *p_script, int p_slot, GDScriptFunction *p_parent = nullptr);
+	static void _finish_function(GDScriptFunction *p_function, bool p_lambda);
+	static Error _load_class(LoadContext &p_context, GDScript *p_script);
+	static void _make_scripts(Reader &p_reader, GDScript *p_script, bool p_keep_state, LoadContext *r_context);
+
+#ifdef TOOLS_ENABLED
+	class Writer;
+	struct SaveContext;
+
+	static bool _write_script_ref(SaveContext &p_context, Writer &p_writer, const Script *p_script);
+	static bool _write_value(SaveContext &p_context, Writer &p_writer, const Variant &p_value);
+	static bool _write_data_type(SaveContext &p_context, Writer &p_writer, const GDScriptDataType &p_type);
+	static bool _write_method_info(SaveContext &p_context, Writer &p_writer, const MethodInfo &p_info);
+	static bool _write_member_info(SaveContext &p_context, Writer &p_writer, const GDScript::MemberInfo &p_info);
+	static bool _write_function(SaveContext &p_context, Writer &p_writer, const GDScriptFunction *p_function);
+	static bool _write_class(SaveContext &p_context, Writer &p_writer, const GDScript *p_script);
+#endif
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 6;
+
+	static String get_cache_path(const String &p_binary_tokens_path);
+
+#ifdef TOOLS_ENABLED
+	// Returns an empty buffer if the script can't be cached.
+	// Release caches (`p_debug == false`) leave out asserts, like release builds do when compiling.
+	// The functions that can be translated to C++ are added to `r_native_code`, if given.
+	static Vector<uint8_t> save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug, GDScriptTokenizerBuffer::CompressMode p_compress_mode, GDScriptNativeCode::Writer *r_native_code = nullptr);
+#endif
+
+	// Checks that the cache can be used by this build with the given binary tokens.
+	// Returns its contents, or an empty buffer if it can't be used.
+	static Vector<uint8_t> open(const Vector<uint8_t> &p_cache, const Vector<uint8_t> &p_binary_tokens);
+
+	// Creates the inner classes of the script, like `GDScriptCompiler::make_scripts()` does.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_contents, bool p_keep_state);
+	// Loads the script in place of compiling it. Fails if the script was already compiled.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_contents, bool p_keep_state);
+};
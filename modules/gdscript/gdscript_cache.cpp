@@ -32,10 +32,12 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -242,7 +244,7 @@ bool GDScriptCache::has_parser(const String &p_path) {
 	return singleton->parser_map.has(p_path);
 }
 
-void GDScriptCache::remove_parser(const String &p_path) {
+void GDScriptCache::remove_parser(const String &p_path, bool p_dependents) {
 	MutexLock lock(singleton->mutex);
 
 	if (singleton->parser_map.has(p_path)) {
@@ -253,7 +255,17 @@ void GDScriptCache::remove_parser(const String &p_path) {
 
 	// Can't clear the parser because some other parser might be currently using it in the chain of calls.
 	singleton->parser_map.erase(p_path);
+	singleton->preparsed_parsers.erase(p_path);
 
+	if (p_dependents) {
+		remove_dependent_parsers(p_path);
+	}
+}
+
+void GDScriptCache::remove_dependent_parsers(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+
+	// Until they're removed, the dependent parsers keep using (and keep alive) the parser they were analyzed with.
 	// Have to copy while iterating, because parser_inverse_dependencies is modified.
 	HashSet<String> ideps = singleton->parser_inverse_dependencies[p_path];
 	singleton->parser_inverse_dependencies.erase(p_path);
@@ -262,6 +274,76 @@ void GDScriptCache::remove_parser(const String &p_path) {
 	}
 }
 
+void GDScriptCache::_parse_script(uint32_t p_index, Ref<GDScriptParserRef> *p_parsers) {
+	p_parsers[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+void GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	if (singleton == nullptr || p_paths.is_empty()) {
+		return;
+	}
+
+	OS::get_singleton()->benchmark_begin_measure("GDScript", "Parse Scripts");
+
+	LocalVector<Ref<GDScriptParserRef>> parsers;
+	{
+		MutexLock lock(singleton->mutex);
+
+		for (const String &path : p_paths) {
+			if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path) || singleton->shallow_gdscript_cache.has(path)) {
+				continue;
+			}
+			const String remapped_path = ResourceLoader::path_remap(path);
+			if (!FileAccess::exists(remapped_path)) {
+				continue;
+			}
+			if (remapped_path.has_extension("gdc") && FileAccess::exists(GDScriptBytecodeCache::get_cache_path(remapped_path))) {
+				continue;
+			}
+
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->path = path;
+			// Not in `parser_map` until it's parsed, so other threads loading scripts can't use it meanwhile.
+			ref->abandoned = true;
+			// Creating the first parser registers the annotations, which has to happen on a single thread.
+			ref->get_parser();
+			parsers.push_back(ref);
+		}
+	}
+
+	if (!parsers.is_empty()) {
+		// Same for the built-in types, which are registered the first time they're looked up.
+		GDScriptParser::get_builtin_type(StringName());
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(singleton, &GDScriptCache::_parse_script, parsers.ptr(), parsers.size(), -1, true, SNAME("GDScriptParsing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		MutexLock lock(singleton->mutex);
+
+		for (Ref<GDScriptParserRef> &ref : parsers) {
+			if (singleton->cleared || singleton->parser_map.has(ref->path)) {
+				continue; // Parsed by another thread meanwhile, this one is freed when going out of scope.
+			}
+			ref->abandoned = false;
+			singleton->parser_map[ref->path] = ref.ptr();
+			singleton->preparsed_parsers[ref->path] = ref;
+		}
+	}
+
+	print_verbose(vformat("GDScript: Parsed %d scripts in parallel.", parsers.size()));
+	OS::get_singleton()->benchmark_end_measure("GDScript", "Parse Scripts");
+}
+
+void GDScriptCache::release_preparsed_parsers() {
+	if (singleton == nullptr) {
+		return;
+	}
+
+	MutexLock lock(singleton->mutex);
+	singleton->preparsed_parsers.clear();
+}
+
 String GDScriptCache::get_source_code(const String &p_path) {
 	Vector<uint8_t> source_file;
 	Error err;
@@ -295,6 +377,14 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	return buffer;
 }
 
+Vector<uint8_t> GDScriptCache::get_bytecode_cache(const String &p_binary_tokens_path, const Vector<uint8_t> &p_binary_tokens) {
+	const String cache_path = GDScriptBytecodeCache::get_cache_path(p_binary_tokens_path);
+	if (!FileAccess::exists(cache_path)) {
+		return Vector<uint8_t>();
+	}
+	return GDScriptBytecodeCache::open(FileAccess::get_file_as_bytes(cache_path), p_binary_tokens);
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -320,6 +410,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+		script->set_bytecode_cache(get_bytecode_cache(remapped_path, buffer));
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -328,9 +419,13 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// The inner classes can be made from the bytecode cache too, which avoids parsing the script at all.
+	if (script->get_bytecode_cache().is_empty() || GDScriptBytecodeCache::make_scripts(script.ptr(), script->get_bytecode_cache(), true) != OK) {
+		script->set_bytecode_cache(Vector<uint8_t>());
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -372,6 +467,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 				return script;
 			}
 			script->set_binary_tokens_source(buffer);
+			script->set_bytecode_cache(get_bytecode_cache(remapped_path, buffer));
 		} else {
 			r_error = script->load_source_code(remapped_path);
 			if (r_error) {
@@ -482,6 +578,7 @@ void GDScriptCache::clear() {
 	}
 
 	singleton->parser_map.clear();
+	singleton->preparsed_parsers.clear();
 
 	for (Ref<GDScriptParserRef> &E : parser_map_refs) {
 		if (E.is_valid()) {
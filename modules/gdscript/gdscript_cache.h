@@ -93,10 +93,13 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	// Parsed ahead of time by `parse_scripts()`, kept alive until the first frame.
+	HashMap<String, Ref<GDScriptParserRef>> preparsed_parsers;
 
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
+	friend class GDScriptBytecodeCache;
 #ifdef TESTS_ENABLED
 	friend class GDScriptTests::TestGDScriptCacheAccessor;
 #endif // TESTS_ENABLED
@@ -112,14 +115,24 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	void _parse_script(uint32_t p_index, Ref<GDScriptParserRef> *p_parsers);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static bool has_parser(const String &p_path);
-	static void remove_parser(const String &p_path);
+	// Also removes the parsers of the scripts depending on this one, unless `p_dependents` is false.
+	static void remove_parser(const String &p_path, bool p_dependents = true);
+	static void remove_dependent_parsers(const String &p_path);
+	// Parses the scripts at the same time on the WorkerThreadPool, so loading them later only has to analyze them.
+	// Scripts that are already parsed or loaded, or that can be loaded from the bytecode cache, are skipped.
+	static void parse_scripts(const Vector<String> &p_paths);
+	static void release_preparsed_parsers();
 	static String get_source_code(const String &p_path);
 	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	// Returns the usable contents of the bytecode cache exported with these binary tokens, if any.
+	static Vector<uint8_t> get_bytecode_cache(const String &p_binary_tokens_path, const Vector<uint8_t> &p_binary_tokens);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	/**
 	 * Returns a fully loaded GDScript using an already cached script if one exists.
@@ -2182,6 +2182,7 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 #ifdef DEBUG_ENABLED
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
 
+				gen->start_assert();
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, as->condition);
 				if (err) {
 					return err;
@@ -2703,6 +2704,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 	parsing_classes.insert(p_script);
 
 	p_script->clearing = true;
+	p_script->_invalidate_inline_caches();
 
 	p_script->cancel_pending_functions(true);
 
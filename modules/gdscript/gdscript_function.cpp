@@ -32,6 +32,95 @@
 
 #include "gdscript.h"
 
+#include "core/os/spin_lock.h"
+
+Mutex GDScriptFunction::inline_caches_mutex;
+
+// 256 bytes (a function with about 10 local variables) to 32 KiB. Bigger frames aren't pooled.
+static constexpr uint32_t AWAIT_FRAME_MIN_SIZE = 256;
+static constexpr int AWAIT_FRAME_SIZE_CLASSES = 8;
+// Enough for thousands of coroutines awaiting at once, without keeping too much memory around after them.
+static constexpr uint32_t AWAIT_FRAME_MAX_POOLED = 4096;
+
+struct AwaitFramePool {
+	SpinLock spin_lock;
+	uint8_t *first_free = nullptr; // Free frames are linked through their first bytes.
+	uint32_t free_count = 0;
+	bool closed = false; // Coroutines can outlive the language, their frames are then freed directly.
+};
+
+static AwaitFramePool await_frame_pools[AWAIT_FRAME_SIZE_CLASSES];
+
+uint8_t *GDScriptFunction::alloc_await_frame(uint32_t p_size, uint32_t &r_capacity) {
+	int size_class = 0;
+	uint32_t capacity = AWAIT_FRAME_MIN_SIZE;
+	while (capacity < p_size && size_class < AWAIT_FRAME_SIZE_CLASSES) {
+		capacity <<= 1;
+		size_class++;
+	}
+
+	if (size_class >= AWAIT_FRAME_SIZE_CLASSES) {
+		r_capacity = p_size;
+		return (uint8_t *)Memory::alloc_static(p_size);
+	}
+
+	r_capacity = capacity;
+	AwaitFramePool &pool = await_frame_pools[size_class];
+	pool.spin_lock.lock();
+	uint8_t *frame = pool.first_free;
+	if (frame) {
+		pool.first_free = *(uint8_t **)frame;
+		pool.free_count--;
+	}
+	pool.spin_lock.unlock();
+
+	return frame ? frame : (uint8_t *)Memory::alloc_static(capacity);
+}
+
+void GDScriptFunction::free_await_frame(uint8_t *p_frame, uint32_t p_capacity) {
+	if (p_frame == nullptr) {
+		return;
+	}
+
+	int size_class = 0;
+	while ((AWAIT_FRAME_MIN_SIZE << size_class) < p_capacity) {
+		size_class++;
+	}
+
+	if (size_class < AWAIT_FRAME_SIZE_CLASSES && (AWAIT_FRAME_MIN_SIZE << size_class) == p_capacity) {
+		AwaitFramePool &pool = await_frame_pools[size_class];
+		pool.spin_lock.lock();
+		if (!pool.closed && pool.free_count < AWAIT_FRAME_MAX_POOLED) {
+			*(uint8_t **)p_frame = pool.first_free;
+			pool.first_free = p_frame;
+			pool.free_count++;
+			p_frame = nullptr;
+		}
+		pool.spin_lock.unlock();
+	}
+
+	if (p_frame) {
+		Memory::free_static(p_frame);
+	}
+}
+
+void GDScriptFunction::clear_await_frame_pool() {
+	for (AwaitFramePool &pool : await_frame_pools) {
+		pool.spin_lock.lock();
+		uint8_t *frame = pool.first_free;
+		pool.first_free = nullptr;
+		pool.free_count = 0;
+		pool.closed = true;
+		pool.spin_lock.unlock();
+
+		while (frame) {
+			uint8_t *next = *(uint8_t **)frame;
+			Memory::free_static(frame);
+			frame = next;
+		}
+	}
+}
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -117,6 +206,10 @@ GDScriptFunction::GDScriptFunction() {
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
 
+	for (InlineCache *inline_cache : inline_caches) {
+		memdelete(inline_cache);
+	}
+
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
@@ -240,7 +333,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// First `GDScriptFunction::FIXED_ADDRESSES_MAX` stack addresses are special
 		// and not copied to the state, so we skip them here.
 		for (int i = GDScriptFunction::FIXED_ADDRESSES_MAX; i < state.stack_size; i++) {
@@ -248,6 +341,9 @@ void GDScriptFunctionState::_clear_stack() {
 		}
 		state.stack_size = 0;
 	}
+	GDScriptFunction::free_await_frame(state.stack, state.stack_capacity);
+	state.stack = nullptr;
+	state.stack_capacity = 0;
 }
 
 void GDScriptFunctionState::_clear_connections() {
@@ -278,4 +374,5 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	GDScriptFunction::free_await_frame(state.stack, state.stack_capacity);
 }
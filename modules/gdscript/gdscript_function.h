@@ -34,9 +34,12 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
@@ -265,6 +268,30 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
+		OPCODE_JUMP_IF_NOT_INT_EQUAL,
+		OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL,
+		OPCODE_JUMP_IF_NOT_INT_LESS,
+		OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL,
+		OPCODE_JUMP_IF_NOT_INT_GREATER,
+		OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_NOT_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_LESS,
+		OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL,
+		OPCODE_JUMP_IF_NOT_FLOAT_GREATER,
+		OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -450,11 +477,44 @@ public:
 		StringName identifier;
 	};
 
+	// Made for `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED` and `OPCODE_CALL` (and its variants), to remember what the name
+	// resolved to for the kind of object the instruction was last run with. The instruction is followed by a pointer
+	// to it, which is only ever replaced by a pointer to a new one, so other threads can keep reading the previous one.
+	// The replaced ones are freed along with the function.
+	struct InlineCache {
+		enum Kind {
+			KIND_MEMBER, // `target` is a `GDScript::MemberInfo` without setter or getter.
+			KIND_FUNCTION, // `target` is a `GDScriptFunction` of the script or one of its bases.
+			KIND_METHOD_BIND, // `target` is a `MethodBind` of the native class.
+		};
+
+		Kind kind = KIND_MEMBER;
+		const GDScript *script = nullptr; // Script of the object, if any.
+		uint64_t script_version = 0; // Only valid while equal to `GDScript::get_inline_cache_version()`.
+		const void *native_class = nullptr; // Unique pointer of the object's class name, for `KIND_METHOD_BIND`.
+		void *target = nullptr;
+	};
+	// Enough room for a pointer, wherever the instruction ends.
+	static constexpr int INLINE_CACHE_SIZE = (sizeof(void *) + alignof(void *) - sizeof(int)) / sizeof(int);
+
+	// The stacks of the functions suspended by `await` are kept in frames reused by size class,
+	// so scripts that await every frame don't allocate a new one each time.
+	static uint8_t *alloc_await_frame(uint32_t p_size, uint32_t &r_capacity);
+	static void free_await_frame(uint8_t *p_frame, uint32_t p_capacity);
+	// Frees the pooled frames. The frames released afterwards, by function states still alive, aren't pooled anymore.
+	static void clear_await_frame_pool();
+
+	// C++ translation of the function, run in place of its bytecode, on the same stack. See `GDScriptNativeCode`.
+	// The members are the ones of the instance, or null for static functions.
+	typedef void (*NativeCode)(const GDScriptFunction *p_function, Variant *p_stack, const Variant *p_constants, Variant *p_members, Variant &r_return);
+
 private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
+	friend class GDScriptNativeCode;
 
 	StringName name;
 	StringName source;
@@ -513,6 +573,7 @@ private:
 	int _lambdas_count = 0;
 
 	int *_code_ptr = nullptr;
+	NativeCode native_code = nullptr;
 	const int *_default_arg_ptr = nullptr;
 	mutable Variant *_constants_ptr = nullptr;
 	const StringName *_global_names_ptr = nullptr;
@@ -530,6 +591,15 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+#ifdef TOOLS_ENABLED
+	// Code that is only valid in the current process, recorded so the bytecode cache can relocate it.
+	Vector<int> global_index_positions; // Indices into the global array.
+	Vector<int> named_global_positions; // `OPCODE_STORE_NAMED_GLOBAL`, only used by the editor.
+	Vector<int> operator_cache_positions; // Caches filled by `OPCODE_OPERATOR` when first run.
+	Vector<int> inline_cache_positions; // See `InlineCache`.
+	Vector<Pair<int, int>> assert_ranges; // From the condition to the end of the assert.
+#endif
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -567,6 +637,15 @@ private:
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	static Mutex inline_caches_mutex;
+	LocalVector<InlineCache *> inline_caches; // All the ones made for this function, see `InlineCache`.
+
+	static bool _get_inline_cache_instance(Object *p_object, GDScriptInstance *&r_instance);
+	void _set_inline_cache(int *p_cache, const InlineCache &p_value);
+	Variant _get_named_cached(int *p_cache, const Variant *p_base, const StringName &p_name, bool &r_valid);
+	void _set_named_cached(int *p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	void _call_cached(int *p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -578,7 +657,8 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // From `alloc_await_frame()`, moved to the next state when awaiting again.
+		uint32_t stack_capacity = 0;
 		int stack_size = 0;
 		int ip = 0;
 		int line = 0;
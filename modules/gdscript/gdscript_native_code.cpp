@@ -0,0 +1,538 @@
+/**************************************************************************/
+/*  gdscript_native_code.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_code.h"
+
+#include "gdscript.h"
+
+#include "core/templates/hash_set.h"
+
+HashMap<uint64_t, GDScriptNativeCode::Entry> GDScriptNativeCode::functions;
+
+uint64_t GDScriptNativeCode::get_key(const String &p_class, const StringName &p_name, const int *p_code, int p_code_size) {
+	const uint32_t seed = hash_murmur3_one_32(p_name.hash(), p_class.hash());
+	const uint32_t low = hash_murmur3_buffer(p_code, p_code_size * sizeof(int), seed);
+	const uint32_t high = hash_djb2_buffer((const uint8_t *)p_code, p_code_size * sizeof(int), seed);
+	return (uint64_t(high) << 32) | low;
+}
+
+void GDScriptNativeCode::register_function(uint64_t p_key, int p_stack_size, GDScriptFunction::NativeCode p_function) {
+	functions[p_key] = { p_stack_size, p_function };
+}
+
+GDScriptFunction::NativeCode GDScriptNativeCode::get_function(uint64_t p_key, int p_stack_size) {
+	const Entry *entry = functions.getptr(p_key);
+	return entry && entry->stack_size == p_stack_size ? entry->function : nullptr;
+}
+
+void GDScriptNativeCode::convert(const Variant &p_value, Variant::Type p_type, Variant &r_ret) {
+	// Like `OPCODE_RETURN_TYPED_BUILTIN`, constructs a default value when the type can't be converted.
+	Callable::CallError ce;
+	if (Variant::can_convert_strict(p_value.get_type(), p_type)) {
+		const Variant *arg = &p_value;
+		Variant::construct(p_type, r_ret, &arg, 1, ce);
+	} else {
+		Variant::construct(p_type, r_ret, nullptr, 0, ce);
+	}
+}
+
+Object *GDScriptNativeCode::get_call_base(const Variant &p_base, const GDScriptFunction *p_function, int p_method) {
+	const MethodBind *method = p_function->_methods_ptr[p_method];
+#ifdef DEBUG_ENABLED
+	bool freed = false;
+	Object *object = p_base.get_validated_object_with_check(freed);
+	if (unlikely(freed)) {
+		ERR_PRINT("Cannot call method '" + method->get_name() + "' on a previously freed instance.");
+		return nullptr;
+	}
+#else
+	Object *object = p_base.get_validated_object();
+#endif
+	if (unlikely(!object)) {
+		ERR_PRINT("Cannot call method '" + method->get_name() + "' on a null value.");
+	}
+	return object;
+}
+
+#ifdef TOOLS_ENABLED
+
+namespace {
+
+struct TypedOperator {
+	GDScriptFunction::Opcode opcode;
+	const char *type;
+	const char *get;
+	const char *op;
+	const char *get_right = nullptr; // When the right operand has another type.
+};
+
+const TypedOperator typed_operators[] = {
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_INT, "INT", "get_int", "+" },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT, "INT", "get_int", "-" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT, "INT", "get_int", "*" },
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT, "FLOAT", "get_float", "+" },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT, "FLOAT", "get_float", "-" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT, "FLOAT", "get_float", "*" },
+	{ GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT, "FLOAT", "get_float", "/" },
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3, "VECTOR3", "get_vector3", "+" },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3, "VECTOR3", "get_vector3", "-" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT, "VECTOR3", "get_vector3", "*", "get_float" },
+};
+
+const TypedOperator typed_jumps[] = {
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_EQUAL, "INT", "get_int", "==" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL, "INT", "get_int", "!=" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_LESS, "INT", "get_int", "<" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL, "INT", "get_int", "<=" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_GREATER, "INT", "get_int", ">" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL, "INT", "get_int", ">=" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_EQUAL, "FLOAT", "get_float", "==" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_NOT_EQUAL, "FLOAT", "get_float", "!=" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_LESS, "FLOAT", "get_float", "<" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL, "FLOAT", "get_float", "<=" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER, "FLOAT", "get_float", ">" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL, "FLOAT", "get_float", ">=" },
+};
+
+// Only the types that can't hold references, the others keep running on the VM.
+const struct {
+	GDScriptFunction::Opcode opcode;
+	const char *type;
+} type_adjusts[] = {
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL, "bool" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_INT, "int64_t" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT, "double" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2, "Vector2" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2I, "Vector2i" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3, "Vector3" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3I, "Vector3i" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR4, "Vector4" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR4I, "Vector4i" },
+	{ GDScriptFunction::OPCODE_TYPE_ADJUST_COLOR, "Color" },
+};
+
+// Arguments of the calls, in the array the validated calls take.
+String _get_arguments(const LocalVector<String> &p_arguments) {
+	if (p_arguments.is_empty()) {
+		return "const Variant **args = nullptr;";
+	}
+	String arguments;
+	for (const String &argument : p_arguments) {
+		arguments += (arguments.is_empty() ? "&" : ", &") + argument;
+	}
+	return vformat("const Variant *args[] = { %s };", arguments);
+}
+
+} // namespace
+
+String GDScriptNativeCode::Writer::_get_address(const GDScriptFunction *p_function, int p_address, bool p_writable) {
+	const int index = p_address & GDScriptFunction::ADDR_MASK;
+	switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+		case GDScriptFunction::ADDR_TYPE_STACK:
+			// `self` and the class can be read, like any other value on the stack.
+			if (index < GDScriptFunction::FIXED_ADDRESSES_MAX && index != GDScriptFunction::ADDR_STACK_NIL && p_writable) {
+				return String();
+			}
+			return index < p_function->_stack_size ? vformat("stack[%d]", index) : String();
+		case GDScriptFunction::ADDR_TYPE_CONSTANT:
+			return !p_writable && index < p_function->constants.size() ? vformat("constants[%d]", index) : String();
+		case GDScriptFunction::ADDR_TYPE_MEMBER:
+			// Static functions don't have an instance.
+			return !p_function->is_static() && p_function->_script && (uint32_t)index < p_function->_script->debug_get_member_indices().size() ? vformat("members[%d]", index) : String();
+		default:
+			return String();
+	}
+}
+
+bool GDScriptNativeCode::Writer::_get_operator(Variant::ValidatedOperatorEvaluator p_evaluator, String &r_name) {
+	// Evaluators are found again by operator and types when registering, since their addresses change between builds.
+	static HashMap<uint64_t, uint32_t> evaluator_types;
+	if (evaluator_types.is_empty()) {
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int a = 0; a < Variant::VARIANT_MAX; a++) {
+				for (int b = 0; b < Variant::VARIANT_MAX; b++) {
+					const Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(a), Variant::Type(b));
+					if (evaluator) {
+						evaluator_types.insert((uint64_t)(uintptr_t)evaluator, (op << 16) | (a << 8) | b);
+					}
+				}
+			}
+		}
+	}
+
+	const uint64_t address = (uint64_t)(uintptr_t)p_evaluator;
+	const uint32_t *types = evaluator_types.getptr(address);
+	if (types == nullptr) {
+		return false;
+	}
+
+	const int *index = operator_indices.getptr(address);
+	if (index == nullptr) {
+		index = &operator_indices.insert(address, operators.size())->value;
+		operators.push_back(vformat("Variant::Operator(%d), Variant::Type(%d), Variant::Type(%d)", *types >> 16, (*types >> 8) & 0xFF, *types & 0xFF));
+	}
+	r_name = vformat("operator_%d", *index);
+	return true;
+}
+
+bool GDScriptNativeCode::Writer::_translate(const GDScriptFunction *p_function, const Vector<int> &p_code, String &r_body) {
+	if (p_function->_argument_count != p_function->argument_types.size() || p_function->_vararg_index >= 0 || !p_function->default_arguments.is_empty()) {
+		return false;
+	}
+
+	const int *code = p_code.ptr();
+	const int code_size = p_code.size();
+	LocalVector<Pair<int, String>> instructions;
+	HashSet<int> targets;
+
+#define ADDRESS(m_var, m_offset, m_writable)                                        \
+	const String m_var = _get_address(p_function, code[ip + m_offset], m_writable); \
+	if (m_var.is_empty()) {                                                         \
+		return false;                                                               \
+	}
+
+#define TARGET(m_var, m_offset)            \
+	const int m_var = code[ip + m_offset]; \
+	targets.insert(m_var);
+
+// Checked before reading the arguments, so none of them is past the end.
+#define SIZE(m_size)             \
+	size = m_size;               \
+	if (ip + size > code_size) { \
+		return false;            \
+	}
+
+// Calls are followed by the addresses of their arguments, then of the base and the result when they have them,
+// then by the argument count and the index of the function in its table.
+#define CALL(m_extra_addresses, m_table_size)                                                          \
+	if (ip + 1 >= code_size) {                                                                         \
+		return false;                                                                                  \
+	}                                                                                                  \
+	const int address_count = code[ip + 1];                                                            \
+	if (address_count < 0) {                                                                           \
+		return false;                                                                                  \
+	}                                                                                                  \
+	SIZE(address_count + 4);                                                                           \
+	const int argc = code[ip + 2 + address_count];                                                     \
+	const int index = code[ip + 3 + address_count];                                                    \
+	if (argc < 0 || argc + m_extra_addresses != address_count || index < 0 || index >= m_table_size) { \
+		return false;                                                                                  \
+	}                                                                                                  \
+	LocalVector<String> arguments;                                                                     \
+	for (int i = 0; i < argc; i++) {                                                                   \
+		ADDRESS(argument, 2 + i, false);                                                               \
+		arguments.push_back(argument);                                                                 \
+	}
+
+	int ip = 0;
+	while (ip < code_size) {
+		const int opcode = code[ip];
+		String text;
+		int size = 0;
+
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				SIZE(opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED ? 5 : 6);
+				ADDRESS(a, 1, false);
+				ADDRESS(b, 2, false);
+				ADDRESS(dst, 3, true);
+				const int operator_index = code[ip + 4];
+				String evaluator;
+				if (operator_index < 0 || operator_index >= p_function->operator_funcs.size() || !_get_operator(p_function->operator_funcs[operator_index], evaluator)) {
+					return false;
+				}
+				if (opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+					const int result_type = code[ip + 5];
+					if (result_type < 0 || result_type >= Variant::VARIANT_MAX) {
+						return false;
+					}
+					text += vformat("if (unlikely(%s.get_type() != Variant::Type(%d))) {\n\t\tVariantInternal::initialize(&%s, Variant::Type(%d));\n\t}\n\t", dst, result_type, dst, result_type);
+				}
+				text += vformat("%s(&%s, &%s, &%s);", evaluator, a, b, dst);
+				if (opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+					TARGET(to, 5);
+					text += vformat("\n\tif (!*VariantInternal::get_bool(&%s)) {\n\t\tgoto L%d;\n\t}", dst, to);
+				}
+			} break;
+
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				SIZE(3);
+				ADDRESS(dst, 1, true);
+				ADDRESS(src, 2, false);
+				text = vformat("%s = %s;", dst, src);
+			} break;
+
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+				SIZE(4);
+				ADDRESS(dst, 1, true);
+				ADDRESS(src, 2, false);
+				const int type = code[ip + 3];
+				if (type < 0 || type >= Variant::VARIANT_MAX) {
+					return false;
+				}
+				text = vformat("if (likely(%s.get_type() == Variant::Type(%d))) {\n\t\t%s = %s;\n\t} else {\n\t\tGDScriptNativeCode::convert(%s, Variant::Type(%d), %s);\n\t}", src, type, dst, src, src, type, dst);
+			} break;
+
+			case GDScriptFunction::OPCODE_ASSIGN_NULL:
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				SIZE(2);
+				ADDRESS(dst, 1, true);
+				const char *value = opcode == GDScriptFunction::OPCODE_ASSIGN_NULL ? "Variant()" : (opcode == GDScriptFunction::OPCODE_ASSIGN_TRUE ? "true" : "false");
+				text = vformat("%s = %s;", dst, value);
+			} break;
+
+			case GDScriptFunction::OPCODE_JUMP: {
+				SIZE(2);
+				TARGET(to, 1);
+				text = vformat("goto L%d;", to);
+			} break;
+
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				SIZE(3);
+				ADDRESS(test, 1, false);
+				TARGET(to, 2);
+				text = vformat("if (%s%s.booleanize()) {\n\t\tgoto L%d;\n\t}", opcode == GDScriptFunction::OPCODE_JUMP_IF ? "" : "!", test, to);
+			} break;
+
+			case GDScriptFunction::OPCODE_RETURN: {
+				SIZE(2);
+				ADDRESS(r, 1, false);
+				text = vformat("r_return = %s;\n\treturn;", r);
+			} break;
+
+			case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+				SIZE(3);
+				ADDRESS(r, 1, false);
+				const int type = code[ip + 2];
+				if (type < 0 || type >= Variant::VARIANT_MAX) {
+					return false;
+				}
+				text = vformat("if (likely(%s.get_type() == Variant::Type(%d))) {\n\t\tr_return = %s;\n\t} else {\n\t\tGDScriptNativeCode::convert(%s, Variant::Type(%d), r_return);\n\t}\n\treturn;", r, type, r, r, type);
+			} break;
+
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT: {
+				SIZE(5);
+				ADDRESS(counter, 1, true);
+				ADDRESS(container, 2, false);
+				ADDRESS(iterator, 3, true);
+				TARGET(to, 4);
+				text = vformat("VariantInternal::initialize(&%s, Variant::INT);\n\t*VariantInternal::get_int(&%s) = 0;\n\tif (*VariantInternal::get_int(&%s) <= 0) {\n\t\tgoto L%d;\n\t}\n\tVariantInternal::initialize(&%s, Variant::INT);\n\t*VariantInternal::get_int(&%s) = 0;", counter, counter, container, to, iterator, iterator);
+			} break;
+
+			case GDScriptFunction::OPCODE_ITERATE_INT: {
+				SIZE(5);
+				ADDRESS(counter, 1, true);
+				ADDRESS(container, 2, false);
+				ADDRESS(iterator, 3, true);
+				TARGET(to, 4);
+				text = vformat("int64_t *count = VariantInternal::get_int(&%s);\n\t(*count)++;\n\tif (*count >= *VariantInternal::get_int(&%s)) {\n\t\tgoto L%d;\n\t}\n\t*VariantInternal::get_int(&%s) = *count;", counter, container, to, iterator);
+			} break;
+
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+				SIZE(7);
+				ADDRESS(counter, 1, true);
+				ADDRESS(from, 2, false);
+				ADDRESS(to, 3, false);
+				ADDRESS(step, 4, false);
+				ADDRESS(iterator, 5, true);
+				TARGET(jump_to, 6);
+				text = vformat("const int64_t from = *VariantInternal::get_int(&%s);\n\tconst int64_t to = *VariantInternal::get_int(&%s);\n\tconst int64_t step = *VariantInternal::get_int(&%s);\n\t", from, to, step);
+				text += vformat("VariantInternal::initialize(&%s, Variant::INT);\n\t*VariantInternal::get_int(&%s) = from;\n\tif (from == to || (from < to ? step <= 0 : step >= 0)) {\n\t\tgoto L%d;\n\t}\n\t", counter, counter, jump_to);
+				text += vformat("VariantInternal::initialize(&%s, Variant::INT);\n\t*VariantInternal::get_int(&%s) = from;", iterator, iterator);
+			} break;
+
+			case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+				SIZE(6);
+				ADDRESS(counter, 1, true);
+				ADDRESS(to, 2, false);
+				ADDRESS(step, 3, false);
+				ADDRESS(iterator, 4, true);
+				TARGET(jump_to, 5);
+				text = vformat("const int64_t to = *VariantInternal::get_int(&%s);\n\tconst int64_t step = *VariantInternal::get_int(&%s);\n\tint64_t *count = VariantInternal::get_int(&%s);\n\t*count += step;\n\t", to, step, counter);
+				text += vformat("if ((step < 0 && *count <= to) || (step > 0 && *count >= to)) {\n\t\tgoto L%d;\n\t}\n\t*VariantInternal::get_int(&%s) = *count;", jump_to, iterator);
+			} break;
+
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+				// Native methods called through their pointer call, with arguments of the expected types.
+				CALL(2, p_function->_methods_count);
+				ADDRESS(base, 2 + argc, false);
+				ADDRESS(ret, 3 + argc, true);
+				text = vformat("Object *base = GDScriptNativeCode::get_call_base(%s, function, %d);\n\tif (unlikely(!base)) {\n\t\treturn;\n\t}\n\t", base, index);
+				text += _get_arguments(arguments) + "\n\t";
+				if (opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN) {
+					text += vformat("GDScriptNativeCode::get_method(function, %d)->validated_call(base, args, &%s);", index, ret);
+				} else {
+					text += vformat("VariantInternal::initialize(&%s, Variant::NIL);\n\tGDScriptNativeCode::get_method(function, %d)->validated_call(base, args, nullptr);", ret, index);
+				}
+			} break;
+
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+				CALL(1, p_function->_methods_count);
+				ADDRESS(ret, 2 + argc, true);
+				text = _get_arguments(arguments) + "\n\t";
+				if (opcode == GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN) {
+					text += vformat("GDScriptNativeCode::get_method(function, %d)->validated_call(nullptr, args, &%s);", index, ret);
+				} else {
+					text += vformat("VariantInternal::initialize(&%s, Variant::NIL);\n\tGDScriptNativeCode::get_method(function, %d)->validated_call(nullptr, args, nullptr);", ret, index);
+				}
+			} break;
+
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+				CALL(2, p_function->_builtin_methods_count);
+				// Like in the VM, the methods modifying their base can be called on constants too.
+				ADDRESS(base, 2 + argc, false);
+				ADDRESS(ret, 3 + argc, true);
+				text = _get_arguments(arguments) + "\n\t";
+				text += vformat("GDScriptNativeCode::get_builtin_method(function, %d)(const_cast<Variant *>(&%s), args, %d, &%s);", index, base, argc, ret);
+			} break;
+
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+				CALL(1, p_function->_utilities_count);
+				ADDRESS(ret, 2 + argc, true);
+				text = _get_arguments(arguments) + "\n\t";
+				text += vformat("GDScriptNativeCode::get_utility(function, %d)(&%s, args, %d);", index, ret, argc);
+			} break;
+
+			case GDScriptFunction::OPCODE_LINE: {
+				SIZE(2);
+			} break;
+
+			case GDScriptFunction::OPCODE_END: {
+				SIZE(1);
+				text = "return;";
+			} break;
+
+			default: {
+				for (const TypedOperator &typed : typed_operators) {
+					if (typed.opcode == opcode) {
+						SIZE(5);
+						ADDRESS(a, 1, false);
+						ADDRESS(b, 2, false);
+						ADDRESS(dst, 3, true);
+						text = vformat("const auto result = *VariantInternal::%s(&%s) %s *VariantInternal::%s(&%s);\n\t", typed.get, a, typed.op, typed.get_right ? typed.get_right : typed.get, b);
+						text += vformat("if (unlikely(%s.get_type() != Variant::%s)) {\n\t\tVariantInternal::initialize(&%s, Variant::%s);\n\t}\n\t*VariantInternal::%s(&%s) = result;", dst, typed.type, dst, typed.type, typed.get, dst);
+					}
+				}
+				for (const TypedOperator &typed : typed_jumps) {
+					if (typed.opcode == opcode) {
+						SIZE(6);
+						ADDRESS(a, 1, false);
+						ADDRESS(b, 2, false);
+						TARGET(to, 5);
+						text = vformat("if (!(*VariantInternal::%s(&%s) %s *VariantInternal::%s(&%s))) {\n\t\tgoto L%d;\n\t}", typed.get, a, typed.op, typed.get, b, to);
+					}
+				}
+				for (const auto &adjust : type_adjusts) {
+					if (adjust.opcode == opcode) {
+						SIZE(2);
+						ADDRESS(arg, 1, true);
+						text = vformat("VariantTypeAdjust<%s>::adjust(&%s);", adjust.type, arg);
+					}
+				}
+				if (size == 0) {
+					return false;
+				}
+			} break;
+		}
+
+		instructions.push_back(Pair<int, String>(ip, text));
+		ip += size;
+	}
+
+#undef CALL
+#undef SIZE
+#undef TARGET
+#undef ADDRESS
+
+	// Jumps must land on an instruction, like the compiler makes them.
+	HashSet<int> starts;
+	for (const Pair<int, String> &instruction : instructions) {
+		starts.insert(instruction.first);
+	}
+	for (const int &target : targets) {
+		if (!starts.has(target)) {
+			return false;
+		}
+	}
+
+	r_body = String();
+	for (const Pair<int, String> &instruction : instructions) {
+		if (targets.has(instruction.first)) {
+			r_body += vformat("L%d:;\n", instruction.first);
+		}
+		if (!instruction.second.is_empty()) {
+			// Scoped, so the locals of an instruction can't be jumped over.
+			r_body += "\t{\n\t" + instruction.second.replace("\n\t", "\n\t\t") + "\n\t}\n";
+		}
+	}
+	return true;
+}
+
+bool GDScriptNativeCode::Writer::add_function(const GDScriptFunction *p_function, const String &p_class, const Vector<int> &p_code) {
+	String body;
+	if (!_translate(p_function, p_code, body)) {
+		return false;
+	}
+
+	const uint64_t key = get_key(p_class, p_function->name, p_code.ptr(), p_code.size());
+	functions += vformat("// %s::%s()\nstatic void gdscript_function_%d(const GDScriptFunction *function, Variant *stack, const Variant *constants, Variant *members, Variant &r_return) {\n%s}\n\n", p_class, p_function->name, function_count, body);
+	registrations += vformat("\tGDScriptNativeCode::register_function(0x%sULL, %d, gdscript_function_%d);\n", String::num_uint64(key, 16), p_function->_stack_size, function_count);
+	function_count++;
+	return true;
+}
+
+String GDScriptNativeCode::Writer::get_code() const {
+	String code = "// Generated by the \"gdscript/native_code\" export option, don't edit it.\n\n";
+	code += "#include \"modules/gdscript/gdscript_native_code.h\"\n\n";
+	code += "#include \"core/object/method_bind.h\"\n";
+	code += "#include \"core/variant/variant_internal.h\"\n\n";
+	for (uint32_t i = 0; i < operators.size(); i++) {
+		code += vformat("static Variant::ValidatedOperatorEvaluator operator_%d = nullptr;\n", i);
+	}
+	if (!operators.is_empty()) {
+		code += "\n";
+	}
+	code += functions;
+	code += "void register_gdscript_native_code() {\n";
+	for (uint32_t i = 0; i < operators.size(); i++) {
+		code += vformat("\toperator_%d = Variant::get_validated_operator_evaluator(%s);\n", i, operators[i]);
+	}
+	code += registrations;
+	code += "}\n";
+	return code;
+}
+
+#endif // TOOLS_ENABLED
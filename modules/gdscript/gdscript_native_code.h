@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  gdscript_native_code.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_function.h"
+
+#include "core/templates/hash_map.h"
+
+// Functions of exported scripts translated to C++ by the "gdscript/native_code" export option,
+// and compiled into export templates with `scons gdscript_native_code=<path to the generated file>`.
+//
+// Only statically typed functions made of a subset of the instructions are translated: operators and
+// comparisons with known types, assignments, loops over integers, jumps, returns, script members, and the
+// calls the VM makes through validated calls (native methods, methods of builtin types, utility functions).
+// Everything else, including any function that calls script functions or uses untyped values, keeps running
+// on the VM.
+//
+// The translated code works on the stack of the bytecode it was made from, so it's only used for the
+// functions loaded from the bytecode cache exported along with it, which are known to be compiled
+// the same way. Each function is identified by its class, name and bytecode.
+class GDScriptNativeCode {
+	struct Entry {
+		int stack_size = 0;
+		GDScriptFunction::NativeCode function = nullptr;
+	};
+
+	static HashMap<uint64_t, Entry> functions;
+
+public:
+	static uint64_t get_key(const String &p_class, const StringName &p_name, const int *p_code, int p_code_size);
+
+	// Called by `register_gdscript_native_code()` in the generated file, when the module is initialized.
+	static void register_function(uint64_t p_key, int p_stack_size, GDScriptFunction::NativeCode p_function);
+	static GDScriptFunction::NativeCode get_function(uint64_t p_key, int p_stack_size);
+	static int get_function_count() { return functions.size(); }
+
+	// Used by the translated assignments and returns of a builtin type, when the value has another type.
+	static void convert(const Variant &p_value, Variant::Type p_type, Variant &r_ret);
+
+	// Used by the translated calls, which go through the same tables as the VM, filled when loading the function.
+	static _FORCE_INLINE_ MethodBind *get_method(const GDScriptFunction *p_function, int p_index) { return p_function->_methods_ptr[p_index]; }
+	static _FORCE_INLINE_ Variant::ValidatedBuiltInMethod get_builtin_method(const GDScriptFunction *p_function, int p_index) { return p_function->_builtin_methods_ptr[p_index]; }
+	static _FORCE_INLINE_ Variant::ValidatedUtilityFunction get_utility(const GDScriptFunction *p_function, int p_index) { return p_function->_utilities_ptr[p_index]; }
+	// Returns null after printing the error the VM gives when calling a method on null or on a freed object.
+	static Object *get_call_base(const Variant &p_base, const GDScriptFunction *p_function, int p_method);
+
+#ifdef TOOLS_ENABLED
+	// Makes the C++ file out of the functions added to it.
+	class Writer {
+		String functions;
+		String registrations;
+		HashMap<uint64_t, int> operator_indices; // By address of the evaluator.
+		LocalVector<String> operators; // Arguments to get each evaluator when registering.
+		int function_count = 0;
+
+		// Returns an empty string for the addresses the translated code can't use.
+		static String _get_address(const GDScriptFunction *p_function, int p_address, bool p_writable);
+		bool _get_operator(Variant::ValidatedOperatorEvaluator p_evaluator, String &r_name);
+		bool _translate(const GDScriptFunction *p_function, const Vector<int> &p_code, String &r_body);
+
+	public:
+		// Adds nothing and returns false if the function can't be translated.
+		// The code is the one of the function as saved in the bytecode cache.
+		bool add_function(const GDScriptFunction *p_function, const String &p_class, const Vector<int> &p_code);
+		int get_function_count() const { return function_count; }
+		String get_code() const;
+	};
+#endif // TOOLS_ENABLED
+};
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+// Defined by the generated file.
+void register_gdscript_native_code();
+#endif
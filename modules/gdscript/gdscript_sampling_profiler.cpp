@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::tick;
+thread_local uint32_t GDScriptSamplingProfiler::thread_tick = 0;
+
+SafeFlag GDScriptSamplingProfiler::running;
+Thread GDScriptSamplingProfiler::thread;
+uint64_t GDScriptSamplingProfiler::interval_usec = DEFAULT_INTERVAL_USEC;
+
+Mutex GDScriptSamplingProfiler::mutex;
+HashMap<String, uint64_t> GDScriptSamplingProfiler::stacks;
+uint64_t GDScriptSamplingProfiler::sample_count = 0;
+
+void GDScriptSamplingProfiler::_thread_func(void *p_userdata) {
+	Thread::set_name("GDScript Sampling Profiler");
+	while (running.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		tick.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::_record_stack(uint32_t p_weight) {
+	if (!running.is_set()) {
+		return; // Ticks counted before stopping, seen late by this thread.
+	}
+
+	LocalVector<String> frames;
+	for (const GDScriptLanguage::CallLevel *level = GDScriptLanguage::_call_stack; level; level = level->prev) {
+		if (level->function) {
+			// Semicolons separate the frames.
+			const String source = String(level->function->get_source()).replace_char(';', '_');
+			frames.push_back(vformat("%s:%s:%d", source, level->function->get_name(), *level->line));
+		}
+	}
+	if (frames.is_empty()) {
+		return;
+	}
+
+	String stack = frames[frames.size() - 1];
+	for (int i = int(frames.size()) - 2; i >= 0; i--) {
+		stack += ";" + frames[i];
+	}
+
+	MutexLock lock(mutex);
+	HashMap<String, uint64_t>::Iterator E = stacks.find(stack);
+	if (E) {
+		E->value += p_weight;
+	} else {
+		stacks.insert(stack, p_weight);
+	}
+	sample_count += p_weight;
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(running.is_set(), "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND(p_interval_usec == 0);
+
+	interval_usec = p_interval_usec;
+	running.set();
+	thread.start(_thread_func, nullptr);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+	running.clear();
+	thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	stacks.clear();
+	sample_count = 0;
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSamplingProfiler::get_folded_stacks() {
+	Vector<String> lines;
+	{
+		MutexLock lock(mutex);
+		for (const KeyValue<String, uint64_t> &E : stacks) {
+			lines.push_back(vformat("%s %d", E.key, E.value));
+		}
+	}
+	lines.sort();
+
+	String folded;
+	for (const String &line : lines) {
+		folded += line + "\n";
+	}
+	return folded;
+}
+
+Error GDScriptSamplingProfiler::save_folded_stacks(const String &p_path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot open \"%s\" to save the GDScript samples.", p_path));
+	file->store_string(get_folded_stacks());
+	return OK;
+}
@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Samples the call stacks of the running scripts at a regular interval, giving the time spent
+// on each line without measuring every call like the instrumenting profiler does.
+//
+// A thread increments a counter at each interval. The threads running scripts check the counter
+// when reaching a new line (see `OPCODE_LINE`), and record their call stack when it changed,
+// with the number of intervals that passed in the line they were running.
+// Lines are only known when the call stack is tracked, see `GDScriptLanguage::should_track_call_stack()`.
+class GDScriptSamplingProfiler {
+	static SafeNumeric<uint32_t> tick;
+	static thread_local uint32_t thread_tick;
+
+	static SafeFlag running;
+	static Thread thread;
+	static uint64_t interval_usec;
+
+	static Mutex mutex;
+	static HashMap<String, uint64_t> stacks;
+	static uint64_t sample_count;
+
+	static void _thread_func(void *p_userdata);
+	static void _record_stack(uint32_t p_weight);
+
+public:
+	static constexpr uint64_t DEFAULT_INTERVAL_USEC = 1000;
+
+	// Called when a thread starts running scripts, so the time spent outside of them isn't counted.
+	_FORCE_INLINE_ static void thread_entered() {
+		thread_tick = tick.get();
+	}
+
+	// Called when reaching a new line, while the call stack still points to the previous one.
+	_FORCE_INLINE_ static void line_reached() {
+		const uint32_t current = tick.get();
+		if (unlikely(current != thread_tick)) {
+			const uint32_t weight = current - thread_tick;
+			thread_tick = current;
+			_record_stack(weight);
+		}
+	}
+
+	static void start(uint64_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	static void stop();
+	static bool is_running() { return running.is_set(); }
+
+	static void clear();
+	static uint64_t get_sample_count();
+	// One line per distinct call stack, from the outermost function, followed by its number of samples
+	// (e.g. `res://main.gd:_process:12;res://enemy.gd:think:40 25`).
+	// This is the "folded" format read by flame graph tools like `flamegraph.pl`, inferno or speedscope.
+	static String get_folded_stacks();
+	static Error save_folded_stacks(const String &p_path);
+};
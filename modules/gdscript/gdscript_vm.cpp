@@ -32,8 +32,10 @@
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
 
+#include "core/config/engine.h"
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -151,6 +153,192 @@ Variant GDScriptFunction::_get_default_variant_for_data_type(const GDScriptDataT
 	return Variant();
 }
 
+// Objects without script instances can be cached too, but not the ones with other kinds of scripts.
+bool GDScriptFunction::_get_inline_cache_instance(Object *p_object, GDScriptInstance *&r_instance) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance) {
+		r_instance = nullptr;
+		return true;
+	}
+	if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+		return false;
+	}
+	r_instance = static_cast<GDScriptInstance *>(script_instance);
+	return true;
+}
+
+// The pointer is stored at the first suitably aligned address after the instruction.
+static _FORCE_INLINE_ std::atomic<const GDScriptFunction::InlineCache *> &_get_inline_cache_slot(int *p_cache) {
+	static_assert(sizeof(std::atomic<const GDScriptFunction::InlineCache *>) == sizeof(void *) && alignof(std::atomic<const GDScriptFunction::InlineCache *>) == alignof(void *));
+	const uintptr_t address = ((uintptr_t)p_cache + alignof(void *) - 1) & ~(uintptr_t)(alignof(void *) - 1);
+	return *reinterpret_cast<std::atomic<const GDScriptFunction::InlineCache *> *>(address);
+}
+
+// Acquire, so the contents of the cache are seen as they were when it was published.
+static _FORCE_INLINE_ const GDScriptFunction::InlineCache *_get_inline_cache(int *p_cache) {
+	return _get_inline_cache_slot(p_cache).load(std::memory_order_acquire);
+}
+
+// Caches of a script that changed since they were filled must not be used, but are the only ones filled again.
+// Other objects reaching a filled cache take the regular path, so instructions seeing several kinds of objects
+// don't keep making new caches.
+static _FORCE_INLINE_ bool _is_inline_cache_valid(const GDScriptFunction::InlineCache *p_cache, const GDScript *p_script, bool &r_refill) {
+	if (!p_cache) {
+		r_refill = true;
+		return false;
+	}
+	if (p_cache->script != p_script) {
+		r_refill = false;
+		return false;
+	}
+	const bool valid = !p_script || p_cache->script_version == p_script->get_inline_cache_version();
+	r_refill = !valid;
+	return valid;
+}
+
+void GDScriptFunction::_set_inline_cache(int *p_cache, const InlineCache &p_value) {
+	MutexLock lock(inline_caches_mutex);
+
+	std::atomic<const InlineCache *> &slot = _get_inline_cache_slot(p_cache);
+	const InlineCache *current = slot.load(std::memory_order_relaxed);
+	if (current && current->script == p_value.script && current->script_version == p_value.script_version) {
+		return; // Filled by another thread in the meantime.
+	}
+
+	// Other threads may still be reading the current one, so it's kept until the function is freed.
+	InlineCache *inline_cache = memnew(InlineCache(p_value));
+	inline_caches.push_back(inline_cache);
+	slot.store(inline_cache, std::memory_order_release);
+}
+
+Variant GDScriptFunction::_get_named_cached(int *p_cache, const Variant *p_base, const StringName &p_name, bool &r_valid) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	if (object && _get_inline_cache_instance(object, instance) && instance) {
+		const InlineCache *cache = _get_inline_cache(p_cache);
+		const GDScript *script = instance->script.ptr();
+		bool refill;
+		if (likely(_is_inline_cache_valid(cache, script, refill))) {
+			const GDScript::MemberInfo *member = static_cast<const GDScript::MemberInfo *>(cache->target);
+			if (likely(member->index < instance->members.size())) {
+				r_valid = true;
+				return instance->members[member->index];
+			}
+		} else if (refill && script->valid) {
+			// Script members are looked up before anything else, so they can be cached unless they have a getter.
+			const GDScript::MemberInfo *member = script->member_indices.getptr(p_name);
+			if (member && !member->getter) {
+				InlineCache value;
+				value.kind = InlineCache::KIND_MEMBER;
+				value.script = script;
+				value.script_version = script->get_inline_cache_version();
+				value.target = const_cast<GDScript::MemberInfo *>(member);
+				_set_inline_cache(p_cache, value);
+			}
+		}
+	}
+
+	return p_base->get_named(p_name, r_valid);
+}
+
+void GDScriptFunction::_set_named_cached(int *p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	if (object && _get_inline_cache_instance(object, instance) && instance) {
+		const InlineCache *cache = _get_inline_cache(p_cache);
+		const GDScript *script = instance->script.ptr();
+		bool refill;
+		if (likely(_is_inline_cache_valid(cache, script, refill))) {
+			const GDScript::MemberInfo *member = static_cast<const GDScript::MemberInfo *>(cache->target);
+			// Values needing a conversion go through `GDScriptInstance::set()`.
+			if (likely(member->index < instance->members.size()) && member->data_type.is_type(p_value)) {
+				instance->members.write[member->index] = p_value;
+				r_valid = true;
+				return;
+			}
+		} else if (refill && script->valid) {
+#ifdef TOOLS_ENABLED
+			// `Object::set()` marks the object as edited, which matters for tool scripts running in the editor.
+			const bool can_cache = !Engine::get_singleton()->is_editor_hint();
+#else
+			const bool can_cache = true;
+#endif
+			const GDScript::MemberInfo *member = script->member_indices.getptr(p_name);
+			if (can_cache && member && !member->setter) {
+				InlineCache value;
+				value.kind = InlineCache::KIND_MEMBER;
+				value.script = script;
+				value.script_version = script->get_inline_cache_version();
+				value.target = const_cast<GDScript::MemberInfo *>(member);
+				_set_inline_cache(p_cache, value);
+			}
+		}
+	}
+
+	p_base->set_named(p_name, p_value, r_valid);
+}
+
+void GDScriptFunction::_call_cached(int *p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	if (object && _get_inline_cache_instance(object, instance)) {
+		const InlineCache *cache = _get_inline_cache(p_cache);
+		const GDScript *script = instance ? instance->script.ptr() : nullptr;
+		bool refill;
+
+		if (likely(_is_inline_cache_valid(cache, script, refill))) {
+			// Same as `Object::callp()`, which locks the object while calling.
+			if (cache->kind == InlineCache::KIND_FUNCTION) {
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(object);
+#endif
+				r_err.error = Callable::CallError::CALL_OK;
+				r_ret = static_cast<GDScriptFunction *>(cache->target)->call(instance, p_args, p_argcount, r_err);
+				return;
+			} else if (cache->native_class == object->get_class_name().data_unique_pointer()) {
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(object);
+#endif
+				r_err.error = Callable::CallError::CALL_OK;
+				r_ret = static_cast<MethodBind *>(cache->target)->call(object, p_args, p_argcount, r_err);
+				return;
+			}
+		} else if (refill && p_method != CoreStringName(free_) && p_method != SceneStringName(_ready)) {
+			// `free()` is handled by `Object::callp()` itself, and `_ready()` also runs the implicit initializers.
+			InlineCache value;
+			value.script = script;
+			value.script_version = script ? script->get_inline_cache_version() : 0;
+
+			// Look the method up like `GDScriptInstance::callp()`, then in the native class.
+			for (GDScript *sptr = instance ? instance->script.ptr() : nullptr; sptr && !value.target; sptr = sptr->base.ptr()) {
+				if (sptr->valid) {
+					GDScriptFunction **function = sptr->member_functions.getptr(p_method);
+					if (function) {
+						value.kind = InlineCache::KIND_FUNCTION;
+						value.target = *function;
+					}
+				}
+			}
+			const StringName &class_name = object->get_class_name();
+			const ClassDB::APIType api = value.target ? ClassDB::API_NONE : ClassDB::get_api_type(class_name);
+			if (api == ClassDB::API_CORE || api == ClassDB::API_EDITOR) {
+				// Not extension classes, their methods may be replaced when the extension reloads.
+				MethodBind *method = ClassDB::get_method(class_name, p_method);
+				if (method) {
+					value.kind = InlineCache::KIND_METHOD_BIND;
+					value.native_class = class_name.data_unique_pointer();
+					value.target = method;
+				}
+			}
+			if (value.target) {
+				_set_inline_cache(p_cache, value);
+			}
+		}
+	}
+
+	p_base->callp(p_method, p_args, p_argcount, r_ret, r_err);
+}
+
 String GDScriptFunction::_get_call_error(const String &p_where, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const {
 	switch (p_err.error) {
 		case Callable::CallError::CALL_OK:
@@ -255,6 +443,30 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,              \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_ADD_INT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                  \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                  \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,        \
+		&&OPCODE_JUMP_IF_NOT_INT_EQUAL,                  \
+		&&OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL,              \
+		&&OPCODE_JUMP_IF_NOT_INT_LESS,                   \
+		&&OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL,             \
+		&&OPCODE_JUMP_IF_NOT_INT_GREATER,                \
+		&&OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL,          \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_EQUAL,                \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_NOT_EQUAL,            \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_LESS,                 \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL,           \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_GREATER,              \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL,        \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -497,6 +709,7 @@ void (*type_init_function_table[])(Variant *) = {
 
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	GodotProfileZoneGroupedFirstScript(zone, this, source, name, _initial_line);
+	MemoryTagScope memory_tag_scope(Memory::TAG_SCRIPTING);
 
 	OPCODES_TABLE;
 
@@ -543,11 +756,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->stack_capacity;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -740,6 +953,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+	if (native_code && !p_state && !EngineDebugger::is_active()) {
+		// Translated to C++ when exporting, see `GDScriptNativeCode`. It returns in place of the
+		// bytecode, then `OPCODE_END` exits like any other call.
+		native_code(this, stack, _constants_ptr, variant_addresses[ADDR_TYPE_MEMBER], retvalue);
+		ip = _code_size - 1;
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -852,6 +1072,108 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				// Unlike temporaries, the target may not hold the result type yet (e.g. uninitialized or untyped variables).
+				Variant::Type result_type = (Variant::Type)_code_ptr[ip + 5];
+				if (unlikely(dst->get_type() != result_type)) {
+					VariantInternal::initialize(dst, result_type);
+				}
+				operator_func(a, b, dst);
+
+				ip += 6;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// Only generated for operators returning a boolean.
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_OPERATOR_TYPED(m_name, m_type, m_get_left, m_get_right, m_operator)                       \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                   \
+		CHECK_SPACE(5);                                                                                  \
+		GET_VARIANT_PTR(a, 0);                                                                           \
+		GET_VARIANT_PTR(b, 1);                                                                           \
+		GET_VARIANT_PTR(dst, 2);                                                                         \
+		const auto result = *VariantInternal::m_get_left(a) m_operator *VariantInternal::m_get_right(b); \
+		if (unlikely(dst->get_type() != Variant::m_type)) {                                              \
+			VariantInternal::initialize(dst, Variant::m_type);                                           \
+		}                                                                                                \
+		*VariantInternal::m_get_left(dst) = result;                                                      \
+		ip += 5;                                                                                         \
+	}                                                                                                    \
+	DISPATCH_OPCODE
+
+			// Validated operators on typed `int`, `float` and `Vector3` values, done in place of calling the evaluator.
+			OPCODE_OPERATOR_TYPED(ADD_INT, INT, get_int, get_int, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, INT, get_int, get_int, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, INT, get_int, get_int, *);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, FLOAT, get_float, get_float, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, FLOAT, get_float, get_float, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, FLOAT, get_float, get_float, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, FLOAT, get_float, get_float, /);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, VECTOR3, get_vector3, get_vector3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, VECTOR3, get_vector3, get_vector3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, VECTOR3, get_vector3, get_float, *);
+
+#define OPCODE_JUMP_IF_NOT_TYPED(m_type, m_op, m_get, m_operator)                  \
+	OPCODE(OPCODE_JUMP_IF_NOT_##m_type##_##m_op) {                                 \
+		CHECK_SPACE(6);                                                            \
+		GET_VARIANT_PTR(a, 0);                                                     \
+		GET_VARIANT_PTR(b, 1);                                                     \
+		if (!(*VariantInternal::m_get(a) m_operator *VariantInternal::m_get(b))) { \
+			int to = _code_ptr[ip + 5];                                            \
+			GD_ERR_BREAK(to < 0 || to > _code_size);                               \
+			ip = to;                                                               \
+		} else {                                                                   \
+			ip += 6;                                                               \
+		}                                                                          \
+	}                                                                              \
+	DISPATCH_OPCODE
+
+			// Comparisons of typed `int` and `float` values followed by a conditional jump.
+			OPCODE_JUMP_IF_NOT_TYPED(INT, EQUAL, get_int, ==);
+			OPCODE_JUMP_IF_NOT_TYPED(INT, NOT_EQUAL, get_int, !=);
+			OPCODE_JUMP_IF_NOT_TYPED(INT, LESS, get_int, <);
+			OPCODE_JUMP_IF_NOT_TYPED(INT, LESS_EQUAL, get_int, <=);
+			OPCODE_JUMP_IF_NOT_TYPED(INT, GREATER, get_int, >);
+			OPCODE_JUMP_IF_NOT_TYPED(INT, GREATER_EQUAL, get_int, >=);
+			OPCODE_JUMP_IF_NOT_TYPED(FLOAT, EQUAL, get_float, ==);
+			OPCODE_JUMP_IF_NOT_TYPED(FLOAT, NOT_EQUAL, get_float, !=);
+			OPCODE_JUMP_IF_NOT_TYPED(FLOAT, LESS, get_float, <);
+			OPCODE_JUMP_IF_NOT_TYPED(FLOAT, LESS_EQUAL, get_float, <=);
+			OPCODE_JUMP_IF_NOT_TYPED(FLOAT, GREATER, get_float, >);
+			OPCODE_JUMP_IF_NOT_TYPED(FLOAT, GREATER_EQUAL, get_float, >=);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1196,7 +1518,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4 + INLINE_CACHE_SIZE);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1207,7 +1529,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				const StringName *index = &_global_names_ptr[indexname];
 
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				_set_named_cached(&_code_ptr[ip + 4], dst, *index, *value, valid);
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1228,7 +1550,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 4 + INLINE_CACHE_SIZE;
 			}
 			DISPATCH_OPCODE;
 
@@ -1248,7 +1570,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(4 + INLINE_CACHE_SIZE);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1261,10 +1583,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret = _get_named_cached(&_code_ptr[ip + 4], src, *index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+				*dst = _get_named_cached(&_code_ptr[ip + 4], src, *index, valid);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1273,7 +1595,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 4 + INLINE_CACHE_SIZE;
 			}
 			DISPATCH_OPCODE;
 
@@ -1896,7 +2218,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(3 + instr_arg_count + INLINE_CACHE_SIZE);
 
 				ip += instr_arg_count;
 
@@ -1925,7 +2247,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					_call_cached(&_code_ptr[ip + 3], base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1955,7 +2277,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					_call_cached(&_code_ptr[ip + 3], base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2010,7 +2332,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 3 + INLINE_CACHE_SIZE;
 			}
 			DISPATCH_OPCODE;
 
@@ -2576,12 +2898,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
-					for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-					}
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
@@ -2614,10 +2930,26 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
 					if (err != OK) {
+						gdfs->state.stack_size = 0;
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
 					}
 
+					// The stack is moved to the state rather than copied, so it's freed by the state instead of when exiting.
+					// Variants don't refer to their own address, so they can be moved by copying their bytes.
+					if (p_state) {
+						// Resumed from an earlier `await`, the stack is already in a frame: hand it over as is.
+						gdfs->state.stack = p_state->stack;
+						gdfs->state.stack_capacity = p_state->stack_capacity;
+						p_state->stack = nullptr;
+						p_state->stack_capacity = 0;
+						p_state->stack_size = 0;
+					} else {
+						gdfs->state.stack = alloc_await_frame(alloca_size, gdfs->state.stack_capacity);
+						// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
+						memcpy(gdfs->state.stack + sizeof(Variant) * FIXED_ADDRESSES_MAX, (void *)&stack[FIXED_ADDRESSES_MAX], sizeof(Variant) * (_stack_size - FIXED_ADDRESSES_MAX));
+					}
+
 					awaited = true;
 
 #ifdef DEBUG_ENABLED
@@ -3882,6 +4214,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+				GDScriptSamplingProfiler::line_reached();
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -3982,9 +4315,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	if (!p_state || awaited) {
 		GDScriptLanguage::get_singleton()->exit_function();
 
-		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		// Free stack, except reserved addresses. After an `await`, it belongs to the function state.
+		if (!awaited) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
 		}
 	}
 
@@ -31,7 +31,9 @@
 #include "register_types.h"
 
 #include "gdscript.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_code.h"
 #include "gdscript_parser.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
@@ -80,14 +82,36 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr EditorExportPreset::ScriptExportMode DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	EditorExportPreset::ScriptExportMode script_mode = DEFAULT_SCRIPT_MODE;
+	bool bytecode_cache = false;
+	bool debug = false;
+	bool native_code = false;
+	String native_code_path;
+	GDScriptNativeCode::Writer native_code_writer;
 
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		// Also exports the compiled bytecode of each script, so the exported project doesn't have to compile it on load.
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/bytecode_cache"), false));
+		// Also translates the typed functions that can be to C++, written next to the exported project.
+		// Export templates built with `scons gdscript_native_code=<path>` then run them in place of their bytecode.
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/native_code"), false));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		bytecode_cache = false;
+		debug = p_debug;
+		native_code = false;
+		native_code_writer = GDScriptNativeCode::Writer();
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			bytecode_cache = get_option("gdscript/bytecode_cache");
+			// The translated functions are only used when loaded from the bytecode cache.
+			native_code = get_option("gdscript/native_code");
+			bytecode_cache = bytecode_cache || native_code;
+			native_code_path = p_path.get_basename() + ".gdscript_native_code.cpp";
 		}
 	}
 
@@ -109,6 +133,28 @@ protected:
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (bytecode_cache) {
+			// Made from the script as compiled by the editor, only if it matches the exported source.
+			Ref<GDScript> script = ResourceLoader::load(p_path);
+			if (script.is_valid() && script->get_source_code() == source) {
+				Vector<uint8_t> cache = GDScriptBytecodeCache::save(script, file, debug, compress_mode, native_code ? &native_code_writer : nullptr);
+				if (!cache.is_empty()) {
+					add_file(GDScriptBytecodeCache::get_cache_path(p_path.get_basename() + ".gdc"), cache, false);
+				}
+			}
+		}
+	}
+
+	virtual void _export_end() override {
+		if (!native_code) {
+			return;
+		}
+		Ref<FileAccess> f = FileAccess::open(native_code_path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't write the GDScript native code to "%s".)", native_code_path));
+		f->store_string(native_code_writer.get_code());
+		print_line(vformat(R"(GDScript: Translated %d functions to C++ in "%s".)", native_code_writer.get_function_count(), native_code_path));
+		native_code_writer = GDScriptNativeCode::Writer();
 	}
 
 public:
@@ -152,6 +198,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+		register_gdscript_native_code();
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
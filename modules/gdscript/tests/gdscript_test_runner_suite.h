@@ -85,6 +85,132 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+#ifdef DEBUG_ENABLED
+// Reloading while keeping the state relies on the member names kept in debug builds.
+TEST_CASE("[Modules][GDScript] Inline caches don't outlive a reload of the script") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> callee = memnew(GDScript);
+	callee->set_source_code(R"(
+extends RefCounted
+
+var value := 1
+
+func get_value():
+	return value
+)");
+	Ref<GDScript> caller = memnew(GDScript);
+	caller->set_source_code(R"(
+extends RefCounted
+
+func read(object):
+	return object.value + object.get_value()
+)");
+	ERR_PRINT_OFF;
+	REQUIRE(callee->reload() == OK);
+	REQUIRE(caller->reload() == OK);
+	ERR_PRINT_ON;
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(callee);
+	Ref<RefCounted> reader = memnew(RefCounted);
+	reader->set_script(caller);
+	CHECK(int(reader->call("read", object)) == 2);
+	CHECK_MESSAGE(int(reader->call("read", object)) == 2, "Should give the same result when using the filled caches.");
+
+	// The member moves to another index, and the function is replaced.
+	callee->set_source_code(R"(
+extends RefCounted
+
+var other := 100
+var value := 1
+
+func get_value():
+	return value * 10
+)");
+	ERR_PRINT_OFF;
+	REQUIRE(callee->reload(true) == OK);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(int(reader->call("read", object)) == 11, "Should use the members and functions of the reloaded script.");
+}
+
+TEST_CASE("[Modules][GDScript] Reloading a script only invalidates the inline caches depending on it") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(R"(
+extends RefCounted
+
+class Base:
+	func get_value():
+		return 1
+
+class Derived extends Base:
+	pass
+)");
+	Ref<GDScript> other = memnew(GDScript);
+	other->set_source_code(R"(
+extends RefCounted
+)");
+	ERR_PRINT_OFF;
+	REQUIRE(script->reload() == OK);
+	REQUIRE(other->reload() == OK);
+	ERR_PRINT_ON;
+
+	const Variant *base_constant = script->get_constants().getptr("Base");
+	const Variant *derived_constant = script->get_constants().getptr("Derived");
+	REQUIRE(base_constant);
+	REQUIRE(derived_constant);
+	const Ref<GDScript> base = *base_constant;
+	const Ref<GDScript> derived = *derived_constant;
+	const uint64_t derived_version = derived->get_inline_cache_version();
+	const uint64_t other_version = other->get_inline_cache_version();
+	CHECK_MESSAGE(derived_version >= base->get_inline_cache_version(), "Changes to the base script should also invalidate the caches of the derived one.");
+
+	ERR_PRINT_OFF;
+	REQUIRE(script->reload(true) == OK);
+	ERR_PRINT_ON;
+	CHECK(derived->get_inline_cache_version() != derived_version);
+	CHECK_MESSAGE(other->get_inline_cache_version() == other_version, "Scripts not depending on the reloaded one should keep their caches.");
+}
+
+#endif // DEBUG_ENABLED
+
+#ifdef DEBUG_ENABLED
+// Lines are only tracked by default in debug builds.
+TEST_CASE("[Modules][GDScript] Sampling profiler records the lines being run") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func spin():
+	var start := Time.get_ticks_msec()
+	var count := 0
+	while Time.get_ticks_msec() - start < 100:
+		count += 1
+	return count
+
+func run():
+	return spin()
+)");
+	ERR_PRINT_OFF;
+	REQUIRE(gdscript->reload() == OK);
+	ERR_PRINT_ON;
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC);
+	ref_counted->call("run");
+	GDScriptSamplingProfiler::stop();
+
+	CHECK(GDScriptSamplingProfiler::get_sample_count() > 0);
+	const String folded = GDScriptSamplingProfiler::get_folded_stacks();
+	CHECK_MESSAGE(folded.contains(":run:12;:spin:"), "The stacks should start from the outermost function, with the line of the call.");
+	CHECK_MESSAGE((folded.contains(":spin:7 ") || folded.contains(":spin:8 ")), "Most samples should be in the loop.");
+	GDScriptSamplingProfiler::clear();
+}
+#endif // DEBUG_ENABLED
+
 TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in sync") {
 	const String path = TestUtils::get_temp_path("gdscript_load_test.gd");
 
@@ -105,6 +231,118 @@ TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in
 	CHECK(TestGDScriptCacheAccessor::has_full(path));
 }
 
+TEST_CASE("[Modules][GDScript] Scripts parsed in parallel are used when loading them") {
+	const String base_path = TestUtils::get_temp_path("gdscript_parallel_base.gd");
+	const String derived_path = TestUtils::get_temp_path("gdscript_parallel_derived.gd");
+
+	{
+		Ref<FileAccess> fa = FileAccess::open(base_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nfunc get_value():\n\treturn 40\n");
+		fa->close();
+		fa = FileAccess::open(derived_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(vformat("extends \"%s\"\n\nfunc get_value():\n\treturn super() + 2\n", base_path));
+		fa->close();
+	}
+
+	GDScriptCache::parse_scripts({ base_path, derived_path });
+	CHECK(GDScriptCache::has_parser(base_path));
+	CHECK(GDScriptCache::has_parser(derived_path));
+
+	Ref<GDScript> loaded = ResourceLoader::load(derived_path);
+	REQUIRE(loaded.is_valid());
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(loaded);
+	CHECK(int(ref_counted->call("get_value")) == 42);
+
+	GDScriptCache::release_preparsed_parsers();
+	CHECK_MESSAGE(!GDScriptCache::has_parser(base_path), "The parsers should be freed once nothing uses them.");
+}
+
+#ifdef DEBUG_ENABLED
+// Hot reloading is only available in debug builds.
+TEST_CASE("[Modules][GDScript] Hot reloading only reloads inheriting scripts when the interface changes") {
+	const String base_path = TestUtils::get_temp_path("gdscript_reload_base.gd");
+	const String derived_path = TestUtils::get_temp_path("gdscript_reload_derived.gd");
+
+	{
+		Ref<FileAccess> fa = FileAccess::open(base_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nfunc get_value():\n\treturn 40\n");
+		fa->close();
+		fa = FileAccess::open(derived_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(vformat("extends \"%s\"\n\nfunc get_value():\n\treturn super() + 2\n", base_path));
+		fa->close();
+	}
+
+	Ref<GDScript> derived = ResourceLoader::load(derived_path);
+	REQUIRE(derived.is_valid());
+	Ref<GDScript> base = derived->get_base();
+	REQUIRE(base.is_valid());
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(derived);
+	CHECK(int(ref_counted->call("get_value")) == 42);
+	const GDScriptFunction *derived_function = derived->get_member_functions()["get_value"];
+
+	// Only the body of the function changes.
+	{
+		Ref<FileAccess> fa = FileAccess::open(base_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nfunc get_value():\n\treturn 50\n");
+		fa->close();
+	}
+	Array scripts = { base };
+	GDScriptLanguage::get_singleton()->reload_scripts(scripts, true);
+	CHECK_MESSAGE(int(ref_counted->call("get_value")) == 52, "Should call the reloaded function of the base.");
+	CHECK_MESSAGE(derived->get_member_functions()["get_value"] == derived_function, "The inheriting script shouldn't have been reloaded.");
+
+	// A member is added, so the inheriting script has to be compiled again.
+	{
+		Ref<FileAccess> fa = FileAccess::open(base_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nvar offset := 10\n\nfunc get_value():\n\treturn 50 + offset\n");
+		fa->close();
+	}
+	GDScriptLanguage::get_singleton()->reload_scripts(scripts, true);
+	CHECK(derived->is_valid());
+	CHECK(derived->debug_get_member_indices().has("offset"));
+}
+
+TEST_CASE("[Modules][GDScript] Hot reloading follows interface changes down the inheritance chain") {
+	const String base_path = TestUtils::get_temp_path("gdscript_reload_chain_base.gd");
+	const String middle_path = TestUtils::get_temp_path("gdscript_reload_chain_middle.gd");
+	const String derived_path = TestUtils::get_temp_path("gdscript_reload_chain_derived.gd");
+
+	{
+		Ref<FileAccess> fa = FileAccess::open(base_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nconst VALUE = 40\n");
+		fa->close();
+		fa = FileAccess::open(middle_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(vformat("extends \"%s\"\n", base_path));
+		fa->close();
+		fa = FileAccess::open(derived_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(vformat("extends \"%s\"\n\nfunc get_value() -> int:\n\treturn VALUE + 2\n", middle_path));
+		fa->close();
+	}
+
+	Ref<GDScript> derived = ResourceLoader::load(derived_path);
+	REQUIRE(derived.is_valid());
+	Ref<GDScript> middle = derived->get_base();
+	REQUIRE(middle.is_valid());
+	Ref<GDScript> base = middle->get_base();
+	REQUIRE(base.is_valid());
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(derived);
+	CHECK(int(ref_counted->call("get_value")) == 42);
+
+	// The constant is folded into the code of the script two levels down, which declares nothing that changes.
+	{
+		Ref<FileAccess> fa = FileAccess::open(base_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nconst VALUE = 50\n");
+		fa->close();
+	}
+	Array scripts = { base };
+	GDScriptLanguage::get_singleton()->reload_scripts(scripts, true);
+	CHECK_MESSAGE(int(ref_counted->call("get_value")) == 52, "Should use the constant of the reloaded base.");
+}
+#endif // DEBUG_ENABLED
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,40 @@
+# Validated operators can be fused with the conditional jump or the assignment using their result.
+
+var member := 0
+
+func triple(value: int) -> int:
+	value = value * 3
+	return value
+
+func test():
+	var i := 0
+	var total := 0
+	while i < 10:
+		if i % 2 == 0:
+			total = total + i
+		i = i + 1
+	print(total)
+
+	if not (i > 30):
+		print("unary condition")
+
+	if true:
+		var object := RefCounted.new()
+		print(object != null)
+	if true:
+		# May reuse the stack slot of the object above.
+		var reused: int = total * 2
+		print(reused)
+
+	var untyped = i + 0.5
+	print(untyped)
+	untyped = i - 1
+	print(untyped)
+
+	member = i * 2
+	print(member)
+	print(triple(4))
+
+	var vector := Vector2(1, 2)
+	vector = vector * 2.0
+	print(vector)
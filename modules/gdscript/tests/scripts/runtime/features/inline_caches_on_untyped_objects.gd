@@ -0,0 +1,57 @@
+# Property accesses and calls on untyped objects cache what the name resolved to,
+# and must still behave the same for every kind of object reaching the same instruction.
+
+class A:
+	var value := 1
+	var typed: float = 0.0
+	var with_setter := 0:
+		set(new_value):
+			with_setter = new_value * 2
+
+	func describe():
+		return "A %d" % value
+
+class B extends A:
+	var extra := "b"
+
+	func describe():
+		return "B %d %s" % [value, extra]
+
+class C:
+	var value := "c"
+
+	func describe():
+		return "C " + value
+
+func read_value(object):
+	return object.value
+
+func describe(object):
+	return object.describe()
+
+func test():
+	var objects = [A.new(), B.new(), C.new(), A.new()]
+	for object in objects:
+		print(read_value(object))
+	for object in objects:
+		print(describe(object))
+
+	var a = A.new()
+	for i in 3:
+		a.value = i
+		a.with_setter = i
+		print(a.value, " ", a.with_setter)
+
+	# Assigning an `int` to a `float` member is converted by the instance.
+	for i in 2:
+		a.typed = i + 1
+		print(type_string(typeof(a.typed)), " ", a.typed)
+
+	# Native methods, on objects with and without scripts.
+	var nodes = [Node.new(), Node2D.new(), a]
+	for node in nodes:
+		print(node.get_class())
+	for i in 2:
+		var node = nodes[i]
+		node.free()
+	print(is_instance_valid(nodes[0]), " ", is_instance_valid(nodes[1]))
@@ -0,0 +1,66 @@
+# Operators on typed `int`, `float` and `Vector3` values are done by the VM without calling the evaluator.
+
+var member: float
+
+func count_down(from: int) -> int:
+	var steps := 0
+	while from > 0:
+		from = from - 3
+		steps = steps + 1
+	return steps
+
+func test():
+	var a := 7
+	var b := 3
+	print(a + b, " ", a - b, " ", a * b)
+	print(a * -b - a)
+
+	var x := 7.5
+	var y := 2.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+
+	var zero := 0.0
+	print(1.0 / zero)
+	var nan_value := zero / zero
+	if nan_value != nan_value:
+		print("nan is not equal to itself")
+	if nan_value < 1.0:
+		print("wrong")
+	else:
+		print("nan is unordered")
+
+	for i in 4:
+		var value: int = i
+		if value == 2:
+			print("equal")
+		if value != 2:
+			print("not equal")
+		if value <= 1:
+			print("less or equal")
+		if value >= 3:
+			print("greater or equal")
+
+	print(count_down(10))
+
+	var elapsed := 0.0
+	while elapsed < 1.0:
+		elapsed = elapsed + 0.25
+	print(elapsed)
+
+	member = x * 2.0
+	print(member)
+
+	var p := Vector3(1, 2, 3)
+	var q := Vector3(0.5, 0.5, 0.5)
+	var factor := 2.0
+	print(p + q, " ", p - q, " ", p * factor)
+	var offset := Vector3.ZERO
+	for _i in 3:
+		offset = offset + q * factor
+	print(offset)
+
+	var untyped = "text"
+	untyped = a * b
+	print(untyped)
+	untyped = x - y
+	print(untyped)
@@ -0,0 +1,240 @@
+/**************************************************************************/
+/*  test_gdscript_benchmarks.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "modules/gdscript/gdscript.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+// These are benchmarks rather than tests, so they're skipped by default.
+// Run them with: `--test --no-skip --test-case="*[Benchmark]*"`.
+// Compare the times printed before and after a change to the VM or the code generator.
+
+inline Ref<GDScript> load_benchmark_script(const String &p_source) {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	return err == OK ? script : Ref<GDScript>();
+}
+
+inline void run_benchmark_script(const char *p_name, const String &p_source, const Variant &p_expected) {
+	const Ref<GDScript> script = load_benchmark_script(p_source);
+	REQUIRE(script.is_valid());
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(script);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const Variant result = ref_counted->call("run");
+	print_line(vformat("%s: %d usec.", p_name, OS::get_singleton()->get_ticks_usec() - begin));
+	CHECK(result == p_expected);
+}
+
+// Typed and untyped versions of the same code, to compare the typed instructions against the generic ones.
+TEST_CASE("[Modules][GDScript][Benchmark] Typed and untyped loops" * doctest::skip()) {
+	run_benchmark_script("Typed while loop with comparisons", R"(
+extends RefCounted
+
+func run() -> int:
+	var i := 0
+	var total := 0
+	while i < 5000000:
+		if i % 3 == 0:
+			total = total + i
+		i = i + 1
+	return total
+)",
+			(int64_t)4166665833333);
+
+	run_benchmark_script("Untyped while loop with comparisons", R"(
+extends RefCounted
+
+func run():
+	var i = 0
+	var total = 0
+	while i < 5000000:
+		if i % 3 == 0:
+			total = total + i
+		i = i + 1
+	return total
+)",
+			(int64_t)4166665833333);
+
+	run_benchmark_script("Typed float arithmetic", R"(
+extends RefCounted
+
+func run() -> int:
+	var x := 0.0
+	var sum := 0.0
+	var v := Vector2i()
+	for _i in 2000000:
+		x = x * 0.5 + 1.0
+		sum = sum + x
+		v = v + Vector2i(1, -1)
+	return roundi(sum) + v.x - v.y
+)",
+			7999998);
+
+	run_benchmark_script("Untyped float arithmetic", R"(
+extends RefCounted
+
+func run():
+	var x = 0.0
+	var sum = 0.0
+	var v = Vector2i()
+	for _i in 2000000:
+		x = x * 0.5 + 1.0
+		sum = sum + x
+		v = v + Vector2i(1, -1)
+	return roundi(sum) + v.x - v.y
+)",
+			7999998);
+
+	run_benchmark_script("Typed float comparisons", R"(
+extends RefCounted
+
+func run() -> int:
+	var position := 0.0
+	var bounces := 0
+	var speed := 0.75
+	for _i in 2000000:
+		position = position + speed
+		if position >= 100.0:
+			speed = -0.75
+			bounces = bounces + 1
+		elif position <= 0.0:
+			speed = 0.75
+	return bounces
+)",
+			7463);
+
+	run_benchmark_script("Untyped float comparisons", R"(
+extends RefCounted
+
+func run():
+	var position = 0.0
+	var bounces = 0
+	var speed = 0.75
+	for _i in 2000000:
+		position = position + speed
+		if position >= 100.0:
+			speed = -0.75
+			bounces = bounces + 1
+		elif position <= 0.0:
+			speed = 0.75
+	return bounces
+)",
+			7463);
+}
+
+// Calls and property accesses on objects of unknown type, which go through the inline caches.
+TEST_CASE("[Modules][GDScript][Benchmark] Duck-typed objects" * doctest::skip()) {
+	run_benchmark_script("Untyped script members and methods", R"(
+extends RefCounted
+
+class Counter:
+	var count := 0
+
+	func add(amount):
+		count += amount
+
+func run():
+	var counter = Counter.new()
+	for i in 1000000:
+		counter.add(1)
+		counter.count = counter.count + 1
+	return counter.count
+)",
+			2000000);
+
+	run_benchmark_script("Untyped native methods", R"(
+extends RefCounted
+
+func run():
+	var object = RefCounted.new()
+	var total = 0
+	for i in 1000000:
+		total += object.get_reference_count()
+	return total
+)",
+			1000000);
+}
+
+// Many coroutines awaiting the same signal, like game objects waiting for the next frame.
+TEST_CASE("[Modules][GDScript][Benchmark] Awaiting coroutines" * doctest::skip()) {
+	const Ref<GDScript> script = load_benchmark_script(R"(
+extends RefCounted
+
+signal tick
+
+var resumed := 0
+
+func behave():
+	var position := Vector2()
+	var velocity := Vector2(1, 0)
+	for i in 100:
+		await tick
+		position += velocity
+		resumed += 1
+
+func run():
+	for i in 1000:
+		behave()
+	for i in 100:
+		tick.emit()
+	return resumed
+)");
+	REQUIRE(script.is_valid());
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(script);
+
+#ifdef DEBUG_ENABLED
+	uint64_t allocations = 0;
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		allocations -= Memory::get_tag_usage(Memory::Tag(i)).total_allocations;
+	}
+#endif
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const int resumed = ref_counted->call("run");
+	print_line(vformat("Resumed %d coroutines: %d usec.", resumed, OS::get_singleton()->get_ticks_usec() - begin));
+#ifdef DEBUG_ENABLED
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		allocations += Memory::get_tag_usage(Memory::Tag(i)).total_allocations;
+	}
+	print_line(vformat("%.2f allocations per resumed coroutine.", double(allocations) / MAX(resumed, 1)));
+#endif
+	CHECK(resumed == 100000);
+}
+
+} // namespace GDScriptTests
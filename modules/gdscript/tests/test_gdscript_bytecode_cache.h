@@ -0,0 +1,221 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_cache.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "modules/gdscript/gdscript_bytecode_cache.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+const char *TEST_SOURCE = R"(
+extends RefCounted
+
+const OFFSET = 10
+
+class Inner:
+	var value := 3
+
+	func twice() -> int:
+		return value * 2
+
+func compute(values: Array) -> int:
+	var add := func(a, b): return a + b
+	var total = 0
+	for value in values:
+		total = add.call(total, value)
+	assert(total == 6)
+	return total + OFFSET + Inner.new().twice()
+)";
+
+#ifdef DEBUG_ENABLED
+const bool DEBUG_BUILD = true;
+#else
+const bool DEBUG_BUILD = false;
+#endif
+
+Ref<GDScript> compile_script(const String &p_source) {
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	return err == OK ? script : Ref<GDScript>();
+}
+
+Variant run_compute(const Ref<GDScript> &p_script) {
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(p_script);
+	Array values = { 1, 2, 3 };
+	return ref_counted->call("compute", values);
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache round trip") {
+	GDScriptLanguage::get_singleton()->init();
+	const Ref<GDScript> script = compile_script(TEST_SOURCE);
+	REQUIRE(script.is_valid());
+	REQUIRE(int(run_compute(script)) == 22);
+
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(TEST_SOURCE, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	const Vector<uint8_t> cache = GDScriptBytecodeCache::save(script, tokens, DEBUG_BUILD, GDScriptTokenizerBuffer::COMPRESS_ZSTD);
+	REQUIRE_MESSAGE(!cache.is_empty(), "The script should be cacheable.");
+
+	const Vector<uint8_t> contents = GDScriptBytecodeCache::open(cache, tokens);
+	REQUIRE(!contents.is_empty());
+
+	// Without any source code, the script can only be valid if it was loaded from the cache.
+	Ref<GDScript> loaded = memnew(GDScript);
+	loaded->set_bytecode_cache(contents);
+	CHECK(loaded->reload() == OK);
+	CHECK(loaded->is_valid());
+	CHECK(loaded->get_subclasses().has("Inner"));
+	CHECK_MESSAGE(int(run_compute(loaded)) == 22, "The cached bytecode should run like the compiled one.");
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache is rejected for other binary tokens") {
+	GDScriptLanguage::get_singleton()->init();
+	const Ref<GDScript> script = compile_script(TEST_SOURCE);
+	REQUIRE(script.is_valid());
+
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(TEST_SOURCE, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	const Vector<uint8_t> cache = GDScriptBytecodeCache::save(script, tokens, DEBUG_BUILD, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	REQUIRE(!cache.is_empty());
+	CHECK(!GDScriptBytecodeCache::open(cache, tokens).is_empty());
+
+	const Vector<uint8_t> other_tokens = GDScriptTokenizerBuffer::parse_code_string(String(TEST_SOURCE) + "\nvar other = 1\n", GDScriptTokenizerBuffer::COMPRESS_NONE);
+	CHECK(GDScriptBytecodeCache::open(cache, other_tokens).is_empty());
+	CHECK_MESSAGE(GDScriptBytecodeCache::open(cache, Vector<uint8_t>()).is_empty(), "Caches without binary tokens should never be used.");
+
+	// Caches made for the other kind of build are rejected too.
+	const Vector<uint8_t> other_build_cache = GDScriptBytecodeCache::save(script, tokens, !DEBUG_BUILD, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	CHECK(GDScriptBytecodeCache::open(other_build_cache, tokens).is_empty());
+}
+
+TEST_CASE("[Modules][GDScript] Typed functions are translated to C++ along with the bytecode cache") {
+	const String source = R"(
+extends RefCounted
+
+var member := 1
+
+func sum(count: int) -> int:
+	var total := 0
+	for i in count:
+		if i % 2 == 0:
+			total += i * 2
+	return total
+
+func uses_member() -> int:
+	return member + 1
+
+func distance(a: Vector2, b: Vector2) -> float:
+	return a.distance_to(b)
+
+func clamped(value: float) -> float:
+	return clampf(value, 0.0, 1.0)
+
+func rotation_of(node: Node2D) -> float:
+	return node.get_rotation()
+
+func untyped(object):
+	return object.get_value()
+)";
+	GDScriptLanguage::get_singleton()->init();
+	const Ref<GDScript> script = compile_script(source);
+	REQUIRE(script.is_valid());
+
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	GDScriptNativeCode::Writer writer;
+	REQUIRE(!GDScriptBytecodeCache::save(script, tokens, DEBUG_BUILD, GDScriptTokenizerBuffer::COMPRESS_NONE, &writer).is_empty());
+
+	const String code = writer.get_code();
+	CHECK(writer.get_function_count() == 5);
+	CHECK(code.contains("::sum()"));
+	CHECK_MESSAGE(code.contains("::uses_member()"), "Functions using members should be translated.");
+	CHECK_MESSAGE(code.contains("::distance()"), "Functions calling methods of builtin types should be translated.");
+	CHECK_MESSAGE(code.contains("::clamped()"), "Functions calling utility functions should be translated.");
+	CHECK_MESSAGE(code.contains("::rotation_of()"), "Functions calling native methods should be translated.");
+	CHECK_MESSAGE(!code.contains("::untyped()"), "Functions with untyped calls should be left to the VM.");
+	CHECK(code.contains("GDScriptNativeCode::get_builtin_method(function, 0)"));
+	CHECK(code.contains("GDScriptNativeCode::get_utility(function, 0)"));
+	CHECK(code.contains("GDScriptNativeCode::get_method(function, 0)->validated_call(base, args, &"));
+	CHECK(code.contains("void register_gdscript_native_code() {"));
+
+	// The translated calls find their functions in the tables the VM uses, which are filled when loading.
+	const GDScriptFunction *distance = script->get_member_functions()["distance"];
+	const GDScriptFunction *clamped = script->get_member_functions()["clamped"];
+	const GDScriptFunction *rotation_of = script->get_member_functions()["rotation_of"];
+	CHECK(GDScriptNativeCode::get_builtin_method(distance, 0) == Variant::get_validated_builtin_method(Variant::VECTOR2, "distance_to"));
+	CHECK(GDScriptNativeCode::get_utility(clamped, 0) == Variant::get_validated_utility_function("clampf"));
+	CHECK(GDScriptNativeCode::get_method(rotation_of, 0) == ClassDB::get_method("Node2D", "get_rotation"));
+
+	// Calls on null print the same error as the VM instead of crashing.
+	ERR_PRINT_OFF;
+	CHECK(GDScriptNativeCode::get_call_base(Variant(), rotation_of, 0) == nullptr);
+	ERR_PRINT_ON;
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[Modules][GDScript][Benchmark] Loading from the bytecode cache" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const Ref<GDScript> script = compile_script(TEST_SOURCE);
+	REQUIRE(script.is_valid());
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(TEST_SOURCE, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	const Vector<uint8_t> contents = GDScriptBytecodeCache::open(GDScriptBytecodeCache::save(script, tokens, DEBUG_BUILD, GDScriptTokenizerBuffer::COMPRESS_NONE), tokens);
+	REQUIRE(!contents.is_empty());
+
+	const int iterations = 1000;
+	int loaded = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Ref<GDScript> compiled = memnew(GDScript);
+		compiled->set_binary_tokens_source(tokens);
+		loaded += compiled->reload() == OK;
+	}
+	const uint64_t compile_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Ref<GDScript> cached = memnew(GDScript);
+		cached->set_bytecode_cache(contents);
+		loaded += cached->reload() == OK;
+	}
+	const uint64_t cache_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("Loaded a script %d times: %d usec from binary tokens, %d usec from the bytecode cache.", iterations, compile_usec, cache_usec));
+	CHECK(loaded == iterations * 2);
+}
+
+} // namespace GDScriptTests
+
+#endif // TOOLS_ENABLED
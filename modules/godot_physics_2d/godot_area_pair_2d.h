@@ -49,6 +49,15 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual Key get_key() const override {
+		Key key;
+		key.ids[0] = body->get_self().get_id();
+		key.ids[1] = area->get_self().get_id();
+		key.shapes[0] = body_shape;
+		key.shapes[1] = area_shape;
+		return key;
+	}
+
 	GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotArea2D *p_area, int p_area_shape);
 	~GodotAreaPair2D();
 };
@@ -70,6 +79,15 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual Key get_key() const override {
+		Key key;
+		key.ids[0] = area_a->get_self().get_id();
+		key.ids[1] = area_b->get_self().get_id();
+		key.shapes[0] = shape_a;
+		key.shapes[1] = shape_b;
+		return key;
+	}
+
 	GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotArea2D *p_area_b, int p_shape_b);
 	~GodotArea2Pair2D();
 };
@@ -720,6 +720,82 @@ bool GodotBody2D::sleep_test(real_t p_step) {
 	}
 }
 
+static real_t *_save_transform(const Transform2D &p_transform, real_t *r_state) {
+	for (int i = 0; i < 3; i++) {
+		*r_state++ = p_transform.columns[i].x;
+		*r_state++ = p_transform.columns[i].y;
+	}
+	return r_state;
+}
+
+static const real_t *_load_transform(const real_t *p_state, Transform2D &r_transform) {
+	for (int i = 0; i < 3; i++) {
+		r_transform.columns[i].x = *p_state++;
+		r_transform.columns[i].y = *p_state++;
+	}
+	return p_state;
+}
+
+void GodotBody2D::save_state(real_t *r_state) const {
+	real_t *w = _save_transform(get_transform(), r_state);
+	w = _save_transform(get_inv_transform(), w);
+	w = _save_transform(new_transform, w);
+	*w++ = linear_velocity.x;
+	*w++ = linear_velocity.y;
+	*w++ = angular_velocity;
+	*w++ = prev_linear_velocity.x;
+	*w++ = prev_linear_velocity.y;
+	*w++ = prev_angular_velocity;
+	*w++ = constant_linear_velocity.x;
+	*w++ = constant_linear_velocity.y;
+	*w++ = constant_angular_velocity;
+	*w++ = applied_force.x;
+	*w++ = applied_force.y;
+	*w++ = applied_torque;
+	*w++ = constant_force.x;
+	*w++ = constant_force.y;
+	*w++ = constant_torque;
+	*w++ = still_time;
+	*w++ = active;
+	DEV_ASSERT(w - r_state == STATE_SIZE);
+}
+
+void GodotBody2D::load_state(const real_t *p_state) {
+	Transform2D transform;
+	Transform2D inv_transform;
+	const real_t *r = _load_transform(p_state, transform);
+	r = _load_transform(r, inv_transform);
+	r = _load_transform(r, new_transform);
+	linear_velocity.x = *r++;
+	linear_velocity.y = *r++;
+	angular_velocity = *r++;
+	prev_linear_velocity.x = *r++;
+	prev_linear_velocity.y = *r++;
+	prev_angular_velocity = *r++;
+	constant_linear_velocity.x = *r++;
+	constant_linear_velocity.y = *r++;
+	constant_angular_velocity = *r++;
+	applied_force.x = *r++;
+	applied_force.y = *r++;
+	applied_torque = *r++;
+	constant_force.x = *r++;
+	constant_force.y = *r++;
+	constant_torque = *r++;
+	still_time = *r++;
+	const bool was_active = *r++ != 0;
+	DEV_ASSERT(r - p_state == STATE_SIZE);
+
+	_set_transform(transform);
+	_set_inv_transform(inv_transform);
+	_update_transform_dependent();
+	set_active(was_active);
+
+	// Let the node know about its new state when the queries are flushed, like after a step.
+	if (get_space() && mode != PhysicsServer2D::BODY_MODE_STATIC && (fi_callback_data || body_state_callback.is_valid()) && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody2D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -336,6 +336,19 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Orders bodies by RID, which unlike their address is the same in every run that creates them in the same order.
+	struct RIDComparator {
+		_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const { return p_a->get_self() < p_b->get_self(); }
+	};
+
+	enum {
+		STATE_SIZE = 35
+	};
+
+	// Everything that changes when the body is stepped, which is saved in space snapshots.
+	void save_state(real_t *r_state) const;
+	void load_state(const real_t *p_state);
+
 	GodotBody2D();
 	~GodotBody2D();
 };
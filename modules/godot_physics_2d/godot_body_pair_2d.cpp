@@ -593,6 +593,139 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint2D::Key GodotBodyPair2D::get_key() const {
+	Key key;
+	key.ids[0] = A->get_self().get_id();
+	key.ids[1] = B->get_self().get_id();
+	key.shapes[0] = shape_A;
+	key.shapes[1] = shape_B;
+	return key;
+}
+
+static Rect2 _get_shape_bounds(const GodotBody2D *p_body, int p_shape, real_t p_step) {
+	// Unlike the bounds in the broadphase, these don't depend on the previous ones.
+	const Rect2 bounds = (p_body->get_transform() * p_body->get_shape_transform(p_shape)).xform(p_body->get_shape(p_shape)->get_aabb());
+	if (p_body->get_continuous_collision_detection_mode() == PhysicsServer2D::CCD_MODE_DISABLED) {
+		return bounds;
+	}
+	// Continuous collision detection also looks for contacts along the motion.
+	return bounds.merge(Rect2(bounds.position + p_body->get_motion(), bounds.size)).merge(Rect2(bounds.position + p_body->get_linear_velocity() * p_step, bounds.size));
+}
+
+bool GodotBodyPair2D::is_in_range(real_t p_step) const {
+	return _get_shape_bounds(A, shape_A, p_step).intersects(_get_shape_bounds(B, shape_B, p_step), true);
+}
+
+// Each contact is saved as 25 values, after the 11 values of the pair.
+#define PAIR_STATE_SIZE 11
+#define CONTACT_STATE_SIZE 25
+
+int GodotBodyPair2D::save_state(real_t *r_state) const {
+	real_t *w = r_state;
+	*w++ = offset_B.x;
+	*w++ = offset_B.y;
+	*w++ = sep_axis.x;
+	*w++ = sep_axis.y;
+	*w++ = collide_A;
+	*w++ = collide_B;
+	*w++ = collided;
+	*w++ = check_ccd;
+	*w++ = oneway_disabled;
+	*w++ = report_contacts_only;
+	*w++ = contact_count;
+
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		*w++ = c.position.x;
+		*w++ = c.position.y;
+		*w++ = c.normal.x;
+		*w++ = c.normal.y;
+		*w++ = c.local_A.x;
+		*w++ = c.local_A.y;
+		*w++ = c.local_B.x;
+		*w++ = c.local_B.y;
+		*w++ = c.acc_impulse.x;
+		*w++ = c.acc_impulse.y;
+		*w++ = c.acc_normal_impulse;
+		*w++ = c.acc_tangent_impulse;
+		*w++ = c.acc_bias_impulse;
+		*w++ = c.acc_bias_impulse_center_of_mass;
+		*w++ = c.mass_normal;
+		*w++ = c.mass_tangent;
+		*w++ = c.bias;
+		*w++ = c.depth;
+		*w++ = c.active;
+		*w++ = c.used;
+		*w++ = c.rA.x;
+		*w++ = c.rA.y;
+		*w++ = c.rB.x;
+		*w++ = c.rB.y;
+		*w++ = c.bounce;
+	}
+
+	return w - r_state;
+}
+
+void GodotBodyPair2D::load_state(const real_t *p_state, int p_size) {
+	ERR_FAIL_COND(p_size < PAIR_STATE_SIZE);
+	const int count = p_state[PAIR_STATE_SIZE - 1];
+	ERR_FAIL_COND(count < 0 || count > MAX_CONTACTS || p_size != PAIR_STATE_SIZE + count * CONTACT_STATE_SIZE);
+
+	const real_t *r = p_state;
+	offset_B.x = *r++;
+	offset_B.y = *r++;
+	sep_axis.x = *r++;
+	sep_axis.y = *r++;
+	collide_A = *r++ != 0;
+	collide_B = *r++ != 0;
+	collided = *r++ != 0;
+	check_ccd = *r++ != 0;
+	oneway_disabled = *r++ != 0;
+	report_contacts_only = *r++ != 0;
+	contact_count = *r++;
+
+	for (int i = 0; i < contact_count; i++) {
+		Contact &c = contacts[i];
+		c.position.x = *r++;
+		c.position.y = *r++;
+		c.normal.x = *r++;
+		c.normal.y = *r++;
+		c.local_A.x = *r++;
+		c.local_A.y = *r++;
+		c.local_B.x = *r++;
+		c.local_B.y = *r++;
+		c.acc_impulse.x = *r++;
+		c.acc_impulse.y = *r++;
+		c.acc_normal_impulse = *r++;
+		c.acc_tangent_impulse = *r++;
+		c.acc_bias_impulse = *r++;
+		c.acc_bias_impulse_center_of_mass = *r++;
+		c.mass_normal = *r++;
+		c.mass_tangent = *r++;
+		c.bias = *r++;
+		c.depth = *r++;
+		c.active = *r++ != 0;
+		c.used = *r++ != 0;
+		c.rA.x = *r++;
+		c.rA.y = *r++;
+		c.rB.x = *r++;
+		c.rB.y = *r++;
+		c.bounce = *r++;
+	}
+}
+
+void GodotBodyPair2D::clear_state() {
+	offset_B = Vector2();
+	sep_axis = Vector2();
+	collide_A = false;
+	collide_B = false;
+	collided = false;
+	check_ccd = false;
+	oneway_disabled = false;
+	report_contacts_only = false;
+	contact_count = 0;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
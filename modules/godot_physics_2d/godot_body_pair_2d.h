@@ -93,6 +93,12 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual Key get_key() const override;
+	virtual bool is_in_range(real_t p_step) const override;
+	virtual int save_state(real_t *r_state) const override;
+	virtual void load_state(const real_t *p_state, int p_size) override;
+	virtual void clear_state() override;
+
 	GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B);
 	~GodotBodyPair2D();
 };
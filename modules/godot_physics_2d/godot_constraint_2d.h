@@ -47,6 +47,39 @@ protected:
 	}
 
 public:
+	// Identifies a constraint by the RIDs and shape indices of the objects it links, or by its own RID for joints.
+	// Unlike pointers, keys don't change from one run to the next, so they're used to order the constraints of
+	// deterministic spaces, and to find them again when restoring a snapshot.
+	struct Key {
+		uint64_t ids[2] = {};
+		int shapes[2] = {};
+
+		bool operator==(const Key &p_key) const { return ids[0] == p_key.ids[0] && ids[1] == p_key.ids[1] && shapes[0] == p_key.shapes[0] && shapes[1] == p_key.shapes[1]; }
+		bool operator<(const Key &p_key) const {
+			if (ids[0] != p_key.ids[0]) {
+				return ids[0] < p_key.ids[0];
+			}
+			if (ids[1] != p_key.ids[1]) {
+				return ids[1] < p_key.ids[1];
+			}
+			if (shapes[0] != p_key.shapes[0]) {
+				return shapes[0] < p_key.shapes[0];
+			}
+			return shapes[1] < p_key.shapes[1];
+		}
+		uint32_t hash() const {
+			uint32_t h = hash_murmur3_one_64(ids[0]);
+			h = hash_murmur3_one_64(ids[1], h);
+			h = hash_murmur3_one_32(shapes[0], h);
+			h = hash_murmur3_one_32(shapes[1], h);
+			return hash_fmix32(h);
+		}
+	};
+
+	struct KeyComparator {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const { return p_a->get_key() < p_b->get_key(); }
+	};
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -63,5 +96,26 @@ public:
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	virtual Key get_key() const {
+		Key key;
+		key.ids[0] = self.get_id();
+		return key;
+	}
+
+	// Deterministic spaces skip the constraints that can't act this step, as if they didn't exist, because
+	// the broadphase keeps pairs for a while after they stop overlapping, depending on its history.
+	virtual bool is_in_range(real_t p_step) const { return true; }
+
+	enum {
+		STATE_SIZE_MAX = 64
+	};
+
+	// Solver state carried over from one step to the next, like accumulated impulses, which is saved in space snapshots.
+	// `save_state()` returns the number of values it wrote, `load_state()` gets them back, and `clear_state()` resets
+	// the state to what it is when the constraint is created.
+	virtual int save_state(real_t *r_state) const { return 0; }
+	virtual void load_state(const real_t *p_state, int p_size) {}
+	virtual void clear_state() {}
+
 	virtual ~GodotConstraint2D() {}
 };
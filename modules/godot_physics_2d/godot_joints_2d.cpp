@@ -256,6 +256,24 @@ void GodotPinJoint2D::solve(real_t p_step) {
 	P += impulse;
 }
 
+int GodotPinJoint2D::save_state(real_t *r_state) const {
+	r_state[0] = P.x;
+	r_state[1] = P.y;
+	r_state[2] = j_acc;
+	return 3;
+}
+
+void GodotPinJoint2D::load_state(const real_t *p_state, int p_size) {
+	ERR_FAIL_COND(p_size != 3);
+	P = Vector2(p_state[0], p_state[1]);
+	j_acc = p_state[2];
+}
+
+void GodotPinJoint2D::clear_state() {
+	P = Vector2();
+	j_acc = 0.0;
+}
+
 void GodotPinJoint2D::set_param(PhysicsServer2D::PinJointParam p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::PIN_JOINT_SOFTNESS: {
@@ -470,6 +488,21 @@ void GodotGrooveJoint2D::solve(real_t p_step) {
 	}
 }
 
+int GodotGrooveJoint2D::save_state(real_t *r_state) const {
+	r_state[0] = jn_acc.x;
+	r_state[1] = jn_acc.y;
+	return 2;
+}
+
+void GodotGrooveJoint2D::load_state(const real_t *p_state, int p_size) {
+	ERR_FAIL_COND(p_size != 2);
+	jn_acc = Vector2(p_state[0], p_state[1]);
+}
+
+void GodotGrooveJoint2D::clear_state() {
+	jn_acc = Vector2();
+}
+
 GodotGrooveJoint2D::GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b) :
 		GodotJoint2D(_arr, 2) {
 	A = p_body_a;
@@ -108,6 +108,10 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual int save_state(real_t *r_state) const override;
+	virtual void load_state(const real_t *p_state, int p_size) override;
+	virtual void clear_state() override;
+
 	void set_param(PhysicsServer2D::PinJointParam p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::PinJointParam p_param) const;
 
@@ -148,6 +152,10 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual int save_state(real_t *r_state) const override;
+	virtual void load_state(const real_t *p_state, int p_size) override;
+	virtual void clear_state() override;
+
 	GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b);
 };
 
@@ -36,7 +36,9 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
 	ERR_FAIL_COND_MSG(m_object->get_space() && flushing_queries, "Can't change this state while flushing queries. Use call_deferred() or set_deferred() to change monitoring state instead.");
@@ -276,6 +278,30 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+void GodotPhysicsServer2D::space_set_deterministic(RID p_space, bool p_enabled) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	space->set_deterministic(p_enabled);
+}
+
+bool GodotPhysicsServer2D::space_is_deterministic(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	return space->is_deterministic();
+}
+
+Vector<uint8_t> GodotPhysicsServer2D::space_get_snapshot(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	return space->save_snapshot();
+}
+
+Error GodotPhysicsServer2D::space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, ERR_INVALID_PARAMETER);
+	return space->restore_snapshot(p_snapshot);
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL_V(space, nullptr);
@@ -1287,18 +1313,56 @@ void GodotPhysicsServer2D::init() {
 	stepper = memnew(GodotStep2D);
 }
 
+void GodotPhysicsServer2D::_step_space(uint32_t p_index, void *p_userdata) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_PHYSICS);
+	GodotProfileZone("GodotPhysicsServer2D::_step_space");
+	space_steppers[p_index]->step(stepped_spaces[p_index], stepped_delta, false);
+}
+
 void GodotPhysicsServer2D::step(real_t p_step) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_PHYSICS);
+	GodotProfileZone("GodotPhysicsServer2D::step");
 	if (!active) {
 		return;
 	}
 
 	_update_shapes();
 
+	if (active_spaces.size() > 1) {
+		// Spaces don't share bodies, areas or constraints, so they can be stepped at the same time.
+		// The busiest space is stepped by this thread, which solves its islands on the worker threads.
+		// The other spaces are stepped by a task each, which solves their islands by itself, since
+		// a worker thread waiting for more tasks could keep them from running.
+		GodotSpace2D *busiest_space = nullptr;
+		stepped_spaces.clear();
+		for (GodotSpace2D *E : active_spaces) {
+			if (busiest_space && E->get_active_objects() <= busiest_space->get_active_objects()) {
+				stepped_spaces.push_back(E);
+				continue;
+			}
+			if (busiest_space) {
+				stepped_spaces.push_back(busiest_space);
+			}
+			busiest_space = E;
+		}
+		while (space_steppers.size() < stepped_spaces.size()) {
+			space_steppers.push_back(memnew(GodotStep2D));
+		}
+		stepped_delta = p_step;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer2D::_step_space, nullptr, stepped_spaces.size(), -1, true, SNAME("Physics2DStepSpaces"));
+		stepper->step(busiest_space, p_step);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (GodotSpace2D *E : active_spaces) {
+			stepper->step(E, p_step);
+		}
+	}
+
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
-	for (GodotSpace2D *E : active_spaces) {
-		stepper->step(E, p_step);
+	for (const GodotSpace2D *E : active_spaces) {
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1364,6 +1428,10 @@ void GodotPhysicsServer2D::end_sync() {
 
 void GodotPhysicsServer2D::finish() {
 	memdelete(stepper);
+	for (GodotStep2D *E : space_steppers) {
+		memdelete(E);
+	}
+	space_steppers.clear();
 }
 
 void GodotPhysicsServer2D::_update_shapes() {
@@ -57,6 +57,12 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	GodotStep2D *stepper = nullptr;
 	HashSet<GodotSpace2D *> active_spaces;
 
+	// When several spaces are active, they're stepped in parallel, each by its own stepper.
+	LocalVector<GodotStep2D *> space_steppers;
+	LocalVector<GodotSpace2D *> stepped_spaces;
+	real_t stepped_delta = 0.0;
+	void _step_space(uint32_t p_index, void *p_userdata = nullptr);
+
 	mutable RID_PtrOwner<GodotShape2D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace2D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea2D, true> area_owner;
@@ -115,6 +121,11 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual void space_set_deterministic(RID p_space, bool p_enabled) override;
+	virtual bool space_is_deterministic(RID p_space) const override;
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const override;
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
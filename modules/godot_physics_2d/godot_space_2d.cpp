@@ -34,6 +34,7 @@
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
 
@@ -1035,7 +1036,21 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 		}
 
 	} else {
+		if (self->deterministic && (B->get_self() < A->get_self() || (A == B && p_subindex_B < p_subindex_A))) {
+			// The broadphase order depends on its history, which isn't restored with snapshots.
+			SWAP(A, B);
+			SWAP(p_subindex_A, p_subindex_B);
+		}
+
 		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
+
+		if (!self->pending_constraint_states.is_empty()) {
+			HashMap<GodotConstraint2D::Key, LocalVector<real_t>>::Iterator E = self->pending_constraint_states.find(b->get_key());
+			if (E) {
+				b->load_state(E->value.ptr(), E->value.size());
+				self->pending_constraint_states.remove(E);
+			}
+		}
 		return b;
 	}
 }
@@ -1142,6 +1157,9 @@ void GodotSpace2D::setup() {
 
 void GodotSpace2D::update() {
 	broadphase->update();
+
+	// Pairs from a restored snapshot are created by the first update, if at all.
+	pending_constraint_states.clear();
 }
 
 void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value) {
@@ -1212,6 +1230,187 @@ bool GodotSpace2D::is_locked() const {
 	return locked;
 }
 
+#define SNAPSHOT_FORMAT_VERSION 1
+#define SNAPSHOT_HEADER_SIZE 16
+#define SNAPSHOT_BODY_SIZE (8 + GodotBody2D::STATE_SIZE * sizeof(real_t))
+#define SNAPSHOT_CONSTRAINT_HEADER_SIZE 28
+
+static real_t _decode_real(const uint8_t *p_arr) {
+#ifdef REAL_T_IS_DOUBLE
+	return decode_double(p_arr);
+#else
+	return decode_float(p_arr);
+#endif
+}
+
+void GodotSpace2D::_get_constraints_with_state(LocalVector<GodotConstraint2D *> &r_constraints) const {
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		for (const Pair<GodotConstraint2D *, int> &E : static_cast<const GodotBody2D *>(object)->get_constraint_list()) {
+			// Every constraint has its first body at index 0, so this finds each of them once.
+			if (E.second == 0) {
+				r_constraints.push_back(E.first);
+			}
+		}
+	}
+}
+
+Vector<uint8_t> GodotSpace2D::save_snapshot() const {
+	LocalVector<GodotBody2D *> bodies;
+	for (GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<GodotBody2D *>(object));
+		}
+	}
+	LocalVector<GodotConstraint2D *> constraints;
+	_get_constraints_with_state(constraints);
+
+	// Sorted, so the snapshots of the same state are the same, and can be compared or hashed.
+	bodies.sort_custom<GodotBody2D::RIDComparator>();
+	constraints.sort_custom<GodotConstraint2D::KeyComparator>();
+
+	LocalVector<real_t> states;
+	LocalVector<uint32_t> state_sizes;
+	real_t state[GodotConstraint2D::STATE_SIZE_MAX];
+	uint32_t constraint_count = 0;
+	for (uint32_t i = 0; i < constraints.size(); i++) {
+		const int size = constraints[i]->save_state(state);
+		if (size == 0) {
+			continue; // Nothing to restore, like for area pairs.
+		}
+		constraints[constraint_count++] = constraints[i];
+		state_sizes.push_back(size);
+		for (int j = 0; j < size; j++) {
+			states.push_back(state[j]);
+		}
+	}
+	constraints.resize(constraint_count);
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(SNAPSHOT_HEADER_SIZE + bodies.size() * SNAPSHOT_BODY_SIZE + constraints.size() * SNAPSHOT_CONSTRAINT_HEADER_SIZE + states.size() * sizeof(real_t));
+	uint8_t *w = snapshot.ptrw();
+
+	w += encode_uint32(SNAPSHOT_FORMAT_VERSION, w);
+	w += encode_uint32(sizeof(real_t), w);
+	w += encode_uint32(bodies.size(), w);
+	w += encode_uint32(constraints.size(), w);
+
+	for (const GodotBody2D *body : bodies) {
+		w += encode_uint64(body->get_self().get_id(), w);
+		body->save_state(state);
+		for (int j = 0; j < GodotBody2D::STATE_SIZE; j++) {
+			w += encode_real(state[j], w);
+		}
+	}
+
+	const real_t *constraint_state = states.ptr();
+	for (uint32_t i = 0; i < constraints.size(); i++) {
+		const GodotConstraint2D::Key key = constraints[i]->get_key();
+		w += encode_uint64(key.ids[0], w);
+		w += encode_uint64(key.ids[1], w);
+		w += encode_uint32(key.shapes[0], w);
+		w += encode_uint32(key.shapes[1], w);
+		w += encode_uint32(state_sizes[i], w);
+		for (uint32_t j = 0; j < state_sizes[i]; j++) {
+			w += encode_real(*constraint_state++, w);
+		}
+	}
+
+	DEV_ASSERT(w == snapshot.ptr() + snapshot.size());
+	return snapshot;
+}
+
+Error GodotSpace2D::restore_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Can't restore a snapshot of a space while it's being stepped.");
+
+	const uint8_t *r = p_snapshot.ptr();
+	const uint8_t *end = r + p_snapshot.size();
+	ERR_FAIL_COND_V(end - r < SNAPSHOT_HEADER_SIZE, ERR_INVALID_DATA);
+	ERR_FAIL_COND_V_MSG(decode_uint32(r) != SNAPSHOT_FORMAT_VERSION || decode_uint32(r + 4) != sizeof(real_t), ERR_INVALID_DATA, "The snapshot was made by another build of the engine.");
+	const uint32_t body_count = decode_uint32(r + 8);
+	const uint32_t constraint_count = decode_uint32(r + 12);
+	r += SNAPSHOT_HEADER_SIZE;
+	ERR_FAIL_COND_V(uint64_t(end - r) < uint64_t(body_count) * SNAPSHOT_BODY_SIZE, ERR_INVALID_DATA);
+	const uint8_t *body_data = r;
+	r += body_count * SNAPSHOT_BODY_SIZE;
+
+	// Check the constraints before changing anything, so invalid snapshots are left out entirely.
+	const uint8_t *constraint_data = r;
+	for (uint32_t i = 0; i < constraint_count; i++) {
+		ERR_FAIL_COND_V(end - r < SNAPSHOT_CONSTRAINT_HEADER_SIZE, ERR_INVALID_DATA);
+		const uint32_t size = decode_uint32(r + 24);
+		r += SNAPSHOT_CONSTRAINT_HEADER_SIZE;
+		ERR_FAIL_COND_V(size > GodotConstraint2D::STATE_SIZE_MAX || uint64_t(end - r) < size * sizeof(real_t), ERR_INVALID_DATA);
+		r += size * sizeof(real_t);
+	}
+	ERR_FAIL_COND_V(r != end, ERR_INVALID_DATA);
+
+	HashMap<uint64_t, GodotBody2D *> bodies;
+	for (GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.insert(object->get_self().get_id(), static_cast<GodotBody2D *>(object));
+		}
+	}
+
+	real_t state[GodotConstraint2D::STATE_SIZE_MAX];
+	r = body_data;
+	for (uint32_t i = 0; i < body_count; i++) {
+		HashMap<uint64_t, GodotBody2D *>::Iterator E = bodies.find(decode_uint64(r));
+		r += 8;
+		if (E) {
+			for (int j = 0; j < GodotBody2D::STATE_SIZE; j++) {
+				state[j] = _decode_real(r + j * sizeof(real_t));
+			}
+			E->value->load_state(state);
+		}
+		// Bodies freed since the snapshot was made are skipped.
+		r += GodotBody2D::STATE_SIZE * sizeof(real_t);
+	}
+
+	LocalVector<GodotConstraint2D *> constraint_list;
+	_get_constraints_with_state(constraint_list);
+	HashMap<GodotConstraint2D::Key, GodotConstraint2D *> constraints;
+	for (GodotConstraint2D *constraint : constraint_list) {
+		constraints.insert(constraint->get_key(), constraint);
+	}
+
+	pending_constraint_states.clear();
+	r = constraint_data;
+	for (uint32_t i = 0; i < constraint_count; i++) {
+		GodotConstraint2D::Key key;
+		key.ids[0] = decode_uint64(r);
+		key.ids[1] = decode_uint64(r + 8);
+		key.shapes[0] = decode_uint32(r + 16);
+		key.shapes[1] = decode_uint32(r + 20);
+		const uint32_t size = decode_uint32(r + 24);
+		r += SNAPSHOT_CONSTRAINT_HEADER_SIZE;
+		for (uint32_t j = 0; j < size; j++) {
+			state[j] = _decode_real(r + j * sizeof(real_t));
+		}
+		r += size * sizeof(real_t);
+
+		HashMap<GodotConstraint2D::Key, GodotConstraint2D *>::Iterator E = constraints.find(key);
+		if (E) {
+			E->value->load_state(state, size);
+			constraints.remove(E);
+		} else {
+			// The pair will be created by the next broadphase update, since the bodies are back where they were.
+			LocalVector<real_t> &pending_state = pending_constraint_states[key];
+			pending_state.resize(size);
+			memcpy(pending_state.ptr(), state, size * sizeof(real_t));
+		}
+	}
+
+	// What's left didn't exist when the snapshot was made.
+	for (KeyValue<GodotConstraint2D::Key, GodotConstraint2D *> &E : constraints) {
+		E.value->clear_state();
+	}
+
+	return OK;
+}
+
 GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
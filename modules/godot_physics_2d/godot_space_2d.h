@@ -34,6 +34,7 @@
 #include "godot_body_2d.h"
 #include "godot_broad_phase_2d.h"
 #include "godot_collision_object_2d.h"
+#include "godot_constraint_2d.h"
 
 #include "core/typedefs.h"
 
@@ -111,6 +112,12 @@ private:
 	real_t body_time_to_sleep = 0.0;
 
 	bool locked = false;
+	bool deterministic = false;
+
+	// State of the pairs that were in the last restored snapshot, but don't exist until the broadphase is updated.
+	HashMap<GodotConstraint2D::Key, LocalVector<real_t>> pending_constraint_states;
+
+	void _get_constraints_with_state(LocalVector<GodotConstraint2D *> &r_constraints) const;
 
 	real_t last_step = 0.001;
 
@@ -171,6 +178,16 @@ public:
 	void lock();
 	void unlock();
 
+	// Deterministic spaces step bodies and constraints in the order of their RIDs, instead of the order they
+	// were activated or paired in, so the same steps from the same snapshot give the same results.
+	void set_deterministic(bool p_enabled) { deterministic = p_enabled; }
+	bool is_deterministic() const { return deterministic; }
+
+	// Snapshots hold the state of the bodies and the solver state of the constraints between them.
+	// They can only be restored by the same build, in a space with the same bodies and joints.
+	Vector<uint8_t> save_snapshot() const;
+	Error restore_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	real_t get_last_step() const { return last_step; }
 	void set_last_step(real_t p_step) { last_step = p_step; }
 
@@ -32,6 +32,7 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
 #include "godot_constraint_2d.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
@@ -40,6 +41,19 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+SafeNumeric<uint64_t> GodotStep2D::last_step;
+
+void GodotStep2D::_get_active_bodies(const GodotSpace2D *p_space) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody2D> *b = p_space->get_active_body_list().first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+	if (deterministic) {
+		// The list is in the order the bodies were activated, which depends on the previous steps.
+		active_bodies.sort_custom<GodotBody2D::RIDComparator>();
+	}
+}
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -54,6 +68,11 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 			continue; // Already processed.
 		}
 		constraint->set_island_step(_step);
+		if (deterministic && !constraint->is_in_range(delta)) {
+			// Give it the state it would have if the broadphase had already removed it.
+			constraint->clear_state();
+			continue;
+		}
 		p_constraint_island.push_back(constraint);
 		all_constraints.push_back(constraint);
 
@@ -126,9 +145,11 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 	}
 }
 
-void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
+void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta, bool p_multithreaded) {
 	p_space->lock(); // can't access space during this
 
+	_step = last_step.increment();
+
 	p_space->setup(); //update inertias, etc
 
 	p_space->set_last_step(p_delta);
@@ -136,23 +157,24 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
 
-	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
+	// Deterministic spaces give the same order to bodies and constraints whatever order they were added in,
+	// so the results only depend on the state of the space. The islands don't share any dynamic body, so
+	// solving them on several threads doesn't change the results.
+	deterministic = p_space->is_deterministic();
 
 	/* INTEGRATE FORCES */
+	GodotProfileZoneGroupedFirst(_profile_zone, "integrate forces");
 
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_get_active_bodies(p_space);
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_forces(p_delta);
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -164,6 +186,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+	GodotProfileZoneGrouped(_profile_zone, "generate constraint islands for moving areas");
 
 	uint32_t island_count = 0;
 
@@ -177,29 +200,36 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 			}
 			constraint->set_island_step(_step);
 
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-
 			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
 		}
 		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
 	}
 
+	if (deterministic) {
+		SortArray<GodotConstraint2D *, GodotConstraint2D::KeyComparator> sorter;
+		sorter.sort(all_constraints.ptr(), all_constraints.size());
+	}
+
+	// Each constraint can be on a separate island for areas as there's no solving phase.
+	island_count = all_constraints.size();
+	if (constraint_islands.size() < island_count) {
+		constraint_islands.resize(island_count);
+	}
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_index];
+		constraint_island.clear();
+		constraint_island.push_back(all_constraints[island_index]);
+	}
+
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
+	GodotProfileZoneGrouped(_profile_zone, "generate constraint islands for active rigid bodies");
 
-	b = body_list->first();
+	// Bodies can be activated by new pairs when updating the broadphase.
+	_get_active_bodies(p_space);
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
-
+	for (GodotBody2D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -225,9 +255,11 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (deterministic) {
+				// The constraints are found in the order they were added to the bodies.
+				constraint_island.sort_custom<GodotConstraint2D::KeyComparator>();
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -239,10 +271,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
+	GodotProfileZoneGrouped(_profile_zone, "setup constraints / process collisions");
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (p_multithreaded) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t constraint_index = 0; constraint_index < total_constraint_count; ++constraint_index) {
+			_setup_constraint(constraint_index);
+		}
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -251,6 +290,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
+	GodotProfileZoneGrouped(_profile_zone, "pre-solve constraint islands");
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
@@ -258,11 +298,18 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
+	GodotProfileZoneGrouped(_profile_zone, "solve constraint islands");
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (p_multithreaded) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_solve_island(island_index);
+		}
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -271,15 +318,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	/* INTEGRATE VELOCITIES */
+	GodotProfileZoneGrouped(_profile_zone, "integrate velocities");
+
+	// Bodies can be woken up by the constraints, and the order also gives the order of the state callbacks.
+	_get_active_bodies(p_space);
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_velocities(p_delta);
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
+	GodotProfileZoneGrouped(_profile_zone, "sleep / wake up islands");
 
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
 		_check_suspend(body_islands[island_index]);
@@ -294,7 +343,6 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep2D::GodotStep2D() {
@@ -33,17 +33,23 @@
 #include "godot_space_2d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep2D {
-	uint64_t _step = 1;
+	// Shared by all steppers, so each space can be stepped by any of them.
+	static SafeNumeric<uint64_t> last_step;
+	uint64_t _step = 0;
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool deterministic = false;
 
+	LocalVector<GodotBody2D *> active_bodies;
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
+	void _get_active_bodies(const GodotSpace2D *p_space);
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
@@ -51,7 +57,9 @@ class GodotStep2D {
 	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
 
 public:
-	void step(GodotSpace2D *p_space, real_t p_delta);
+	// When not multithreaded, the islands are solved on the calling thread, which is then free to be
+	// a worker thread stepping a space while other spaces are stepped on other threads.
+	void step(GodotSpace2D *p_space, real_t p_delta, bool p_multithreaded = true);
 	GodotStep2D();
 	~GodotStep2D();
 };
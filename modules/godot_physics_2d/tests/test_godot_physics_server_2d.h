@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_godot_physics_server_2d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hashfuncs.h"
+#include "servers/physics_2d/physics_server_2d.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysicsServer2D {
+
+struct Scene {
+	RID space;
+	LocalVector<RID> bodies; // In the order they were created.
+	RID joint;
+};
+
+// A deterministic space with a floor, and a pile of boxes and balls falling onto it. One of the boxes hangs from a pin.
+// The bodies are always created in the same order, but they can be added to the space in reverse.
+inline Scene create_scene(RID p_box_shape, RID p_ball_shape, RID p_floor_shape, bool p_reverse) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	Scene scene;
+	scene.space = ps->space_create();
+	ps->space_set_deterministic(scene.space, true);
+	ps->space_set_active(scene.space, true);
+
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, p_floor_shape);
+	ps->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 100)));
+	scene.bodies.push_back(floor);
+
+	for (int i = 0; i < 40; i++) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		ps->body_add_shape(body, i % 2 == 0 ? p_box_shape : p_ball_shape);
+		const Vector2 position = Vector2((i % 8) * 25.0 - 100.0 + (i / 8) * 5.0, -(i / 8) * 30.0);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(i * 0.3, position));
+		scene.bodies.push_back(body);
+	}
+
+	for (uint32_t i = 0; i < scene.bodies.size(); i++) {
+		ps->body_set_space(scene.bodies[p_reverse ? scene.bodies.size() - 1 - i : i], scene.space);
+	}
+
+	scene.joint = ps->joint_create();
+	ps->joint_make_pin(scene.joint, Vector2(-150, -100), scene.bodies[1]);
+	return scene;
+}
+
+inline void free_scene(const Scene &p_scene) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	ps->free_rid(p_scene.joint);
+	for (const RID &body : p_scene.bodies) {
+		ps->free_rid(body);
+	}
+	ps->free_rid(p_scene.space);
+}
+
+// Hashes the bits of the transforms and velocities, so any difference in the results changes it.
+inline uint32_t hash_bodies(const Scene &p_scene) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (const RID &body : p_scene.bodies) {
+		const Transform2D transform = ps->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		const Vector2 linear_velocity = ps->body_get_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		const real_t angular_velocity = ps->body_get_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+		hash = hash_murmur3_buffer(&transform, sizeof(transform), hash);
+		hash = hash_murmur3_buffer(&linear_velocity, sizeof(linear_velocity), hash);
+		hash = hash_murmur3_buffer(&angular_velocity, sizeof(angular_velocity), hash);
+	}
+	return hash;
+}
+
+struct Shapes {
+	RID box;
+	RID ball;
+	RID floor;
+
+	Shapes() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		box = ps->rectangle_shape_create();
+		ps->shape_set_data(box, Vector2(10, 10));
+		ball = ps->circle_shape_create();
+		ps->shape_set_data(ball, 10.0);
+		floor = ps->rectangle_shape_create();
+		ps->shape_set_data(floor, Vector2(500, 20));
+	}
+
+	~Shapes() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		ps->free_rid(box);
+		ps->free_rid(ball);
+		ps->free_rid(floor);
+	}
+};
+
+TEST_CASE("[Modules][GodotPhysics2D] Deterministic spaces don't depend on the order bodies were added in") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	const Shapes shapes;
+
+	// Both spaces are as busy, so one of them is stepped with its islands solved on worker threads,
+	// and the other by a worker thread, which solves them by itself.
+	const Scene scene = create_scene(shapes.box, shapes.ball, shapes.floor, false);
+	const Scene reversed_scene = create_scene(shapes.box, shapes.ball, shapes.floor, true);
+	CHECK(ps->space_is_deterministic(scene.space));
+
+	for (int i = 0; i < 180; i++) {
+		ps->step(1.0 / 60.0);
+		if (i % 30 == 29) {
+			INFO("Step ", i + 1);
+			CHECK(hash_bodies(reversed_scene) == hash_bodies(scene));
+		}
+	}
+
+	const Transform2D transform = ps->body_get_state(scene.bodies[2], PhysicsServer2D::BODY_STATE_TRANSFORM);
+	CHECK_MESSAGE(transform.get_origin().y > 0.0, "The bodies should have fallen.");
+	CHECK_MESSAGE(transform.get_origin().y < 80.0, "The bodies should have landed on the floor.");
+
+	free_scene(scene);
+	free_scene(reversed_scene);
+}
+
+TEST_CASE("[Modules][GodotPhysics2D] Restoring a snapshot of a deterministic space") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	const Shapes shapes;
+	const Scene scene = create_scene(shapes.box, shapes.ball, shapes.floor, false);
+
+	// Take the snapshot while the bodies are still colliding, so it has contacts and warm started impulses.
+	for (int i = 0; i < 60; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	const Vector<uint8_t> snapshot = ps->space_get_snapshot(scene.space);
+	REQUIRE(!snapshot.is_empty());
+	const uint32_t snapshot_hash = hash_bodies(scene);
+
+	for (int i = 0; i < 60; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	const uint32_t expected_hash = hash_bodies(scene);
+	CHECK(expected_hash != snapshot_hash);
+
+	// Rolling back and stepping again should give the same results, bit for bit.
+	for (int rollback = 0; rollback < 2; rollback++) {
+		CHECK(ps->space_restore_snapshot(scene.space, snapshot) == OK);
+		CHECK(hash_bodies(scene) == snapshot_hash);
+		for (int i = 0; i < 60; i++) {
+			ps->step(1.0 / 60.0);
+		}
+		CHECK(hash_bodies(scene) == expected_hash);
+	}
+
+	// Invalid snapshots are rejected without changing anything.
+	ERR_PRINT_OFF;
+	CHECK(ps->space_restore_snapshot(scene.space, Vector<uint8_t>()) != OK);
+	Vector<uint8_t> truncated = snapshot;
+	truncated.resize(snapshot.size() - 1);
+	CHECK(ps->space_restore_snapshot(scene.space, truncated) != OK);
+	ERR_PRINT_ON;
+	CHECK(hash_bodies(scene) == expected_hash);
+
+	free_scene(scene);
+}
+
+} // namespace TestGodotPhysicsServer2D
@@ -63,7 +63,8 @@ public:
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
-	virtual void update() = 0;
+	// When multithreaded, the new pairs may be searched for on worker threads. The callbacks are always called on this thread.
+	virtual void update(bool p_multithreaded = false) = 0;
 
 	virtual ~GodotBroadPhase3D() {}
 };
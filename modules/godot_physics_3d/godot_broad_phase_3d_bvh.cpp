@@ -114,8 +114,8 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
-void GodotBroadPhase3DBVH::update() {
-	bvh.update();
+void GodotBroadPhase3DBVH::update(bool p_multithreaded) {
+	bvh.update(p_multithreaded);
 }
 
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
@@ -90,7 +90,7 @@ public:
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
 
-	virtual void update() override;
+	virtual void update(bool p_multithreaded = false) override;
 
 	static GodotBroadPhase3D *_create();
 	GodotBroadPhase3DBVH();
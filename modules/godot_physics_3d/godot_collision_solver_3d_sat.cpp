@@ -614,8 +614,27 @@ static void _generate_contacts_from_supports(const Vector3 *p_points_A, int p_po
 	contacts_func(points_A, pointcount_A, points_B, pointcount_B, p_callback);
 }
 
+// Projects a shape onto several axes, in a single call for the shapes that can project onto
+// several axes at a time. The results are the same as calling project_range() for each axis.
+template <typename ShapeT>
+static _FORCE_INLINE_ void _project_ranges(const ShapeT *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, int p_count, real_t *r_min, real_t *r_max) {
+	for (int i = 0; i < p_count; i++) {
+		p_shape->project_range(p_axes[i], p_transform, r_min[i], r_max[i]);
+	}
+}
+
+static _FORCE_INLINE_ void _project_ranges(const GodotBoxShape3D *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, int p_count, real_t *r_min, real_t *r_max) {
+	p_shape->project_ranges(p_axes, p_count, p_transform, r_min, r_max);
+}
+
+static _FORCE_INLINE_ void _project_ranges(const GodotConvexPolygonShape3D *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, int p_count, real_t *r_min, real_t *r_max) {
+	p_shape->project_ranges(p_axes, p_count, p_transform, r_min, r_max);
+}
+
 template <typename ShapeA, typename ShapeB, bool withMargin = false>
 class SeparatorAxisTest {
+	static constexpr int AXIS_BATCH_SIZE = 8;
+
 	const ShapeA *shape_A = nullptr;
 	const ShapeB *shape_B = nullptr;
 	const Transform3D *transform_A = nullptr;
@@ -625,31 +644,10 @@ class SeparatorAxisTest {
 	real_t margin_A = 0.0;
 	real_t margin_B = 0.0;
 	Vector3 separator_axis;
+	Vector3 added_axes[AXIS_BATCH_SIZE];
+	int added_axis_count = 0;
 
-public:
-	Vector3 best_axis;
-
-	_FORCE_INLINE_ bool test_previous_axis() {
-		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
-			return test_axis(*callback->prev_axis);
-		} else {
-			return true;
-		}
-	}
-
-	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
-		Vector3 axis = p_axis;
-
-		if (axis.is_zero_approx()) {
-			// strange case, try an upwards separator
-			axis = Vector3(0.0, 1.0, 0.0);
-		}
-
-		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
-
-		shape_A->project_range(axis, *transform_A, min_A, max_A);
-		shape_B->project_range(axis, *transform_B, min_B, max_B);
-
+	_FORCE_INLINE_ bool _test_ranges(const Vector3 &p_axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -664,7 +662,7 @@ public:
 		max_B -= (min_A + max_A) * 0.5;
 
 		if (min_B > 0.0 || max_B < 0.0) {
-			separator_axis = axis;
+			separator_axis = p_axis;
 			return false; // doesn't contain 0
 		}
 
@@ -677,18 +675,75 @@ public:
 		if (max_B < min_B) {
 			if (max_B < best_depth) {
 				best_depth = max_B;
-				best_axis = axis;
+				best_axis = p_axis;
 			}
 		} else {
 			if (min_B < best_depth) {
 				best_depth = min_B;
-				best_axis = -axis; // keep it as A axis
+				best_axis = -p_axis; // keep it as A axis
 			}
 		}
 
 		return true;
 	}
 
+public:
+	Vector3 best_axis;
+
+	_FORCE_INLINE_ bool test_previous_axis() {
+		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
+			return test_axis(*callback->prev_axis);
+		} else {
+			return true;
+		}
+	}
+
+	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
+		Vector3 axis = p_axis;
+
+		if (axis.is_zero_approx()) {
+			// strange case, try an upwards separator
+			axis = Vector3(0.0, 1.0, 0.0);
+		}
+
+		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
+
+		shape_A->project_range(axis, *transform_A, min_A, max_A);
+		shape_B->project_range(axis, *transform_B, min_B, max_B);
+
+		return _test_ranges(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Queues an axis to be tested along with others, which lets the shapes project onto several axes at a time.
+	// The axes are tested in the order they're added, so the results are the same as with test_axis(),
+	// but a separating axis may only be found a few axes later. Returns false once one was found.
+	// The queued axes must be tested with test_added_axes() before testing any other axis.
+	_FORCE_INLINE_ bool add_axis(const Vector3 &p_axis) {
+		// strange case, try an upwards separator
+		added_axes[added_axis_count++] = p_axis.is_zero_approx() ? Vector3(0.0, 1.0, 0.0) : p_axis;
+		if (added_axis_count == AXIS_BATCH_SIZE) {
+			return test_added_axes();
+		}
+		return true;
+	}
+
+	bool test_added_axes() {
+		const int count = added_axis_count;
+		added_axis_count = 0;
+
+		real_t min_A[AXIS_BATCH_SIZE] = {}, max_A[AXIS_BATCH_SIZE] = {}, min_B[AXIS_BATCH_SIZE] = {}, max_B[AXIS_BATCH_SIZE] = {};
+
+		_project_ranges(shape_A, *transform_A, added_axes, count, min_A, max_A);
+		_project_ranges(shape_B, *transform_B, added_axes, count, min_B, max_B);
+
+		for (int i = 0; i < count; i++) {
+			if (!_test_ranges(added_axes[i], min_A[i], max_A[i], min_B[i], max_B[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
 	static _FORCE_INLINE_ void test_contact_points(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 		SeparatorAxisTest<ShapeA, ShapeB, withMargin> *separator = (SeparatorAxisTest<ShapeA, ShapeB, withMargin> *)p_userdata;
 		Vector3 axis = (p_point_B - p_point_A);
@@ -1086,7 +1141,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.add_axis(axis)) {
 			return;
 		}
 	}
@@ -1096,7 +1151,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.add_axis(axis)) {
 			return;
 		}
 	}
@@ -1111,12 +1166,16 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			}
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.add_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.test_added_axes()) {
+		return;
+	}
+
 	if (withMargin) {
 		//add endpoint test between closest vertices and edges
 
@@ -1403,7 +1462,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.add_axis(axis)) {
 			return;
 		}
 	}
@@ -1415,7 +1474,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.add_axis(axis)) {
 			return;
 		}
 	}
@@ -1429,12 +1488,16 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.add_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.test_added_axes()) {
+		return;
+	}
+
 	if (withMargin) {
 		// calculate closest points between vertices and box edges
 		for (int v = 0; v < vertex_count; v++) {
@@ -2073,7 +2136,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_A; i++) {
 		Vector3 axis = a_xform_normal.xform(faces_A[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.add_axis(axis)) {
 			return;
 		}
 	}
@@ -2085,7 +2148,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_B; i++) {
 		Vector3 axis = b_xform_normal.xform(faces_B[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.add_axis(axis)) {
 			return;
 		}
 	}
@@ -2109,13 +2172,17 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
 				Vector3 axis = e1.cross(e2).normalized();
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.add_axis(axis)) {
 					return;
 				}
 			}
 		}
 	}
 
+	if (!separator.test_added_axes()) {
+		return;
+	}
+
 	if (withMargin) {
 		//vertex-vertex
 		for (int i = 0; i < vertex_count_A; i++) {
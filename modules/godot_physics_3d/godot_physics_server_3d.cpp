@@ -39,7 +39,9 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
 	ERR_FAIL_COND_MSG(m_object->get_space() && flushing_queries, "Can't change this state while flushing queries. Use call_deferred() or set_deferred() to change monitoring state instead.");
@@ -1671,18 +1673,56 @@ void GodotPhysicsServer3D::init() {
 	stepper = memnew(GodotStep3D);
 }
 
+void GodotPhysicsServer3D::_step_space(uint32_t p_index, void *p_userdata) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_PHYSICS);
+	GodotProfileZone("GodotPhysicsServer3D::_step_space");
+	space_steppers[p_index]->step(stepped_spaces[p_index], stepped_delta, false);
+}
+
 void GodotPhysicsServer3D::step(real_t p_step) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_PHYSICS);
+	GodotProfileZone("GodotPhysicsServer3D::step");
 	if (!active) {
 		return;
 	}
 
 	_update_shapes();
 
+	if (active_spaces.size() > 1) {
+		// Spaces don't share bodies, areas or constraints, so they can be stepped at the same time.
+		// The busiest space is stepped by this thread, which solves its islands on the worker threads.
+		// The other spaces are stepped by a task each, which solves their islands by itself, since
+		// a worker thread waiting for more tasks could keep them from running.
+		GodotSpace3D *busiest_space = nullptr;
+		stepped_spaces.clear();
+		for (GodotSpace3D *E : active_spaces) {
+			if (busiest_space && E->get_active_objects() <= busiest_space->get_active_objects()) {
+				stepped_spaces.push_back(E);
+				continue;
+			}
+			if (busiest_space) {
+				stepped_spaces.push_back(busiest_space);
+			}
+			busiest_space = E;
+		}
+		while (space_steppers.size() < stepped_spaces.size()) {
+			space_steppers.push_back(memnew(GodotStep3D));
+		}
+		stepped_delta = p_step;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, nullptr, stepped_spaces.size(), -1, true, SNAME("Physics3DStepSpaces"));
+		stepper->step(busiest_space, p_step);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (GodotSpace3D *E : active_spaces) {
+			stepper->step(E, p_step);
+		}
+	}
+
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
-	for (GodotSpace3D *E : active_spaces) {
-		stepper->step(E, p_step);
+	for (const GodotSpace3D *E : active_spaces) {
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1749,6 +1789,10 @@ void GodotPhysicsServer3D::end_sync() {
 
 void GodotPhysicsServer3D::finish() {
 	memdelete(stepper);
+	for (GodotStep3D *E : space_steppers) {
+		memdelete(E);
+	}
+	space_steppers.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
@@ -55,6 +55,12 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	GodotStep3D *stepper = nullptr;
 	HashSet<GodotSpace3D *> active_spaces;
 
+	// When several spaces are active, they're stepped in parallel, each by its own stepper.
+	LocalVector<GodotStep3D *> space_steppers;
+	LocalVector<GodotSpace3D *> stepped_spaces;
+	real_t stepped_delta = 0.0;
+	void _step_space(uint32_t p_index, void *p_userdata = nullptr);
+
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace3D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea3D, true> area_owner;
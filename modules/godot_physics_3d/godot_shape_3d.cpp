@@ -31,6 +31,7 @@
 #include "godot_shape_3d.h"
 
 #include "core/io/image.h"
+#include "core/math/batch_math.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
 #include "core/templates/sort_array.h"
@@ -320,6 +321,10 @@ void GodotBoxShape3D::project_range(const Vector3 &p_normal, const Transform3D &
 	r_max = distance + length;
 }
 
+void GodotBoxShape3D::project_ranges(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t *r_min, real_t *r_max) const {
+	BatchMath::project_box(p_transform, half_extents, p_normals, r_min, r_max, p_count);
+}
+
 Vector3 GodotBoxShape3D::get_support(const Vector3 &p_normal) const {
 	Vector3 point(
 			(p_normal.x < 0) ? -half_extents.x : half_extents.x,
@@ -836,6 +841,19 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 	}
 }
 
+void GodotConvexPolygonShape3D::project_ranges(const Vector3 *p_normals, int p_count, const Transform3D &p_transform, real_t *r_min, real_t *r_max) const {
+	uint32_t vertex_count = mesh.vertices.size();
+	if (vertex_count > 3 * extreme_vertices.size()) {
+		// Large meshes use get_support(), see project_range().
+		for (int i = 0; i < p_count; i++) {
+			project_range(p_normals[i], p_transform, r_min[i], r_max[i]);
+		}
+		return;
+	}
+
+	BatchMath::project_points(p_transform, mesh.vertices.ptr(), vertex_count, p_normals, r_min, r_max, p_count);
+}
+
 Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 	// Skip if there are no vertices in the mesh
 	if (mesh.vertices.is_empty()) {
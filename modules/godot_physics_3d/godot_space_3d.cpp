@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
@@ -107,16 +108,35 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
+// Keeps the objects found by the broadphase that the query can collide with, in the same order.
+static int _filter_query_results(GodotCollisionObject3D **r_objects, int *r_shape_indices, int p_amount, const HashSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray = false) {
+	int count = 0;
+	for (int i = 0; i < p_amount; i++) {
+		GodotCollisionObject3D *col_obj = r_objects[i];
 
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
+		if (!_can_collide_with(col_obj, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		if (p_pick_ray && !(col_obj->is_ray_pickable())) {
+			continue;
+		}
+
+		if (p_exclude.has(col_obj->get_self())) {
+			continue;
+		}
+
+		r_objects[count] = col_obj;
+		r_shape_indices[count] = r_shape_indices[i];
+		count++;
+	}
+	return count;
+}
+
+// Objects that aren't hit are skipped by their shape's AABB first when `p_test_aabbs` is true,
+// for the objects found for a packet of rays, rather than for this ray.
+static bool _intersect_ray_objects(const PhysicsDirectSpaceState3D::RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_shape_indices, int p_amount, bool p_test_aabbs, PhysicsDirectSpaceState3D::RayResult &r_result) {
+	Vector3 normal = (p_to - p_from).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -127,26 +147,18 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
-
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
-			continue;
-		}
+	for (int i = 0; i < p_amount; i++) {
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_shape_indices[i];
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_test_aabbs && !col_obj->get_shape_aabb(shape_idx).intersects_segment(p_from, p_to)) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-
-		int shape_idx = space->intersection_query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
-		Vector3 local_from = inv_xform.xform(begin);
-		Vector3 local_to = inv_xform.xform(end);
+		Vector3 local_from = inv_xform.xform(p_from);
+		Vector3 local_to = inv_xform.xform(p_to);
 
 		const GodotShape3D *shape = col_obj->get_shape(shape_idx);
 
@@ -157,7 +169,7 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 			if (p_parameters.hit_from_inside) {
 				// Hit shape at starting point.
 				min_d = 0;
-				res_point = begin;
+				res_point = p_from;
 				res_normal = Vector3();
 				res_shape = shape_idx;
 				res_obj = col_obj;
@@ -207,41 +219,23 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
-
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
-
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
+// Objects outside of `p_test_aabb` are skipped, if given, for the objects found for a packet of queries.
+static int _intersect_shape_objects(const GodotShape3D *p_shape, const Transform3D &p_transform, real_t p_margin, GodotCollisionObject3D *const *p_objects, const int *p_shape_indices, int p_amount, const AABB *p_test_aabb, PhysicsDirectSpaceState3D::ShapeResult *r_results, int p_result_max) {
 	int cc = 0;
 
-	//Transform3D ai = p_xform.affine_inverse();
-
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 		if (cc >= p_result_max) {
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
-
-		//area can't be picked by ray (default)
+		const GodotCollisionObject3D *col_obj = p_objects[i];
+		int shape_idx = p_shape_indices[i];
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_test_aabb && !col_obj->get_shape_aabb(shape_idx).intersects(*p_test_aabb)) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
-
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_margin, 0)) {
 			continue;
 		}
 
@@ -262,6 +256,240 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_parameters.exclude, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.pick_ray);
+
+	return _intersect_ray_objects(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, r_result);
+}
+
+static uint32_t _spread_morton_bits(uint32_t p_value) {
+	p_value &= 0x3ff;
+	p_value = (p_value | (p_value << 16)) & 0x030000ff;
+	p_value = (p_value | (p_value << 8)) & 0x0300f00f;
+	p_value = (p_value | (p_value << 4)) & 0x030c30c3;
+	p_value = (p_value | (p_value << 2)) & 0x09249249;
+	return p_value;
+}
+
+void GodotPhysicsDirectSpaceState3D::_sort_batch_queries() {
+	AABB bounds(batch_points[0], Vector3());
+	for (const Vector3 &point : batch_points) {
+		bounds.expand_to(point);
+	}
+
+	// 10 bits per axis, within the bounds of the batch.
+	Vector3 scale;
+	for (int i = 0; i < 3; i++) {
+		scale[i] = bounds.size[i] > CMP_EPSILON ? 1023.0 / bounds.size[i] : 0.0;
+	}
+
+	batch_queries.resize(batch_points.size());
+	for (uint32_t i = 0; i < batch_points.size(); i++) {
+		const Vector3 cell = (batch_points[i] - bounds.position) * scale;
+		batch_queries[i].morton_code = _spread_morton_bits(uint32_t(cell.x)) | (_spread_morton_bits(uint32_t(cell.y)) << 1) | (_spread_morton_bits(uint32_t(cell.z)) << 2);
+		batch_queries[i].index = i;
+	}
+	batch_queries.sort();
+}
+
+void GodotPhysicsDirectSpaceState3D::_reserve_batch_query_buffers() {
+	// One for each worker thread, and one for the calling thread in case it's not one.
+	const uint32_t buffer_count = WorkerThreadPool::get_singleton()->get_thread_count() + 1;
+	if (space->batch_query_buffers.size() < buffer_count) {
+		space->batch_query_buffers.resize(buffer_count);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_packet(uint32_t p_packet, RayBatch *p_batch) {
+	const RayParameters &parameters = *p_batch->parameters;
+	const uint32_t begin = p_packet * BATCH_PACKET_SIZE;
+	const uint32_t end = MIN(begin + BATCH_PACKET_SIZE, batch_queries.size());
+
+	GodotCollisionObject3D **objects = space->intersection_query_results;
+	int *shape_indices = space->intersection_query_subindex_results;
+	if (p_batch->threaded) {
+		GodotSpace3D::QueryBuffer &buffer = space->batch_query_buffers[WorkerThreadPool::get_singleton()->get_thread_index() + 1];
+		objects = buffer.results;
+		shape_indices = buffer.subindex_results;
+	}
+
+	AABB packet_aabb(p_batch->from[batch_queries[begin].index], Vector3());
+	for (uint32_t i = begin; i < end; i++) {
+		const uint32_t index = batch_queries[i].index;
+		packet_aabb.expand_to(p_batch->from[index]);
+		packet_aabb.expand_to(p_batch->to[index]);
+	}
+
+	int amount = space->broadphase->cull_aabb(packet_aabb, objects, GodotSpace3D::INTERSECTION_QUERY_MAX, shape_indices);
+	// If the objects don't all fit, the rays of the packet are culled one by one instead.
+	const bool packet_culled = amount < GodotSpace3D::INTERSECTION_QUERY_MAX;
+	if (packet_culled) {
+		amount = _filter_query_results(objects, shape_indices, amount, parameters.exclude, parameters.collision_mask, parameters.collide_with_bodies, parameters.collide_with_areas, parameters.pick_ray);
+	}
+
+	uint32_t hit_count = 0;
+	for (uint32_t i = begin; i < end; i++) {
+		const uint32_t index = batch_queries[i].index;
+		const Vector3 &from = p_batch->from[index];
+		const Vector3 &to = p_batch->to[index];
+		RayResult &result = p_batch->results[index];
+		result = RayResult();
+
+		if (!packet_culled) {
+			amount = space->broadphase->cull_segment(from, to, objects, GodotSpace3D::INTERSECTION_QUERY_MAX, shape_indices);
+			amount = _filter_query_results(objects, shape_indices, amount, parameters.exclude, parameters.collision_mask, parameters.collide_with_bodies, parameters.collide_with_areas, parameters.pick_ray);
+		}
+
+		if (_intersect_ray_objects(parameters, from, to, objects, shape_indices, amount, packet_culled, result)) {
+			hit_count++;
+		}
+	}
+
+	p_batch->hit_count.add(hit_count);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_ray_count <= 0) {
+		return 0;
+	}
+
+	batch_points.resize(p_ray_count);
+	for (int i = 0; i < p_ray_count; i++) {
+		batch_points[i] = (p_from[i] + p_to[i]) * 0.5;
+	}
+	_sort_batch_queries();
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+
+	const uint32_t packet_count = (p_ray_count + BATCH_PACKET_SIZE - 1) / BATCH_PACKET_SIZE;
+	batch.threaded = p_use_threads && packet_count > 1;
+	if (batch.threaded) {
+		_reserve_batch_query_buffers();
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_packet, &batch, packet_count, -1, true, SNAME("Physics3DIntersectRays"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t packet = 0; packet < packet_count; packet++) {
+			_intersect_ray_packet(packet, &batch);
+		}
+	}
+
+	return batch.hit_count.get();
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	amount = _filter_query_results(space->intersection_query_results, space->intersection_query_subindex_results, amount, p_parameters.exclude, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas);
+
+	return _intersect_shape_objects(shape, p_parameters.transform, p_parameters.margin, space->intersection_query_results, space->intersection_query_subindex_results, amount, nullptr, r_results, p_result_max);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_packet(uint32_t p_packet, ShapeBatch *p_batch) {
+	const ShapeParameters &parameters = *p_batch->parameters;
+	const uint32_t begin = p_packet * BATCH_PACKET_SIZE;
+	const uint32_t end = MIN(begin + BATCH_PACKET_SIZE, batch_queries.size());
+
+	GodotCollisionObject3D **objects = space->intersection_query_results;
+	int *shape_indices = space->intersection_query_subindex_results;
+	if (p_batch->threaded) {
+		GodotSpace3D::QueryBuffer &buffer = space->batch_query_buffers[WorkerThreadPool::get_singleton()->get_thread_index() + 1];
+		objects = buffer.results;
+		shape_indices = buffer.subindex_results;
+	}
+
+	const AABB shape_aabb = p_batch->shape->get_aabb();
+	AABB packet_aabb = p_batch->transforms[batch_queries[begin].index].xform(shape_aabb);
+	for (uint32_t i = begin + 1; i < end; i++) {
+		packet_aabb.merge_with(p_batch->transforms[batch_queries[i].index].xform(shape_aabb));
+	}
+
+	int amount = space->broadphase->cull_aabb(packet_aabb, objects, GodotSpace3D::INTERSECTION_QUERY_MAX, shape_indices);
+	// If the objects don't all fit, the queries of the packet are culled one by one instead.
+	const bool packet_culled = amount < GodotSpace3D::INTERSECTION_QUERY_MAX;
+	if (packet_culled) {
+		amount = _filter_query_results(objects, shape_indices, amount, parameters.exclude, parameters.collision_mask, parameters.collide_with_bodies, parameters.collide_with_areas);
+	}
+
+	uint32_t hit_count = 0;
+	for (uint32_t i = begin; i < end; i++) {
+		const uint32_t index = batch_queries[i].index;
+		const Transform3D &transform = p_batch->transforms[index];
+		const AABB aabb = transform.xform(shape_aabb);
+
+		if (!packet_culled) {
+			amount = space->broadphase->cull_aabb(aabb, objects, GodotSpace3D::INTERSECTION_QUERY_MAX, shape_indices);
+			amount = _filter_query_results(objects, shape_indices, amount, parameters.exclude, parameters.collision_mask, parameters.collide_with_bodies, parameters.collide_with_areas);
+		}
+
+		const AABB test_aabb = aabb.grow(parameters.margin);
+		const int result_count = _intersect_shape_objects(p_batch->shape, transform, parameters.margin, objects, shape_indices, amount, packet_culled ? &test_aabb : nullptr, p_batch->results + index * p_batch->result_max, p_batch->result_max);
+		p_batch->result_counts[index] = result_count;
+		if (result_count > 0) {
+			hit_count++;
+		}
+	}
+
+	p_batch->hit_count.add(hit_count);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_query_count, ShapeResult *r_results, int p_result_max, int *r_result_counts, bool p_use_threads) {
+	// Set before failing, the callers read every count.
+	for (int i = 0; i < p_query_count; i++) {
+		r_result_counts[i] = 0;
+	}
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_query_count <= 0 || p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	batch_points.resize(p_query_count);
+	for (int i = 0; i < p_query_count; i++) {
+		batch_points[i] = p_transforms[i].origin;
+	}
+	_sort_batch_queries();
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+
+	const uint32_t packet_count = (p_query_count + BATCH_PACKET_SIZE - 1) / BATCH_PACKET_SIZE;
+	batch.threaded = p_use_threads && packet_count > 1;
+	if (batch.threaded) {
+		_reserve_batch_query_buffers();
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_packet, &batch, packet_count, -1, true, SNAME("Physics3DIntersectShapes"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t packet = 0; packet < packet_count; packet++) {
+			_intersect_shape_packet(packet, &batch);
+		}
+	}
+
+	return batch.hit_count.get();
+}
+
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
@@ -1185,8 +1413,8 @@ void GodotSpace3D::setup() {
 	}
 }
 
-void GodotSpace3D::update() {
-	broadphase->update();
+void GodotSpace3D::update(bool p_multithreaded) {
+	broadphase->update(p_multithreaded);
 }
 
 void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
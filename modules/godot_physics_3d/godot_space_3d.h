@@ -36,17 +36,61 @@
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// The queries of a batch are sorted along a Morton curve, and split into packets of nearby queries.
+	// The broadphase is culled once per packet, for the bounds of all of its queries.
+	static constexpr uint32_t BATCH_PACKET_SIZE = 32;
+
+	struct BatchQuery {
+		uint32_t morton_code = 0;
+		uint32_t index = 0;
+
+		bool operator<(const BatchQuery &p_other) const { return morton_code < p_other.morton_code; }
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+		bool threaded = false;
+		SafeNumeric<uint32_t> hit_count;
+	};
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		const GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+		bool threaded = false;
+		SafeNumeric<uint32_t> hit_count;
+	};
+
+	// Kept between batches, to avoid allocating them again.
+	LocalVector<Vector3> batch_points;
+	LocalVector<BatchQuery> batch_queries;
+
+	void _sort_batch_queries();
+	void _reserve_batch_query_buffers();
+	void _intersect_ray_packet(uint32_t p_packet, RayBatch *p_batch);
+	void _intersect_shape_packet(uint32_t p_packet, ShapeBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads = false) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual int intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_query_count, ShapeResult *r_results, int p_result_max, int *r_result_counts, bool p_use_threads = false) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
@@ -102,6 +146,13 @@ private:
 	GodotCollisionObject3D *intersection_query_results[INTERSECTION_QUERY_MAX];
 	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
 
+	// Used by the batched queries running on several threads, one per thread.
+	struct QueryBuffer {
+		GodotCollisionObject3D *results[INTERSECTION_QUERY_MAX];
+		int subindex_results[INTERSECTION_QUERY_MAX];
+	};
+	LocalVector<QueryBuffer> batch_query_buffers;
+
 	real_t body_linear_velocity_sleep_threshold = 0.0;
 	real_t body_angular_velocity_sleep_threshold = 0.0;
 	real_t body_time_to_sleep = 0.0;
@@ -164,7 +215,7 @@ public:
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 
-	void update();
+	void update(bool p_multithreaded = false);
 	void setup();
 	void call_queries();
 
@@ -34,6 +34,7 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
@@ -41,6 +42,8 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+SafeNumeric<uint64_t> GodotStep3D::last_step;
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -130,6 +133,13 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep3D::_pre_solve_islands(uint32_t p_island_count) {
+	setup_constraints_endtime = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -182,9 +192,11 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 	}
 }
 
-void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta, bool p_multithreaded) {
 	p_space->lock(); // can't access space during this
 
+	_step = last_step.increment();
+
 	p_space->setup(); //update inertias, etc
 
 	p_space->set_last_step(p_delta);
@@ -197,6 +209,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	const SelfList<GodotSoftBody3D>::List *soft_body_list = &p_space->get_active_soft_body_list();
 
 	/* INTEGRATE FORCES */
+	GodotProfileZoneGroupedFirst(_profile_zone, "integrate forces");
 
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
@@ -211,6 +224,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	/* UPDATE SOFT BODY MOTION */
+	GodotProfileZoneGrouped(_profile_zone, "update soft body motion");
 
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
@@ -222,7 +236,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->set_active_objects(active_count);
 
 	// Update the broadphase to register collision pairs.
-	p_space->update();
+	p_space->update(p_multithreaded);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -231,6 +245,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+	GodotProfileZoneGrouped(_profile_zone, "generate constraint islands for moving areas");
 
 	uint32_t island_count = 0;
 
@@ -259,6 +274,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
+	GodotProfileZoneGrouped(_profile_zone, "generate constraint islands for active rigid bodies");
 
 	b = body_list->first();
 
@@ -298,6 +314,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
+	GodotProfileZoneGrouped(_profile_zone, "generate constraint islands for active soft bodies");
 
 	sb = soft_body_list->first();
 	while (sb) {
@@ -341,39 +358,47 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
-	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
-
-	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
-
-	/* PRE-SOLVE CONSTRAINT ISLANDS */
-
-	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+	/* SETUP CONSTRAINTS / PROCESS COLLISIONS, PRE-SOLVE AND SOLVE CONSTRAINT ISLANDS */
+	GodotProfileZoneGrouped(_profile_zone, "setup constraints / process collisions, pre-solve and solve constraint islands");
+
+	if (p_multithreaded) {
+		// These phases form a task graph, so each one is started by the thread completing the previous one,
+		// and this thread only waits once.
+		WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+		WorkerThreadPool::TaskGraphID task_graph = wtp->create_task_graph(SNAME("Physics3DConstraints"));
+
+		const WorkerThreadPool::GraphNodeID setup_node[] = {
+			wtp->add_graph_template_group_task(task_graph, this, &GodotStep3D::_setup_constraint, nullptr, all_constraints.size())
+		};
+		// WARNING: Pre-solving runs as a single task, because it involves thread-unsafe processing.
+		const WorkerThreadPool::GraphNodeID pre_solve_node[] = {
+			wtp->add_graph_template_task(task_graph, this, &GodotStep3D::_pre_solve_islands, island_count, setup_node)
+		};
+		// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
+		// their content is not reliable after these calls and shouldn't be used anymore.
+		wtp->add_graph_template_group_task(task_graph, this, &GodotStep3D::_solve_island, nullptr, island_count, -1, pre_solve_node);
+
+		wtp->submit_task_graph(task_graph);
+		wtp->wait_for_task_graph_completion(task_graph);
+	} else {
+		for (uint32_t constraint_index = 0; constraint_index < all_constraints.size(); ++constraint_index) {
+			_setup_constraint(constraint_index);
+		}
+		_pre_solve_islands(island_count);
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_solve_island(island_index);
+		}
 	}
 
-	/* SOLVE CONSTRAINT ISLANDS */
-
-	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
-	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, setup_constraints_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - setup_constraints_endtime);
 		profile_begtime = profile_endtime;
 	}
 
 	/* INTEGRATE VELOCITIES */
+	GodotProfileZoneGrouped(_profile_zone, "integrate velocities");
 
 	b = body_list->first();
 	while (b) {
@@ -383,12 +408,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
+	GodotProfileZoneGrouped(_profile_zone, "sleep / wake up islands");
 
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
 		_check_suspend(body_islands[island_index]);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
+	GodotProfileZoneGrouped(_profile_zone, "update soft body constraints");
 
 	sb = soft_body_list->first();
 	while (sb) {
@@ -405,7 +432,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep3D::GodotStep3D() {
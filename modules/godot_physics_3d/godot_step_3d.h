@@ -33,9 +33,12 @@
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
-	uint64_t _step = 1;
+	// Shared by all steppers, so each space can be stepped by any of them.
+	static SafeNumeric<uint64_t> last_step;
+	uint64_t _step = 0;
 
 	int iterations = 0;
 	real_t delta = 0.0;
@@ -44,15 +47,20 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	uint64_t setup_constraints_endtime = 0; // Set from the task pre-solving the islands, for profiling.
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _pre_solve_islands(uint32_t p_island_count);
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
-	void step(GodotSpace3D *p_space, real_t p_delta);
+	// When not multithreaded, the islands are solved on the calling thread, which is then free to be
+	// a worker thread stepping a space while other spaces are stepped on other threads.
+	void step(GodotSpace3D *p_space, real_t p_delta, bool p_multithreaded = true);
 	GodotStep3D();
 	~GodotStep3D();
 };
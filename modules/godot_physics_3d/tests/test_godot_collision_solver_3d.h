@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*  test_godot_collision_solver_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_collision_solver_3d.h"
+#include "../godot_shape_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionSolver3D {
+
+inline Vector3 random_vector3(RandomPCG &p_rng, real_t p_extent) {
+	return Vector3(p_rng.random(-p_extent, p_extent), p_rng.random(-p_extent, p_extent), p_rng.random(-p_extent, p_extent));
+}
+
+inline Transform3D random_transform(RandomPCG &p_rng, real_t p_extent) {
+	const Basis basis = Basis(random_vector3(p_rng, 1.0).normalized(), p_rng.random(0.0, Math::TAU));
+	return Transform3D(basis, random_vector3(p_rng, p_extent));
+}
+
+inline GodotConvexPolygonShape3D *create_random_convex(RandomPCG &p_rng, int p_point_count) {
+	Vector<Vector3> points;
+	for (int i = 0; i < p_point_count; i++) {
+		points.push_back(random_vector3(p_rng, 0.5));
+	}
+	GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+	convex->set_data(points);
+	return convex;
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Projecting shapes onto several axes at a time") {
+	RandomPCG rng(1);
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(0.5, 1.0, 2.0));
+	// A small hull projects its vertices, a large one uses its support function.
+	GodotConvexPolygonShape3D *small_convex = create_random_convex(rng, 12);
+	GodotConvexPolygonShape3D *large_convex = create_random_convex(rng, 500);
+
+	// The SAT tests rely on these being exactly the same as project_range(), so contacts don't change.
+	bool box_equal = true;
+	bool small_convex_equal = true;
+	bool large_convex_equal = true;
+	for (int i = 0; i < 200; i++) {
+		const Transform3D transform = random_transform(rng, 10.0);
+		const int axis_count = 1 + i % 8;
+		Vector3 axes[8];
+		for (int j = 0; j < axis_count; j++) {
+			axes[j] = random_vector3(rng, 1.0).normalized();
+		}
+
+		real_t min[8];
+		real_t max[8];
+		real_t expected_min = 0.0;
+		real_t expected_max = 0.0;
+
+		box->project_ranges(axes, axis_count, transform, min, max);
+		for (int j = 0; j < axis_count; j++) {
+			box->project_range(axes[j], transform, expected_min, expected_max);
+			box_equal &= min[j] == expected_min && max[j] == expected_max;
+		}
+
+		small_convex->project_ranges(axes, axis_count, transform, min, max);
+		for (int j = 0; j < axis_count; j++) {
+			small_convex->project_range(axes[j], transform, expected_min, expected_max);
+			small_convex_equal &= min[j] == expected_min && max[j] == expected_max;
+		}
+
+		large_convex->project_ranges(axes, axis_count, transform, min, max);
+		for (int j = 0; j < axis_count; j++) {
+			large_convex->project_range(axes[j], transform, expected_min, expected_max);
+			large_convex_equal &= min[j] == expected_min && max[j] == expected_max;
+		}
+	}
+	CHECK_MESSAGE(box_equal, "Boxes should project exactly like with project_range().");
+	CHECK_MESSAGE(small_convex_equal, "Small convex polygons should project exactly like with project_range().");
+	CHECK_MESSAGE(large_convex_equal, "Large convex polygons should project exactly like with project_range().");
+
+	memdelete(box);
+	memdelete(small_convex);
+	memdelete(large_convex);
+}
+
+struct ContactCollector {
+	int count = 0;
+	Vector3 normal_sum; // Sum of the vectors from the contact points on A to the ones on B.
+
+	static void add_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+		ContactCollector *collector = static_cast<ContactCollector *>(p_userdata);
+		collector->count++;
+		collector->normal_sum += p_point_B - p_point_A;
+	}
+};
+
+TEST_CASE("[Modules][GodotPhysics3D] Box and convex polygon contacts") {
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(0.5, 0.5, 0.5));
+	// The same box as a convex polygon.
+	Vector<Vector3> points;
+	for (int i = 0; i < 8; i++) {
+		points.push_back(Vector3(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5, i & 4 ? 0.5 : -0.5));
+	}
+	GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+	convex->set_data(points);
+
+	const GodotShape3D *shapes[] = { box, convex };
+	for (const GodotShape3D *shape_A : shapes) {
+		for (const GodotShape3D *shape_B : shapes) {
+			// Resting on top of each other, slightly rotated so the edge axes aren't parallel.
+			const Transform3D transform_B = Transform3D(Basis(Vector3(0, 1, 0), 0.1), Vector3(0.1, 0.95, 0.0));
+			ContactCollector collector;
+			Vector3 separation_axis;
+			CHECK(GodotCollisionSolver3D::solve_static(shape_A, Transform3D(), shape_B, transform_B, ContactCollector::add_contact, &collector, &separation_axis));
+			CHECK_MESSAGE(collector.count >= 3, "The faces in contact should give several contact points.");
+			CHECK_MESSAGE(Math::abs(collector.normal_sum.normalized().y) > 0.99, "The contacts should push the shapes apart vertically.");
+
+			// Separated, on an edge axis of both.
+			const Transform3D separated_B = Transform3D(Basis(Vector3(0, 1, 0), Math::PI / 4.0) * Basis(Vector3(1, 0, 0), Math::PI / 4.0), Vector3(0.0, 1.25, 0.0));
+			collector = ContactCollector();
+			CHECK_FALSE(GodotCollisionSolver3D::solve_static(shape_A, Transform3D(), shape_B, separated_B, ContactCollector::add_contact, &collector, &separation_axis));
+			CHECK(collector.count == 0);
+		}
+	}
+
+	memdelete(box);
+	memdelete(convex);
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+// Most of the pairs overlap or nearly do, like the pairs found by the broadphase.
+TEST_CASE("[Modules][GodotPhysics3D][Benchmark] SAT collision tests" * doctest::skip()) {
+	RandomPCG rng(2);
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(0.5, 0.5, 0.5));
+	GodotConvexPolygonShape3D *convex = create_random_convex(rng, 24);
+
+	constexpr int PAIR_COUNT = 1000;
+	constexpr int ITERATIONS = 200;
+	LocalVector<Transform3D> transforms;
+	for (int i = 0; i < PAIR_COUNT * 2; i++) {
+		transforms.push_back(random_transform(rng, 0.7));
+	}
+
+	struct ShapePair {
+		const char *name;
+		const GodotShape3D *shape_A;
+		const GodotShape3D *shape_B;
+	};
+	const ShapePair pairs[] = {
+		{ "Box and box", box, box },
+		{ "Box and convex polygon", box, convex },
+		{ "Convex polygon and convex polygon", convex, convex },
+	};
+	for (const ShapePair &pair : pairs) {
+		ContactCollector collector;
+		int collisions = 0;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < ITERATIONS; i++) {
+			for (int j = 0; j < PAIR_COUNT; j++) {
+				collisions += GodotCollisionSolver3D::solve_static(pair.shape_A, transforms[j * 2], pair.shape_B, transforms[j * 2 + 1], ContactCollector::add_contact, &collector);
+			}
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		print_line(vformat("%s: %d nsec per pair, %d%% colliding.", pair.name, usec * 1000 / (ITERATIONS * PAIR_COUNT), collisions * 100 / (ITERATIONS * PAIR_COUNT)));
+	}
+
+	memdelete(box);
+	memdelete(convex);
+}
+
+} // namespace TestGodotCollisionSolver3D
@@ -0,0 +1,404 @@
+/**************************************************************************/
+/*  test_godot_physics_server_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_number_generator.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/physics_server_3d.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysicsServer3D {
+
+// A floor with columns of boxes falling onto it, which keep colliding with each other.
+inline RID create_space_with_boxes(RID p_box_shape, RID p_floor_shape, int p_box_count, LocalVector<RID> &r_bodies) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, p_floor_shape);
+	ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	ps->body_set_space(floor, space);
+	r_bodies.push_back(floor);
+
+	for (int i = 0; i < p_box_count; i++) {
+		RID box = ps->body_create();
+		ps->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		ps->body_add_shape(box, p_box_shape);
+		const Vector3 position = Vector3((i / 4) % 10 * 1.5, 1.5 + (i % 4) * 2.0, (i / 40) * 1.5);
+		ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+		ps->body_set_space(box, space);
+		r_bodies.push_back(box);
+	}
+	return space;
+}
+
+inline void free_spaces(const LocalVector<RID> &p_spaces, const LocalVector<RID> &p_bodies) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	for (const RID &body : p_bodies) {
+		ps->free_rid(body);
+	}
+	for (const RID &space : p_spaces) {
+		ps->free_rid(space);
+	}
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Spaces stepped in parallel give the same results") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID floor_shape = ps->box_shape_create();
+	ps->shape_set_data(floor_shape, Vector3(50, 1, 50));
+
+	// The first space has more boxes, so it's stepped by the calling thread, and the others by worker threads.
+	constexpr int SPACE_COUNT = 8;
+	constexpr int BOX_COUNT = 8;
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	for (int i = 0; i < SPACE_COUNT; i++) {
+		spaces.push_back(create_space_with_boxes(box_shape, floor_shape, i == 0 ? BOX_COUNT * 2 : BOX_COUNT, bodies));
+	}
+
+	for (int i = 0; i < 120; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	// Each space has a floor and its boxes, in the same order. The spaces stepped by worker threads
+	// are made the same way, so their boxes should end up in the same places.
+	const int first_space_end = BOX_COUNT * 2 + 1;
+	for (int i = 1; i <= BOX_COUNT; i++) {
+		const Transform3D expected = ps->body_get_state(bodies[first_space_end + i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(expected.origin.y > 0.0, "The boxes should have landed on the floor.");
+		CHECK_MESSAGE(expected.origin.y < 6.0, "The boxes should have fallen.");
+		for (int j = 2; j < SPACE_COUNT; j++) {
+			const Transform3D transform = ps->body_get_state(bodies[first_space_end + (j - 1) * (BOX_COUNT + 1) + i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(transform.is_equal_approx(expected));
+		}
+	}
+
+	free_spaces(spaces, bodies);
+	ps->free_rid(box_shape);
+	ps->free_rid(floor_shape);
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+// Limit the worker threads with `threading/worker_pool/max_threads` to compare the scaling on fewer cores.
+TEST_CASE("[Modules][GodotPhysics3D][Benchmark] Stepping many spaces" * doctest::skip()) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID floor_shape = ps->box_shape_create();
+	ps->shape_set_data(floor_shape, Vector3(50, 1, 50));
+
+	print_line(vformat("Stepping spaces of 200 boxes with %d worker threads:", WorkerThreadPool::get_singleton()->get_thread_count()));
+	for (int space_count : { 1, 2, 4, 8, 16, 32, 64 }) {
+		LocalVector<RID> spaces;
+		LocalVector<RID> bodies;
+		for (int i = 0; i < space_count; i++) {
+			spaces.push_back(create_space_with_boxes(box_shape, floor_shape, 200, bodies));
+		}
+
+		constexpr int STEP_COUNT = 120;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < STEP_COUNT; i++) {
+			ps->step(1.0 / 60.0);
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		print_line(vformat("%d spaces: %d usec per step, %d usec per space.", space_count, usec / STEP_COUNT, usec / (STEP_COUNT * space_count)));
+
+		free_spaces(spaces, bodies);
+	}
+
+	ps->free_rid(box_shape);
+	ps->free_rid(floor_shape);
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Pairing on worker threads gives the same results") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID floor_shape = ps->box_shape_create();
+	ps->shape_set_data(floor_shape, Vector3(50, 1, 50));
+
+	// Both spaces are as busy, so the first one is stepped by the calling thread, which searches for
+	// new pairs on the worker threads, and the second one by a worker thread, which does it by itself.
+	// There are enough boxes moving for the search to be spread over the worker threads.
+	constexpr int BOX_COUNT = 200;
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	spaces.push_back(create_space_with_boxes(box_shape, floor_shape, BOX_COUNT, bodies));
+	spaces.push_back(create_space_with_boxes(box_shape, floor_shape, BOX_COUNT, bodies));
+
+	for (int i = 0; i < 120; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	// The contacts are solved in the order the pairs were found, so the boxes only end up
+	// in the same places if the pairs were added in the same order.
+	for (int i = 1; i <= BOX_COUNT; i++) {
+		const Transform3D expected = ps->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		const Transform3D transform = ps->body_get_state(bodies[BOX_COUNT + 1 + i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(transform.is_equal_approx(expected));
+	}
+
+	free_spaces(spaces, bodies);
+	ps->free_rid(box_shape);
+	ps->free_rid(floor_shape);
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+// Limit the worker threads with `threading/worker_pool/max_threads` to compare the scaling on fewer cores.
+TEST_CASE("[Modules][GodotPhysics3D][Benchmark] Stacking a pile of boxes" * doctest::skip()) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID floor_shape = ps->box_shape_create();
+	ps->shape_set_data(floor_shape, Vector3(200, 1, 200));
+
+	print_line(vformat("Stacking boxes with %d worker threads:", WorkerThreadPool::get_singleton()->get_thread_count()));
+	for (int box_count : { 500, 1000, 2000, 4000 }) {
+		LocalVector<RID> bodies;
+		RID space = create_space_with_boxes(box_shape, floor_shape, box_count, bodies);
+
+		constexpr int STEP_COUNT = 240;
+		uint64_t max_usec = 0;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < STEP_COUNT; i++) {
+			const uint64_t step_begin = OS::get_singleton()->get_ticks_usec();
+			ps->step(1.0 / 60.0);
+			max_usec = MAX(max_usec, OS::get_singleton()->get_ticks_usec() - step_begin);
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		print_line(vformat("%d boxes: %d usec per step, %d usec for the slowest step, %d collision pairs at the end.", box_count, usec / STEP_COUNT, max_usec, ps->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS)));
+
+		free_spaces({ space }, bodies);
+	}
+
+	ps->free_rid(box_shape);
+	ps->free_rid(floor_shape);
+}
+
+// A grid of static boxes on a floor, to cast rays and intersect shapes against.
+inline RID create_space_with_static_boxes(RID p_box_shape, RID p_floor_shape, int p_grid_size, LocalVector<RID> &r_bodies) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, p_floor_shape);
+	ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	ps->body_set_space(floor, space);
+	r_bodies.push_back(floor);
+
+	for (int x = 0; x < p_grid_size; x++) {
+		for (int z = 0; z < p_grid_size; z++) {
+			RID box = ps->body_create();
+			ps->body_set_mode(box, PhysicsServer3D::BODY_MODE_STATIC);
+			ps->body_add_shape(box, p_box_shape);
+			ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 3 - p_grid_size * 1.5, 0.5 + (x + z) % 3, z * 3 - p_grid_size * 1.5)));
+			ps->body_set_space(box, space);
+			r_bodies.push_back(box);
+		}
+	}
+	return space;
+}
+
+// Rays going down and sideways through the boxes, from random points above them.
+inline void make_random_rays(int p_ray_count, real_t p_extent, LocalVector<Vector3> &r_from, LocalVector<Vector3> &r_to) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+	r_from.resize(p_ray_count);
+	r_to.resize(p_ray_count);
+	for (int i = 0; i < p_ray_count; i++) {
+		r_from[i] = Vector3(rng->randf_range(-p_extent, p_extent), rng->randf_range(1, 5), rng->randf_range(-p_extent, p_extent));
+		r_to[i] = r_from[i] + Vector3(rng->randf_range(-10, 10), -10, rng->randf_range(-10, 10));
+	}
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Batched queries give the same results as single queries") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID floor_shape = ps->box_shape_create();
+	ps->shape_set_data(floor_shape, Vector3(50, 1, 50));
+	RID sphere_shape = ps->sphere_shape_create();
+	ps->shape_set_data(sphere_shape, 1.0);
+
+	LocalVector<RID> bodies;
+	RID space = create_space_with_static_boxes(box_shape, floor_shape, 10, bodies);
+	PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	constexpr int QUERY_COUNT = 500;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	make_random_rays(QUERY_COUNT, 20, from, to);
+
+	SUBCASE("Rays") {
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		// Excluding the floor makes some rays miss.
+		parameters.exclude.insert(bodies[0]);
+
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> expected;
+		expected.resize(QUERY_COUNT);
+		int expected_hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			if (space_state->intersect_ray(parameters, expected[i])) {
+				expected_hit_count++;
+			} else {
+				expected[i] = PhysicsDirectSpaceState3D::RayResult();
+			}
+		}
+		CHECK(expected_hit_count > 0);
+		CHECK(expected_hit_count < QUERY_COUNT);
+
+		for (bool use_threads : { false, true }) {
+			LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+			results.resize(QUERY_COUNT);
+			CHECK(space_state->intersect_rays(parameters, from.ptr(), to.ptr(), QUERY_COUNT, results.ptr(), use_threads) == expected_hit_count);
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				CHECK(results[i].rid == expected[i].rid);
+				CHECK(results[i].shape == expected[i].shape);
+				CHECK(results[i].position.is_equal_approx(expected[i].position));
+				CHECK(results[i].normal.is_equal_approx(expected[i].normal));
+			}
+		}
+	}
+
+	SUBCASE("Shapes") {
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = sphere_shape;
+
+		constexpr int RESULT_MAX = 8;
+		LocalVector<Transform3D> transforms;
+		transforms.resize(QUERY_COUNT);
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> expected;
+		expected.resize(QUERY_COUNT * RESULT_MAX);
+		LocalVector<int> expected_counts;
+		expected_counts.resize(QUERY_COUNT);
+		int expected_hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			transforms[i] = Transform3D(Basis(), from[i]);
+			parameters.transform = transforms[i];
+			expected_counts[i] = space_state->intersect_shape(parameters, expected.ptr() + i * RESULT_MAX, RESULT_MAX);
+			if (expected_counts[i] > 0) {
+				expected_hit_count++;
+			}
+		}
+		CHECK(expected_hit_count > 0);
+		CHECK(expected_hit_count < QUERY_COUNT);
+
+		for (bool use_threads : { false, true }) {
+			LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+			results.resize(QUERY_COUNT * RESULT_MAX);
+			LocalVector<int> result_counts;
+			result_counts.resize(QUERY_COUNT);
+			CHECK(space_state->intersect_shapes(parameters, transforms.ptr(), QUERY_COUNT, results.ptr(), RESULT_MAX, result_counts.ptr(), use_threads) == expected_hit_count);
+			for (int i = 0; i < QUERY_COUNT; i++) {
+				REQUIRE(result_counts[i] == expected_counts[i]);
+				for (int j = 0; j < result_counts[i]; j++) {
+					CHECK(results[i * RESULT_MAX + j].rid == expected[i * RESULT_MAX + j].rid);
+				}
+			}
+		}
+
+		// Failing queries must still set every count, callers read them all.
+		parameters.shape_rid = RID();
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+		results.resize(QUERY_COUNT * RESULT_MAX);
+		LocalVector<int> result_counts;
+		result_counts.resize(QUERY_COUNT);
+		for (int &count : result_counts) {
+			count = -1;
+		}
+		ERR_PRINT_OFF;
+		CHECK(space_state->intersect_shapes(parameters, transforms.ptr(), QUERY_COUNT, results.ptr(), RESULT_MAX, result_counts.ptr()) == 0);
+		ERR_PRINT_ON;
+		for (int count : result_counts) {
+			CHECK(count == 0);
+		}
+	}
+
+	free_spaces({ space }, bodies);
+	ps->free_rid(box_shape);
+	ps->free_rid(floor_shape);
+	ps->free_rid(sphere_shape);
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+// Compares casting the rays one by one against casting them as a batch.
+TEST_CASE("[Modules][GodotPhysics3D][Benchmark] Casting many rays" * doctest::skip()) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID floor_shape = ps->box_shape_create();
+	ps->shape_set_data(floor_shape, Vector3(200, 1, 200));
+
+	LocalVector<RID> bodies;
+	RID space = create_space_with_static_boxes(box_shape, floor_shape, 100, bodies);
+	PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+
+	constexpr int RAY_COUNT = 100000;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	make_random_rays(RAY_COUNT, 150, from, to);
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(RAY_COUNT);
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < RAY_COUNT; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		space_state->intersect_ray(parameters, results[i]);
+	}
+	print_line(vformat("%d rays one by one: %d usec.", RAY_COUNT, OS::get_singleton()->get_ticks_usec() - begin));
+
+	for (bool use_threads : { false, true }) {
+		begin = OS::get_singleton()->get_ticks_usec();
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), RAY_COUNT, results.ptr(), use_threads);
+		print_line(vformat("%d rays in a batch%s: %d usec.", RAY_COUNT, use_threads ? " on threads" : "", OS::get_singleton()->get_ticks_usec() - begin));
+	}
+
+	free_spaces({ space }, bodies);
+	ps->free_rid(box_shape);
+	ps->free_rid(floor_shape);
+}
+
+} // namespace TestGodotPhysicsServer3D
@@ -53,6 +53,8 @@
 #include "spaces/jolt_physics_direct_space_state_3d.h"
 #include "spaces/jolt_space_3d.h"
 
+#include "core/profiling/profiling.h"
+
 JoltPhysicsServer3D::JoltPhysicsServer3D(bool p_on_separate_thread) :
 		on_separate_thread(p_on_separate_thread) {
 	singleton = this;
@@ -1615,6 +1617,8 @@ void JoltPhysicsServer3D::finish() {
 }
 
 void JoltPhysicsServer3D::step(real_t p_step) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_PHYSICS);
+	GodotProfileZone("JoltPhysicsServer3D::step");
 	if (!active) {
 		return;
 	}
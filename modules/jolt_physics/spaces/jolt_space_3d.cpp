@@ -46,6 +46,7 @@
 
 #include "core/io/file_access.h"
 #include "core/os/time.h"
+#include "core/profiling/profiling.h"
 #include "core/string/print_string.h"
 #include "core/variant/variant_utility.h"
 
@@ -182,6 +183,7 @@ JoltSpace3D::~JoltSpace3D() {
 }
 
 void JoltSpace3D::step(float p_step) {
+	GodotProfileZone("JoltSpace3D::step");
 	stepping = true;
 	last_step = p_step;
 
@@ -40,6 +40,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/profiling/profiling.h"
 #include "servers/navigation_2d/navigation_server_2d.h"
 
 #include <Obstacle2d.h>
@@ -371,6 +372,7 @@ void NavMap2D::_sync_iteration() {
 }
 
 void NavMap2D::sync() {
+	GodotProfileZone("NavMap2D::sync");
 	// Performance Monitor.
 	performance_data.pm_region_count = regions.size();
 	performance_data.pm_agent_count = agents.size();
@@ -525,6 +527,7 @@ void NavMap2D::compute_single_avoidance_step(uint32_t p_index, NavAgent2D **p_ag
 }
 
 void NavMap2D::step(double p_delta_time) {
+	GodotProfileZone("NavMap2D::step");
 	rvo_simulation.setTimeStep(float(p_delta_time));
 
 	if (active_avoidance_agents.size() > 0) {
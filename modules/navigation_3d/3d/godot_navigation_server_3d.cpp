@@ -31,6 +31,7 @@
 #include "godot_navigation_server_3d.h"
 
 #include "core/os/mutex.h"
+#include "core/profiling/profiling.h"
 #include "scene/main/node.h"
 
 #include "nav_mesh_generator_3d.h"
@@ -1381,12 +1382,14 @@ void GodotNavigationServer3D::process(double p_delta_time) {
 }
 
 void GodotNavigationServer3D::physics_process(double p_delta_time) {
+	GodotProfileZone("GodotNavigationServer3D::physics_process");
 	// Called for each physics process step AFTER node and user script physics_process() and BEFORE PhysicsServer sync.
 	// Will NOT run reliably every rendered frame. If there is no physics step this function will not run.
 	// Use for physics or step depending calculations and updates where the result affects the next step calculation.
 	// E.g. anything physics sync related, avoidance simulations, physics space state queries, ...
 	// If physics process needs to play catchup this function will be called multiple times per frame so it should not hold
 	// costly updates that are not important outside the stepped calculations to avoid causing a physics performance death spiral.
+	MemoryTagScope memory_tag_scope(Memory::TAG_NAVIGATION);
 
 	flush_queries();
 
@@ -36,6 +36,7 @@
 
 #include "core/math/geometry_2d.h"
 #include "core/math/geometry_3d.h"
+#include "core/os/frame_arena.h"
 
 using namespace Nav3D;
 
@@ -1037,7 +1038,8 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 		return Vector3();
 	}
 
-	LocalVector<uint32_t> accessible_regions;
+	FrameArenaScope arena_scope;
+	FrameLocalVector<uint32_t> accessible_regions;
 	accessible_regions.reserve(p_map_iteration.region_iterations.size());
 
 	for (uint32_t i = 0; i < p_map_iteration.region_iterations.size(); i++) {
@@ -1055,7 +1057,7 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 
 	if (p_uniformly) {
 		real_t accumulated_region_surface_area = 0;
-		RBMap<real_t, uint32_t> accessible_regions_area_map;
+		RBMap<real_t, uint32_t, Comparator<real_t>, FrameArenaAllocator> accessible_regions_area_map;
 
 		for (uint32_t accessible_region_index = 0; accessible_region_index < accessible_regions.size(); accessible_region_index++) {
 			const Ref<NavRegionIteration3D> &region = p_map_iteration.region_iterations[accessible_regions[accessible_region_index]];
@@ -1076,7 +1078,7 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 
 		real_t random_accessible_regions_area_map = Math::random(real_t(0), accumulated_region_surface_area);
 
-		RBMap<real_t, uint32_t>::Iterator E = accessible_regions_area_map.find_closest(random_accessible_regions_area_map);
+		RBMap<real_t, uint32_t, Comparator<real_t>, FrameArenaAllocator>::Iterator E = accessible_regions_area_map.find_closest(random_accessible_regions_area_map);
 		ERR_FAIL_COND_V(!E, Vector3());
 		uint32_t random_region_index = E->value;
 		ERR_FAIL_UNSIGNED_INDEX_V(random_region_index, accessible_regions.size(), Vector3());
@@ -40,6 +40,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/profiling/profiling.h"
 #include "servers/navigation_3d/navigation_server_3d.h"
 
 #include <Obstacle2d.h>
@@ -427,6 +428,7 @@ void NavMap3D::_sync_iteration() {
 }
 
 void NavMap3D::sync() {
+	GodotProfileZone("NavMap3D::sync");
 	// Performance Monitor.
 	performance_data.pm_region_count = regions.size();
 	performance_data.pm_agent_count = agents.size();
@@ -607,6 +609,7 @@ void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **age
 }
 
 void NavMap3D::step(double p_delta_time) {
+	GodotProfileZone("NavMap3D::step");
 	rvo_simulation_2d.setTimeStep(float(p_delta_time));
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
@@ -36,6 +36,7 @@
 #include "core/io/resource_loader.h"
 #include "core/math/audio_frame.h"
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
 #include "scene/scene_string_names.h"
@@ -259,6 +260,8 @@ AudioDriver *AudioDriverManager::get_driver(int p_driver) {
 //////////////////////////////////////////////
 
 void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
+	MemoryTagScope memory_tag_scope(Memory::TAG_AUDIO);
+	GodotProfileZone("AudioServer::_driver_process");
 	mix_count++;
 	int todo = p_frames;
 
@@ -339,6 +342,7 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 }
 
 void AudioServer::_mix_step() {
+	GodotProfileZone("AudioServer::_mix_step");
 	bool solo_mode = false;
 
 	for (int i = 0; i < buses.size(); i++) {
@@ -35,6 +35,7 @@
 #include "core/debugger/engine_profiler.h"
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
+#include "core/profiling/profiling.h"
 #include "servers/display/display_server.h"
 
 #define CHECK_SIZE(arr, expected, what) ERR_FAIL_COND_V_MSG((uint32_t)arr.size() < (uint32_t)(expected), false, String("Malformed ") + what + " message from script debugger, message too short. Expected size: " + itos(expected) + ", actual size: " + itos(arr.size()))
@@ -72,6 +73,67 @@ bool ServersDebugger::ResourceUsage::deserialize(const Array &p_arr) {
 	return true;
 }
 
+Array ServersDebugger::MemoryTagUsage::serialize() {
+	Array arr;
+	arr.push_back(tags.size() * 5);
+	for (const MemoryTagInfo &tag : tags) {
+		arr.push_back(tag.name);
+		arr.push_back(tag.bytes);
+		arr.push_back(tag.max_bytes);
+		arr.push_back(tag.allocations);
+		arr.push_back(tag.total_allocations);
+	}
+	arr.push_back(samples.size() * 4);
+	for (const AllocationSampleInfo &sample : samples) {
+		Array call_stack;
+		for (uint64_t address : sample.call_stack) {
+			call_stack.push_back(address);
+		}
+		arr.push_back(call_stack);
+		arr.push_back(sample.tag);
+		arr.push_back(sample.count);
+		arr.push_back(sample.bytes);
+	}
+	return arr;
+}
+
+bool ServersDebugger::MemoryTagUsage::deserialize(const Array &p_arr) {
+	CHECK_SIZE(p_arr, 1, "MemoryTagUsage");
+	uint32_t size = p_arr[0];
+	ERR_FAIL_COND_V(size % 5, false);
+	CHECK_SIZE(p_arr, 2 + size, "MemoryTagUsage");
+	uint32_t idx = 1;
+	while (idx < 1 + size) {
+		MemoryTagInfo tag;
+		tag.name = p_arr[idx];
+		tag.bytes = p_arr[idx + 1];
+		tag.max_bytes = p_arr[idx + 2];
+		tag.allocations = p_arr[idx + 3];
+		tag.total_allocations = p_arr[idx + 4];
+		tags.push_back(tag);
+		idx += 5;
+	}
+	size = p_arr[idx];
+	ERR_FAIL_COND_V(size % 4, false);
+	idx++;
+	CHECK_SIZE(p_arr, idx + size, "MemoryTagUsage");
+	const uint32_t end = idx + size;
+	while (idx < end) {
+		AllocationSampleInfo sample;
+		const Array call_stack = p_arr[idx];
+		for (int i = 0; i < call_stack.size(); i++) {
+			sample.call_stack.push_back(call_stack[i]);
+		}
+		sample.tag = p_arr[idx + 1];
+		sample.count = p_arr[idx + 2];
+		sample.bytes = p_arr[idx + 3];
+		samples.push_back(sample);
+		idx += 4;
+	}
+	CHECK_END(p_arr, idx, "MemoryTagUsage");
+	return true;
+}
+
 Array ServersDebugger::ScriptFunctionSignature::serialize() {
 	return Array{ name, id };
 }
@@ -402,6 +464,27 @@ Error ServersDebugger::_capture(void *p_user, const String &p_cmd, const Array &
 	r_captured = true;
 	if (p_cmd == "memory") {
 		singleton->_send_resource_usage();
+	} else if (p_cmd == "memory_tags") {
+		// Optionally takes the allocation sampling interval, 0 disabling sampling.
+		if (p_data.size() > 0) {
+			Memory::set_allocation_sample_interval(p_data[0]);
+			Memory::clear_allocation_samples();
+		}
+		singleton->_send_memory_tag_usage();
+	} else if (p_cmd == "trace") {
+		// Optionally takes whether to record, starting over when enabling it.
+		// Sends what was recorded so far, as a Chrome trace.
+#ifdef GODOT_USE_BUILTIN_TRACER
+		if (p_data.size() > 0) {
+			if (bool(p_data[0]) && !BuiltinTracer::is_enabled()) {
+				BuiltinTracer::clear();
+			}
+			BuiltinTracer::set_enabled(p_data[0]);
+		}
+		EngineDebugger::get_singleton()->send_message("servers:trace", Array{ BuiltinTracer::get_chrome_trace() });
+#else
+		ERR_PRINT("The built-in tracer isn't available when building with an external profiler.");
+#endif
 	} else if (p_cmd == "draw") { // Forced redraw.
 		// For camera override to stay live when the game is paused from the editor.
 		double delta = 0.0;
@@ -492,6 +575,38 @@ void ServersDebugger::_send_resource_usage() {
 	EngineDebugger::get_singleton()->send_message("servers:memory_usage", usage.serialize());
 }
 
+void ServersDebugger::_send_memory_tag_usage() {
+	ServersDebugger::MemoryTagUsage usage;
+
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		const Memory::Tag tag = Memory::Tag(i);
+		const Memory::TagUsage tag_usage = Memory::get_tag_usage(tag);
+		MemoryTagInfo info;
+		info.name = Memory::get_tag_name(tag);
+		info.bytes = tag_usage.bytes;
+		info.max_bytes = tag_usage.max_bytes;
+		info.allocations = tag_usage.allocations;
+		info.total_allocations = tag_usage.total_allocations;
+		usage.tags.push_back(info);
+	}
+
+	const uint32_t max_samples = 256;
+	Memory::AllocationSample samples[max_samples];
+	const uint32_t sample_count = Memory::get_allocation_samples(samples, max_samples);
+	for (uint32_t i = 0; i < sample_count; i++) {
+		AllocationSampleInfo info;
+		for (int j = 0; j < Memory::AllocationSample::CALL_STACK_DEPTH && samples[i].call_stack[j]; j++) {
+			info.call_stack.push_back((uint64_t)(uintptr_t)samples[i].call_stack[j]);
+		}
+		info.tag = Memory::get_tag_name(samples[i].tag);
+		info.count = samples[i].count;
+		info.bytes = samples[i].bytes;
+		usage.samples.push_back(info);
+	}
+
+	EngineDebugger::get_singleton()->send_message("servers:memory_tag_usage", usage.serialize());
+}
+
 // Done on a best-effort basis.
 String ServersDebugger::_get_resource_type_from_path(const String &p_path) {
 	if (p_path.is_empty()) {
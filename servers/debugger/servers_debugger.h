@@ -51,6 +51,30 @@ public:
 		bool deserialize(const Array &p_arr);
 	};
 
+	// Memory usage per subsystem, as tracked by Memory in debug builds.
+	struct MemoryTagInfo {
+		String name;
+		uint64_t bytes = 0;
+		uint64_t max_bytes = 0;
+		uint64_t allocations = 0;
+		uint64_t total_allocations = 0;
+	};
+
+	struct AllocationSampleInfo {
+		Vector<uint64_t> call_stack; // Return addresses, to be symbolized by the receiver.
+		String tag;
+		uint64_t count = 0;
+		uint64_t bytes = 0;
+	};
+
+	struct MemoryTagUsage {
+		Vector<MemoryTagInfo> tags;
+		Vector<AllocationSampleInfo> samples;
+
+		Array serialize();
+		bool deserialize(const Array &p_arr);
+	};
+
 	// Script Profiler
 	struct ScriptFunctionSignature {
 		StringName name;
@@ -117,6 +141,7 @@ private:
 	static Error _capture(void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured);
 
 	void _send_resource_usage();
+	void _send_memory_tag_usage();
 	String _get_resource_type_from_path(const String &p_path);
 
 	ServersDebugger();
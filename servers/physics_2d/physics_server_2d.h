@@ -283,6 +283,13 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Deterministic spaces give the same results for the same steps from the same state, with the same build.
+	// Snapshots save the state of a space, to step it again from there. The physics server may not support them.
+	virtual void space_set_deterministic(RID p_space, bool p_enabled);
+	virtual bool space_is_deterministic(RID p_space) const;
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const;
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot);
+
 	//missing space parameters
 
 	/* AREA API */
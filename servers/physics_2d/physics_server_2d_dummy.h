@@ -164,6 +164,11 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override { return Vector<Vector2>(); }
 	virtual int space_get_contact_count(RID p_space) const override { return 0; }
 
+	virtual void space_set_deterministic(RID p_space, bool p_enabled) override {}
+	virtual bool space_is_deterministic(RID p_space) const override { return false; }
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const override { return Vector<uint8_t>(); }
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override { return OK; }
+
 	/* AREA API */
 
 	virtual RID area_create() override { return RID(); }
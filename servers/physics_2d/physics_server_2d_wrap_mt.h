@@ -117,6 +117,11 @@ public:
 		return physics_server_2d->space_get_direct_state(p_space);
 	}
 
+	FUNC2(space_set_deterministic, RID, bool);
+	FUNC1RC(bool, space_is_deterministic, RID);
+	FUNC1RC(Vector<uint8_t>, space_get_snapshot, RID);
+	FUNC2R(Error, space_restore_snapshot, RID, const Vector<uint8_t> &);
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), Vector<Vector2>());
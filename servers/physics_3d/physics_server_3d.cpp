@@ -382,6 +382,54 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(RequiredParam<PhysicsRayQue
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to, bool p_use_threads) {
+	EXTRACT_PARAM_OR_FAIL_V(p_ray_query, rp_ray_query, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The arrays of ray origins and ends must have the same size.");
+
+	const int ray_count = p_from.size();
+	LocalVector<RayResult> results;
+	results.resize(ray_count);
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), ray_count, results.ptr(), p_use_threads);
+
+	PackedVector3Array positions;
+	positions.resize(ray_count);
+	PackedVector3Array normals;
+	normals.resize(ray_count);
+	PackedInt32Array face_indices;
+	face_indices.resize(ray_count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(ray_count);
+	PackedInt32Array shapes;
+	shapes.resize(ray_count);
+	TypedArray<RID> rids;
+	rids.resize(ray_count);
+
+	Vector3 *positions_ptrw = positions.ptrw();
+	Vector3 *normals_ptrw = normals.ptrw();
+	int32_t *face_indices_ptrw = face_indices.ptrw();
+	int64_t *collider_ids_ptrw = collider_ids.ptrw();
+	int32_t *shapes_ptrw = shapes.ptrw();
+	for (int i = 0; i < ray_count; i++) {
+		const RayResult &result = results[i];
+		positions_ptrw[i] = result.position;
+		normals_ptrw[i] = result.normal;
+		face_indices_ptrw[i] = result.face_index;
+		collider_ids_ptrw[i] = int64_t(result.collider_id);
+		shapes_ptrw[i] = result.shape;
+		rids[i] = result.rid;
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["face_index"] = face_indices;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+
+	return d;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, int p_max_results) {
 	EXTRACT_PARAM_OR_FAIL_V(p_point_query, rp_point_query, TypedArray<Dictionary>());
 
@@ -427,6 +475,52 @@ TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_shape(RequiredParam
 	return ret;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_shapes(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, const TypedArray<Transform3D> &p_transforms, int p_max_results, bool p_use_threads) {
+	EXTRACT_PARAM_OR_FAIL_V(p_shape_query, rp_shape_query, Dictionary());
+	ERR_FAIL_COND_V(p_max_results < 0, Dictionary());
+
+	const int query_count = p_transforms.size();
+	LocalVector<Transform3D> transforms;
+	transforms.resize(query_count);
+	for (int i = 0; i < query_count; i++) {
+		transforms[i] = p_transforms[i];
+	}
+
+	LocalVector<ShapeResult> results;
+	results.resize(query_count * p_max_results);
+	PackedInt32Array result_counts;
+	result_counts.resize_initialized(query_count);
+	intersect_shapes(p_shape_query->get_parameters(), transforms.ptr(), query_count, results.ptr(), p_max_results, result_counts.ptrw(), p_use_threads);
+
+	PackedInt64Array collider_ids;
+	collider_ids.resize_initialized(results.size());
+	PackedInt32Array shapes;
+	shapes.resize(results.size());
+	shapes.fill(-1);
+	TypedArray<RID> rids;
+	rids.resize(results.size());
+
+	int64_t *collider_ids_ptrw = collider_ids.ptrw();
+	int32_t *shapes_ptrw = shapes.ptrw();
+	for (int i = 0; i < query_count; i++) {
+		// The slots past the results of each query are left empty: a null ID, shape -1 and an invalid RID.
+		for (int j = 0; j < result_counts[i]; j++) {
+			const int index = i * p_max_results + j;
+			collider_ids_ptrw[index] = int64_t(results[index].collider_id);
+			shapes_ptrw[index] = results[index].shape;
+			rids[index] = results[index].rid;
+		}
+	}
+
+	Dictionary d;
+	d["result_count"] = result_counts;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+
+	return d;
+}
+
 Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query) {
 	EXTRACT_PARAM_OR_FAIL_V(p_shape_query, rp_shape_query, Vector<real_t>());
 
@@ -481,13 +575,42 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(RequiredParam<PhysicsShapeQ
 	return r;
 }
 
+int PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads) {
+	RayParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_results[i] = RayResult();
+		if (intersect_ray(parameters, r_results[i])) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
+int PhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_query_count, ShapeResult *r_results, int p_result_max, int *r_result_counts, bool p_use_threads) {
+	ShapeParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		parameters.transform = p_transforms[i];
+		r_result_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+		if (r_result_counts[i] > 0) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to", "use_threads"), &PhysicsDirectSpaceState3D::_intersect_rays, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("intersect_shapes", "parameters", "transforms", "max_results", "use_threads"), &PhysicsDirectSpaceState3D::_intersect_shapes, DEFVAL(32), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
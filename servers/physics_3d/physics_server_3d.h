@@ -127,8 +127,10 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query);
+	Dictionary _intersect_rays(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to, bool p_use_threads = false);
 	TypedArray<Dictionary> _intersect_point(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, int p_max_results = 32);
+	Dictionary _intersect_shapes(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, const TypedArray<Transform3D> &p_transforms, int p_max_results = 32, bool p_use_threads = false);
 	Vector<real_t> _cast_motion(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
 	TypedArray<Vector3> _collide_shape(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
@@ -164,6 +166,11 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts a ray from each of `p_from` to the same index of `p_to`, with the other parameters shared by all rays.
+	// Each ray has its result at the same index of `r_results`, with an invalid `rid` if it didn't hit anything.
+	// Returns the number of rays that hit something. The default implementation calls `intersect_ray()` for each ray.
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool p_use_threads = false);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -204,6 +211,10 @@ public:
 	};
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
+	// Intersects the shape placed at each of `p_transforms`, with the other parameters shared by all queries.
+	// Each query has up to `p_result_max` results starting at `r_results[index * p_result_max]`, and their count in `r_result_counts`.
+	// Returns the number of queries that found something. The default implementation calls `intersect_shape()` for each query.
+	virtual int intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_query_count, ShapeResult *r_results, int p_result_max, int *r_result_counts, bool p_use_threads = false);
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) = 0;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
@@ -30,6 +30,8 @@
 
 #include "mesh_storage.h"
 
+#include "core/math/batch_math.h"
+
 using namespace RendererRD;
 
 MeshStorage *MeshStorage::singleton = nullptr;
@@ -718,6 +720,7 @@ AABB MeshStorage::mesh_get_aabb(RID p_mesh, RID p_skeleton) {
 	}
 
 	AABB aabb;
+	LocalVector<AABB> skeleton_space_bone_aabbs;
 
 	for (uint32_t i = 0; i < mesh->surface_count; i++) {
 		AABB laabb;
@@ -730,6 +733,10 @@ AABB MeshStorage::mesh_get_aabb(RID p_mesh, RID p_skeleton) {
 			ERR_CONTINUE(bs > sbs);
 			const float *baseptr = skeleton->data.ptr();
 
+			// Transform bounds to skeleton's space before applying animation data.
+			skeleton_space_bone_aabbs.resize(bs);
+			BatchMath::xform_aabbs(surface.mesh_to_skeleton_xform, skbones, skeleton_space_bone_aabbs.ptr(), bs);
+
 			bool found_bone_aabb = false;
 
 			if (skeleton->use_2d) {
@@ -750,9 +757,7 @@ AABB MeshStorage::mesh_get_aabb(RID p_mesh, RID p_skeleton) {
 					mtx.basis.rows[1][1] = dataptr[5];
 					mtx.origin.y = dataptr[7];
 
-					// Transform bounds to skeleton's space before applying animation data.
-					AABB baabb = surface.mesh_to_skeleton_xform.xform(skbones[j]);
-					baabb = mtx.xform(baabb);
+					AABB baabb = mtx.xform(skeleton_space_bone_aabbs[j]);
 
 					if (!found_bone_aabb) {
 						laabb = baabb;
@@ -784,9 +789,7 @@ AABB MeshStorage::mesh_get_aabb(RID p_mesh, RID p_skeleton) {
 					mtx.basis.rows[2][2] = dataptr[10];
 					mtx.origin.z = dataptr[11];
 
-					// Transform bounds to skeleton's space before applying animation data.
-					AABB baabb = surface.mesh_to_skeleton_xform.xform(skbones[j]);
-					baabb = mtx.xform(baabb);
+					AABB baabb = mtx.xform(skeleton_space_bone_aabbs[j]);
 
 					if (!found_bone_aabb) {
 						laabb = baabb;
@@ -0,0 +1,332 @@
+/**************************************************************************/
+/*  test_batch_math.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/batch_math.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBatchMath {
+
+static Vector3 random_vector3(RandomPCG &p_rng) {
+	return Vector3(p_rng.random(-10.0f, 10.0f), p_rng.random(-10.0f, 10.0f), p_rng.random(-10.0f, 10.0f));
+}
+
+static AABB random_aabb(RandomPCG &p_rng) {
+	return AABB(random_vector3(p_rng), random_vector3(p_rng).abs());
+}
+
+static Transform3D random_transform(RandomPCG &p_rng) {
+	return Transform3D(Basis(random_vector3(p_rng), random_vector3(p_rng), random_vector3(p_rng)), random_vector3(p_rng));
+}
+
+// Odd counts, so both the vectorized loops and their remainders are exercised.
+static const uint32_t test_counts[] = { 0, 1, 3, 4, 5, 8, 13, 64, 67 };
+
+TEST_CASE("[BatchMath] Transforming points") {
+	RandomPCG rng(1);
+	const Transform3D xform = random_transform(rng);
+
+	for (uint32_t count : test_counts) {
+		LocalVector<Vector3> src;
+		for (uint32_t i = 0; i < count; i++) {
+			src.push_back(random_vector3(rng));
+		}
+		LocalVector<Vector3> dst;
+		dst.resize(count);
+		BatchMath::xform_points(xform, src.ptr(), dst.ptr(), count);
+
+		bool all_equal = true;
+		for (uint32_t i = 0; i < count; i++) {
+			all_equal &= dst[i].is_equal_approx(xform.xform(src[i]));
+		}
+		CHECK_MESSAGE(all_equal, vformat("Transformed points should match Transform3D::xform() (count %d).", count));
+
+		// In place.
+		BatchMath::xform_points(xform, src.ptr(), src.ptr(), count);
+		all_equal = true;
+		for (uint32_t i = 0; i < count; i++) {
+			all_equal &= src[i].is_equal_approx(dst[i]);
+		}
+		CHECK_MESSAGE(all_equal, vformat("Transforming points in place should give the same result (count %d).", count));
+	}
+}
+
+TEST_CASE("[BatchMath] Transforming AABBs") {
+	RandomPCG rng(2);
+	const Transform3D xform = random_transform(rng);
+
+	for (uint32_t count : test_counts) {
+		LocalVector<AABB> src;
+		for (uint32_t i = 0; i < count; i++) {
+			src.push_back(random_aabb(rng));
+		}
+		LocalVector<AABB> dst;
+		dst.resize(count);
+		BatchMath::xform_aabbs(xform, src.ptr(), dst.ptr(), count);
+
+		bool all_equal = true;
+		for (uint32_t i = 0; i < count; i++) {
+			all_equal &= dst[i].is_equal_approx(xform.xform(src[i]));
+		}
+		CHECK_MESSAGE(all_equal, vformat("Transformed AABBs should match Transform3D::xform() (count %d).", count));
+	}
+}
+
+TEST_CASE("[BatchMath] Transforming transforms") {
+	RandomPCG rng(3);
+	const Transform3D xform = random_transform(rng);
+
+	for (uint32_t count : test_counts) {
+		LocalVector<Transform3D> src;
+		for (uint32_t i = 0; i < count; i++) {
+			src.push_back(random_transform(rng));
+		}
+		LocalVector<Transform3D> dst;
+		dst.resize(count);
+		BatchMath::xform_transforms(xform, src.ptr(), dst.ptr(), count);
+
+		bool all_equal = true;
+		for (uint32_t i = 0; i < count; i++) {
+			all_equal &= dst[i].is_equal_approx(xform * src[i]);
+		}
+		CHECK_MESSAGE(all_equal, vformat("Composed transforms should match Transform3D::operator*() (count %d).", count));
+
+		// In place.
+		BatchMath::xform_transforms(xform, src.ptr(), src.ptr(), count);
+		all_equal = true;
+		for (uint32_t i = 0; i < count; i++) {
+			all_equal &= src[i].is_equal_approx(dst[i]);
+		}
+		CHECK_MESSAGE(all_equal, vformat("Composing transforms in place should give the same result (count %d).", count));
+	}
+}
+
+TEST_CASE("[BatchMath] AABB intersection") {
+	const AABB aabb = AABB(Vector3(0, 0, 0), Vector3(1, 1, 1));
+	const AABB aabbs[] = {
+		AABB(Vector3(0.5, 0.5, 0.5), Vector3(1, 1, 1)), // Overlapping.
+		AABB(Vector3(1, 0, 0), Vector3(1, 1, 1)), // Touching faces only.
+		AABB(Vector3(-2, -2, -2), Vector3(5, 5, 5)), // Enclosing.
+		AABB(Vector3(0.5, 3, 0.5), Vector3(1, 1, 1)), // Separated on Y only.
+		AABB(Vector3(0.25, 0.25, 0.25), Vector3(0.5, 0.5, 0.5)), // Enclosed.
+	};
+	uint32_t indices[5];
+	const uint32_t found = BatchMath::aabbs_intersect(aabb, aabbs, 5, indices);
+	CHECK_MESSAGE(found == 3, "Only the overlapping AABBs should be reported, as in AABB::intersects().");
+	CHECK(indices[0] == 0);
+	CHECK(indices[1] == 2);
+	CHECK(indices[2] == 4);
+
+	RandomPCG rng(4);
+	LocalVector<AABB> random_aabbs;
+	for (int i = 0; i < 1000; i++) {
+		random_aabbs.push_back(random_aabb(rng));
+	}
+	LocalVector<uint32_t> batch_indices;
+	batch_indices.resize(random_aabbs.size());
+	LocalVector<uint32_t> scalar_indices;
+	scalar_indices.resize(random_aabbs.size());
+	const uint32_t batch_found = BatchMath::aabbs_intersect(random_aabbs[0], random_aabbs.ptr(), random_aabbs.size(), batch_indices.ptr());
+	const uint32_t scalar_found = BatchMath::aabbs_intersect_scalar(random_aabbs[0], random_aabbs.ptr(), random_aabbs.size(), scalar_indices.ptr());
+	CHECK(batch_found == scalar_found);
+	bool all_equal = true;
+	for (uint32_t i = 0; i < MIN(batch_found, scalar_found); i++) {
+		all_equal &= batch_indices[i] == scalar_indices[i];
+	}
+	CHECK_MESSAGE(all_equal, "Batched and scalar intersection tests should report the same AABBs.");
+}
+
+TEST_CASE("[BatchMath] Projecting boxes and points onto axes") {
+	RandomPCG rng(6);
+	const Transform3D xform = random_transform(rng);
+	const Vector3 half_extents = random_vector3(rng).abs();
+	LocalVector<Vector3> points;
+	for (int i = 0; i < 13; i++) {
+		points.push_back(random_vector3(rng));
+	}
+
+	// Physics relies on these matching the scalar versions exactly, not only approximately.
+	for (uint32_t count : test_counts) {
+		LocalVector<Vector3> axes;
+		for (uint32_t i = 0; i < count; i++) {
+			axes.push_back(random_vector3(rng).normalized());
+		}
+		LocalVector<real_t> min, max, expected_min, expected_max;
+		min.resize(count);
+		max.resize(count);
+		expected_min.resize(count);
+		expected_max.resize(count);
+
+		BatchMath::project_box(xform, half_extents, axes.ptr(), min.ptr(), max.ptr(), count);
+		BatchMath::project_box_scalar(xform, half_extents, axes.ptr(), expected_min.ptr(), expected_max.ptr(), count);
+		bool all_equal = true;
+		for (uint32_t i = 0; i < count; i++) {
+			all_equal &= min[i] == expected_min[i] && max[i] == expected_max[i];
+			all_equal &= min[i] < max[i];
+		}
+		CHECK_MESSAGE(all_equal, vformat("Projected boxes should match the scalar version (count %d).", count));
+
+		for (uint32_t point_count : { 1, 4, 13 }) {
+			BatchMath::project_points(xform, points.ptr(), point_count, axes.ptr(), min.ptr(), max.ptr(), count);
+			BatchMath::project_points_scalar(xform, points.ptr(), point_count, axes.ptr(), expected_min.ptr(), expected_max.ptr(), count);
+			all_equal = true;
+			for (uint32_t i = 0; i < count; i++) {
+				all_equal &= min[i] == expected_min[i] && max[i] == expected_max[i];
+				all_equal &= min[i] <= max[i];
+			}
+			CHECK_MESSAGE(all_equal, vformat("Projected points should match the scalar version (count %d, %d points).", count, point_count));
+		}
+	}
+
+	// A unit cube along its own axes.
+	const Vector3 x_axis = Vector3(1, 0, 0);
+	real_t min = 0.0, max = 0.0;
+	BatchMath::project_box(Transform3D(Basis(), Vector3(2, 0, 0)), Vector3(0.5, 0.5, 0.5), &x_axis, &min, &max, 1);
+	CHECK(min == doctest::Approx(1.5));
+	CHECK(max == doctest::Approx(2.5));
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[BatchMath][Benchmark] Batched versus scalar operations" * doctest::skip()) {
+	const uint32_t count = 4096;
+	const int iterations = 1000;
+
+	RandomPCG rng(5);
+	const Transform3D xform = random_transform(rng);
+	LocalVector<Vector3> points;
+	LocalVector<AABB> aabbs;
+	LocalVector<Transform3D> transforms;
+	for (uint32_t i = 0; i < count; i++) {
+		points.push_back(random_vector3(rng));
+		aabbs.push_back(random_aabb(rng));
+		transforms.push_back(random_transform(rng));
+	}
+	LocalVector<Vector3> out_points;
+	out_points.resize(count);
+	LocalVector<AABB> out_aabbs;
+	out_aabbs.resize(count);
+	LocalVector<Transform3D> out_transforms;
+	out_transforms.resize(count);
+	LocalVector<uint32_t> indices;
+	indices.resize(count);
+
+	print_line(vformat("BatchMath backend: %s.", BatchMath::get_backend_name()));
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		BatchMath::xform_points_scalar(xform, points.ptr(), out_points.ptr(), count);
+	}
+	uint64_t scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		BatchMath::xform_points(xform, points.ptr(), out_points.ptr(), count);
+	}
+	print_line(vformat("xform_points: scalar %d usec, batched %d usec.", scalar_usec, OS::get_singleton()->get_ticks_usec() - begin));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		BatchMath::xform_aabbs_scalar(xform, aabbs.ptr(), out_aabbs.ptr(), count);
+	}
+	scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		BatchMath::xform_aabbs(xform, aabbs.ptr(), out_aabbs.ptr(), count);
+	}
+	print_line(vformat("xform_aabbs: scalar %d usec, batched %d usec.", scalar_usec, OS::get_singleton()->get_ticks_usec() - begin));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		BatchMath::xform_transforms_scalar(xform, transforms.ptr(), out_transforms.ptr(), count);
+	}
+	scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		BatchMath::xform_transforms(xform, transforms.ptr(), out_transforms.ptr(), count);
+	}
+	print_line(vformat("xform_transforms: scalar %d usec, batched %d usec.", scalar_usec, OS::get_singleton()->get_ticks_usec() - begin));
+
+	// Projecting onto eight axes, like the separating axis tests of physics do.
+	const uint32_t axis_count = 8;
+	LocalVector<real_t> min, max;
+	min.resize(axis_count);
+	max.resize(axis_count);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t j = 0; j + axis_count <= count; j += axis_count) {
+			BatchMath::project_box_scalar(transforms[j], points[j].abs(), points.ptr() + j, min.ptr(), max.ptr(), axis_count);
+		}
+	}
+	scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t j = 0; j + axis_count <= count; j += axis_count) {
+			BatchMath::project_box(transforms[j], points[j].abs(), points.ptr() + j, min.ptr(), max.ptr(), axis_count);
+		}
+	}
+	print_line(vformat("project_box: scalar %d usec, batched %d usec.", scalar_usec, OS::get_singleton()->get_ticks_usec() - begin));
+
+	const uint32_t point_count = 32;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t j = 0; j + point_count <= count; j += point_count) {
+			BatchMath::project_points_scalar(xform, points.ptr() + j, point_count, points.ptr() + i % (count - axis_count), min.ptr(), max.ptr(), axis_count);
+		}
+	}
+	scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t j = 0; j + point_count <= count; j += point_count) {
+			BatchMath::project_points(xform, points.ptr() + j, point_count, points.ptr() + i % (count - axis_count), min.ptr(), max.ptr(), axis_count);
+		}
+	}
+	print_line(vformat("project_points: scalar %d usec, batched %d usec.", scalar_usec, OS::get_singleton()->get_ticks_usec() - begin));
+
+	uint32_t found = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		found += BatchMath::aabbs_intersect_scalar(aabbs[i % count], aabbs.ptr(), count, indices.ptr());
+	}
+	scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		found -= BatchMath::aabbs_intersect(aabbs[i % count], aabbs.ptr(), count, indices.ptr());
+	}
+	print_line(vformat("aabbs_intersect: scalar %d usec, batched %d usec.", scalar_usec, OS::get_singleton()->get_ticks_usec() - begin));
+
+	CHECK(found == 0);
+}
+
+} // namespace TestBatchMath
@@ -33,6 +33,8 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -457,6 +459,84 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class _SignalListener : public Object {
+	GDCLASS(_SignalListener, Object);
+
+public:
+	Object *source = nullptr;
+	_SignalListener *other = nullptr;
+	int calls = 0;
+
+	void on_signal(int p_value) {
+		calls += p_value;
+	}
+
+	void disconnect_other(int p_value) {
+		calls += p_value;
+		const Callable callable = callable_mp(other, &_SignalListener::on_signal);
+		if (source->is_connected("my_custom_signal", callable)) {
+			source->disconnect("my_custom_signal", callable);
+		}
+	}
+};
+
+TEST_CASE("[Object] Connections changed while emitting apply to the next emission") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal", PropertyInfo(Variant::INT, "value")));
+
+	_SignalListener listeners[3];
+	listeners[0].source = &object;
+	listeners[0].other = &listeners[1];
+	object.connect("my_custom_signal", callable_mp(&listeners[0], &_SignalListener::disconnect_other));
+	object.connect("my_custom_signal", callable_mp(&listeners[1], &_SignalListener::on_signal));
+	object.connect("my_custom_signal", callable_mp(&listeners[2], &_SignalListener::on_signal), Object::CONNECT_ONE_SHOT);
+
+	object.emit_signal("my_custom_signal", 1);
+	CHECK(listeners[0].calls == 1);
+	CHECK_MESSAGE(listeners[1].calls == 1, "Slots disconnected while emitting should still be called by that emission.");
+	CHECK(listeners[2].calls == 1);
+
+	object.emit_signal("my_custom_signal", 1);
+	CHECK(listeners[0].calls == 2);
+	CHECK(listeners[1].calls == 1);
+	CHECK_MESSAGE(listeners[2].calls == 1, "One-shot slots should only be called once.");
+
+	object.connect("my_custom_signal", callable_mp(&listeners[1], &_SignalListener::on_signal));
+	object.emit_signal("my_custom_signal", 1);
+	CHECK(listeners[0].calls == 3);
+	CHECK_MESSAGE(listeners[1].calls == 2, "Slots connected again should be called by the next emission.");
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[Object][Benchmark] Emitting signals to many listeners" * doctest::skip()) {
+	const int listener_counts[] = { 1, 10, 1000 };
+	for (int listener_count : listener_counts) {
+		Object object;
+		object.add_user_signal(MethodInfo("my_custom_signal", PropertyInfo(Variant::INT, "value")));
+		LocalVector<_SignalListener *> listeners;
+		for (int i = 0; i < listener_count; i++) {
+			listeners.push_back(memnew(_SignalListener));
+			object.connect("my_custom_signal", callable_mp(listeners[i], &_SignalListener::on_signal));
+		}
+
+		const int emissions = 1000000 / listener_count;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emissions; i++) {
+			object.emit_signal("my_custom_signal", 1);
+		}
+		const uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+		print_line(vformat("Emitted a signal to %d listeners %d times: %d usec, %d calls/s.", listener_count, emissions, usec, (int64_t)((uint64_t)emissions * listener_count * 1000000ull / usec)));
+
+		int calls = 0;
+		for (_SignalListener *listener : listeners) {
+			calls += listener->calls;
+			memdelete(listener);
+		}
+		CHECK(calls == emissions * listener_count);
+	}
+}
+
 class NotificationObjectSuperclass : public Object {
 	GDCLASS(NotificationObjectSuperclass, Object);
 
@@ -634,4 +714,86 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+#ifdef THREADS_ENABLED
+struct ObjectDBStressData {
+	LocalVector<ObjectID> live_ids;
+	LocalVector<Object *> live_objects;
+	LocalVector<ObjectID> dead_ids;
+	SafeFlag exit;
+	SafeFlag mismatch;
+	SafeNumeric<uint64_t> lookups;
+};
+
+static void objectdb_stress_writer(void *p_userdata) {
+	ObjectDBStressData *data = (ObjectDBStressData *)p_userdata;
+	LocalVector<Object *> objects;
+	while (!data->exit.is_set()) {
+		// Churn slots, so the ones of dead IDs get reused.
+		for (int i = 0; i < 64; i++) {
+			objects.push_back(memnew(Object));
+		}
+		for (Object *object : objects) {
+			memdelete(object);
+		}
+		objects.clear();
+	}
+}
+
+static void objectdb_stress_reader(void *p_userdata) {
+	ObjectDBStressData *data = (ObjectDBStressData *)p_userdata;
+	while (!data->exit.is_set()) {
+		for (uint32_t i = 0; i < data->live_ids.size(); i++) {
+			if (ObjectDB::get_instance(data->live_ids[i]) != data->live_objects[i]) {
+				data->mismatch.set();
+			}
+		}
+		for (const ObjectID &id : data->dead_ids) {
+			if (ObjectDB::get_instance(id) != nullptr) {
+				data->mismatch.set();
+			}
+		}
+		data->lookups.add(data->live_ids.size() + data->dead_ids.size());
+	}
+}
+
+TEST_CASE("[Object] ObjectDB lookups while objects are created and freed on other threads") {
+	ObjectDBStressData data;
+	for (int i = 0; i < 256; i++) {
+		Object *object = memnew(Object);
+		data.live_objects.push_back(object);
+		data.live_ids.push_back(object->get_instance_id());
+	}
+	for (int i = 0; i < 256; i++) {
+		Object *object = memnew(Object);
+		data.dead_ids.push_back(object->get_instance_id());
+		memdelete(object);
+	}
+
+	const int thread_count = 4;
+	Thread writers[thread_count];
+	Thread readers[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		writers[i].start(objectdb_stress_writer, &data);
+		readers[i].start(objectdb_stress_reader, &data);
+	}
+
+	// Let them run for a while, but make sure every reader got some work done.
+	uint64_t begin = OS::get_singleton()->get_ticks_msec();
+	while (OS::get_singleton()->get_ticks_msec() - begin < 200 || data.lookups.get() < (uint64_t)thread_count * 512) {
+		OS::get_singleton()->delay_usec(1000);
+	}
+	data.exit.set();
+	for (int i = 0; i < thread_count; i++) {
+		writers[i].wait_to_finish();
+		readers[i].wait_to_finish();
+	}
+
+	CHECK_FALSE_MESSAGE(data.mismatch.is_set(), "Live IDs should always resolve to their object, and dead IDs to null.");
+
+	for (Object *object : data.live_objects) {
+		memdelete(object);
+	}
+}
+#endif // THREADS_ENABLED
+
 } // namespace TestObject
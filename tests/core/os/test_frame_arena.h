@@ -0,0 +1,188 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/frame_arena.h"
+#include "core/os/os.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/rb_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocation and alignment") {
+	FrameArena arena("Test");
+	CHECK(arena.get_used() == 0);
+	CHECK(arena.get_reserved() == 0);
+
+	uint8_t *a = (uint8_t *)arena.alloc(3);
+	uint8_t *b = (uint8_t *)arena.alloc(100);
+	CHECK(a != b);
+	CHECK_MESSAGE(((uintptr_t)a % Memory::MAX_ALIGN) == 0, "Allocations should be aligned like the global heap.");
+	CHECK(((uintptr_t)b % Memory::MAX_ALIGN) == 0);
+	CHECK(arena.get_used() > 0);
+	CHECK(arena.get_reserved() >= arena.get_used());
+
+	memset(a, 0xAA, 3);
+	memset(b, 0xBB, 100);
+	CHECK(a[2] == 0xAA);
+	CHECK(b[0] == 0xBB);
+
+	arena.reset();
+	CHECK(arena.get_used() == 0);
+	CHECK_MESSAGE(arena.get_reserved() > 0, "Memory should be kept around after resetting.");
+}
+
+TEST_CASE("[FrameArena] Scopes") {
+	FrameArena arena("Test");
+	arena.alloc(16);
+	const uint64_t outer_used = arena.get_used();
+	{
+		FrameArenaScope scope(&arena);
+		arena.alloc(1024);
+		{
+			FrameArenaScope nested_scope(&arena);
+			arena.alloc(1024 * 1024); // Needs a new chunk.
+		}
+		CHECK(arena.get_used() > outer_used);
+	}
+	CHECK_MESSAGE(arena.get_used() == outer_used, "Leaving a scope should free everything allocated in it.");
+	CHECK(arena.get_high_water_mark() > 1024 * 1024);
+
+	arena.reset();
+	const uint64_t reserved = arena.get_reserved();
+	{
+		FrameArenaScope scope(&arena);
+		arena.alloc(1024 * 1024);
+	}
+	CHECK_MESSAGE(arena.get_reserved() == reserved, "Once grown, the arena should reuse its memory.");
+}
+
+TEST_CASE("[FrameArena] Reallocation") {
+	FrameArena arena("Test");
+	FrameArenaScope scope(&arena);
+
+	uint32_t *a = (uint32_t *)arena.realloc(nullptr, sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		a[i] = i;
+	}
+	uint32_t *grown = (uint32_t *)arena.realloc(a, sizeof(uint32_t) * 64);
+	CHECK_MESSAGE(grown == a, "The most recent allocation should grow in place.");
+
+	uint32_t *b = (uint32_t *)arena.alloc(sizeof(uint32_t));
+	*b = 42;
+	uint32_t *moved = (uint32_t *)arena.realloc(grown, sizeof(uint32_t) * 128);
+	CHECK(moved != grown);
+	bool contents_kept = true;
+	for (uint32_t i = 0; i < 4; i++) {
+		contents_kept &= moved[i] == i;
+	}
+	CHECK_MESSAGE(contents_kept, "Reallocating should keep the contents.");
+	CHECK(*b == 42);
+}
+
+TEST_CASE("[FrameArena] Container adapters") {
+	FrameArenaScope scope;
+	const uint64_t used = FrameArena::get_thread_arena()->get_used();
+	{
+		FrameLocalVector<int> vector;
+		for (int i = 0; i < 1000; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == 1000);
+		CHECK(vector[999] == 999);
+
+		RBMap<int, int, Comparator<int>, FrameArenaAllocator> map;
+		HashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, FrameArenaTypedAllocator<HashMapElement<int, int>>> hash_map;
+		for (int i = 0; i < 100; i++) {
+			map.insert(i, i * 2);
+			hash_map.insert(i, i * 3);
+		}
+		CHECK(map[50] == 100);
+		CHECK(hash_map[50] == 150);
+		CHECK(FrameArena::get_thread_arena()->get_used() > used);
+	}
+}
+
+TEST_CASE("[FrameArena] Stats") {
+	const uint64_t total_reserved = FrameArena::get_total_reserved();
+	{
+		FrameArena arena("Stats test");
+		arena.alloc(100);
+		CHECK(FrameArena::get_total_reserved() == total_reserved + arena.get_reserved());
+
+		bool found = false;
+		for (const FrameArena::Stats &stats : FrameArena::get_arena_stats()) {
+			if (stats.name && String(stats.name) == "Stats test") {
+				found = true;
+				CHECK(stats.reserved == arena.get_reserved());
+				CHECK(stats.high_water_mark == arena.get_high_water_mark());
+			}
+		}
+		CHECK_MESSAGE(found, "Live arenas should be listed in the stats.");
+		arena.reset();
+	}
+	CHECK(FrameArena::get_total_reserved() == total_reserved);
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[FrameArena][Benchmark] Temporary vectors versus the heap" * doctest::skip()) {
+	const int iterations = 100000;
+	int64_t sum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		LocalVector<int> vector;
+		for (int j = 0; j < 64; j++) {
+			vector.push_back(j);
+		}
+		sum += vector[i % 64];
+	}
+	const uint64_t heap_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		FrameArenaScope scope;
+		FrameLocalVector<int> vector;
+		for (int j = 0; j < 64; j++) {
+			vector.push_back(j);
+		}
+		sum -= vector[i % 64];
+	}
+	const uint64_t arena_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("Temporary vectors: heap %d usec, frame arena %d usec.", heap_usec, arena_usec));
+	CHECK(sum == 0);
+}
+
+} // namespace TestFrameArena
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Memory] Per-subsystem accounting") {
+	const Memory::TagUsage before = Memory::get_tag_usage(Memory::TAG_AUDIO);
+	void *mem = nullptr;
+	{
+		MemoryTagScope scope(Memory::TAG_AUDIO);
+		CHECK(Memory::get_thread_tag() == Memory::TAG_AUDIO);
+		{
+			MemoryTagScope nested_scope(Memory::TAG_PHYSICS);
+			CHECK(Memory::get_thread_tag() == Memory::TAG_PHYSICS);
+		}
+		CHECK_MESSAGE(Memory::get_thread_tag() == Memory::TAG_AUDIO, "Leaving a scope should restore the previous tag.");
+		mem = memalloc(1000);
+	}
+	CHECK(Memory::get_thread_tag() == Memory::TAG_UNTAGGED);
+
+	Memory::TagUsage usage = Memory::get_tag_usage(Memory::TAG_AUDIO);
+	CHECK(usage.bytes == before.bytes + 1000);
+	CHECK(usage.max_bytes >= usage.bytes);
+	CHECK(usage.allocations == before.allocations + 1);
+	CHECK(usage.total_allocations == before.total_allocations + 1);
+
+	mem = memrealloc(mem, 2000);
+	usage = Memory::get_tag_usage(Memory::TAG_AUDIO);
+	CHECK_MESSAGE(usage.bytes == before.bytes + 2000, "Reallocating should keep the original tag, even outside of its scope.");
+	CHECK(usage.allocations == before.allocations + 1);
+
+	memfree(mem);
+	usage = Memory::get_tag_usage(Memory::TAG_AUDIO);
+	CHECK(usage.bytes == before.bytes);
+	CHECK(usage.allocations == before.allocations);
+	CHECK(usage.total_allocations == before.total_allocations + 1);
+
+	CHECK(String(Memory::get_tag_name(Memory::TAG_AUDIO)) == "audio");
+}
+
+TEST_CASE("[Memory] Allocation sampling") {
+	const uint32_t interval = Memory::get_allocation_sample_interval();
+	Memory::clear_allocation_samples();
+	Memory::set_allocation_sample_interval(1);
+	{
+		MemoryTagScope scope(Memory::TAG_NAVIGATION);
+		for (int i = 0; i < 10; i++) {
+			memfree(memalloc(64));
+		}
+	}
+	Memory::set_allocation_sample_interval(interval);
+
+	Memory::AllocationSample samples[64];
+	const uint32_t count = Memory::get_allocation_samples(samples, 64);
+	uint64_t sampled = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (samples[i].tag == Memory::TAG_NAVIGATION) {
+			CHECK(samples[i].call_stack[0] != nullptr);
+			CHECK(samples[i].bytes == samples[i].count * 64);
+			sampled += samples[i].count;
+		}
+	}
+	CHECK_MESSAGE(sampled == 10, "Every allocation should be sampled with an interval of 1.");
+
+	Memory::clear_allocation_samples();
+	CHECK(Memory::get_allocation_samples(samples, 64) == 0);
+}
+
+#ifndef __EMSCRIPTEN__
+static _NO_INLINE_ void *alloc_through_wrapper(size_t p_bytes) {
+	return memalloc(p_bytes);
+}
+
+static _NO_INLINE_ void alloc_from_first_caller() {
+	for (int i = 0; i < 5; i++) {
+		memfree(alloc_through_wrapper(64));
+	}
+}
+
+static _NO_INLINE_ void alloc_from_second_caller() {
+	for (int i = 0; i < 5; i++) {
+		memfree(alloc_through_wrapper(128));
+	}
+}
+
+TEST_CASE("[Memory] Allocation sampling tells apart the callers of a wrapper") {
+	const uint32_t interval = Memory::get_allocation_sample_interval();
+	Memory::clear_allocation_samples();
+	Memory::set_allocation_sample_interval(1);
+	{
+		MemoryTagScope scope(Memory::TAG_NAVIGATION);
+		alloc_from_first_caller();
+		alloc_from_second_caller();
+	}
+	Memory::set_allocation_sample_interval(interval);
+
+	Memory::AllocationSample samples[64];
+	const uint32_t count = Memory::get_allocation_samples(samples, 64);
+	uint64_t first_caller_allocations = 0;
+	uint64_t second_caller_allocations = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (samples[i].tag != Memory::TAG_NAVIGATION) {
+			continue;
+		}
+		CHECK_MESSAGE(samples[i].call_stack[1] != nullptr, "More than one frame should be recorded.");
+		// A sample mixing both sizes would mean both callers were attributed to the wrapper.
+		if (samples[i].bytes == samples[i].count * 64) {
+			first_caller_allocations += samples[i].count;
+		} else if (samples[i].bytes == samples[i].count * 128) {
+			second_caller_allocations += samples[i].count;
+		}
+	}
+	CHECK_MESSAGE(first_caller_allocations == 5, "Allocations of the first caller should be aggregated separately.");
+	CHECK_MESSAGE(second_caller_allocations == 5, "Allocations of the second caller should be aggregated separately.");
+
+	Memory::clear_allocation_samples();
+}
+#endif // __EMSCRIPTEN__
+#endif // DEBUG_ENABLED
+
+} // namespace TestMemory
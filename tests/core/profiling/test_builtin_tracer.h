@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  test_builtin_tracer.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/profiling/profiling.h"
+
+#include "tests/test_macros.h"
+
+#ifdef GODOT_USE_BUILTIN_TRACER
+
+namespace TestBuiltinTracer {
+
+static Dictionary find_trace_event(const Array &p_events, const String &p_name) {
+	for (const Variant &event : p_events) {
+		if (Dictionary(event).get("name", "") == p_name) {
+			return event;
+		}
+	}
+	return Dictionary();
+}
+
+static Array get_trace_events() {
+	const Dictionary trace = JSON::parse_string(BuiltinTracer::get_chrome_trace());
+	return trace.get("traceEvents", Array());
+}
+
+TEST_CASE("[BuiltinTracer] Recording zones") {
+	BuiltinTracer::clear();
+	BuiltinTracer::set_enabled(true);
+	{
+		GodotProfileZone("Tracer test outer");
+		GodotProfileZoneGroupedFirst(_profile_zone, "Tracer test first");
+		OS::get_singleton()->delay_usec(100);
+		GodotProfileZoneGrouped(_profile_zone, "Tracer test second");
+		GodotProfileZoneGroupedEndEarly(_profile_zone, "Tracer test second");
+		GodotProfileFrameMark;
+	}
+	BuiltinTracer::set_enabled(false);
+	{
+		GodotProfileZone("Tracer test disabled");
+	}
+
+	const Array events = get_trace_events();
+	const Dictionary outer = find_trace_event(events, "Tracer test outer");
+	const Dictionary first = find_trace_event(events, "Tracer test first");
+	const Dictionary second = find_trace_event(events, "Tracer test second");
+	REQUIRE_FALSE(outer.is_empty());
+	REQUIRE_FALSE(first.is_empty());
+	REQUIRE_FALSE(second.is_empty());
+	CHECK(outer["ph"] == "X");
+	CHECK_MESSAGE(int64_t(first["dur"]) >= 100, "Zones should last until the next one in their group starts.");
+	CHECK(int64_t(second["ts"]) >= int64_t(first["ts"]) + int64_t(first["dur"]));
+	CHECK_MESSAGE(int64_t(outer["ts"]) <= int64_t(first["ts"]), "Nested zones should be enclosed by their parent.");
+	CHECK(int64_t(outer["ts"]) + int64_t(outer["dur"]) >= int64_t(second["ts"]) + int64_t(second["dur"]));
+	CHECK_FALSE(find_trace_event(events, "Frame").is_empty());
+	CHECK_MESSAGE(find_trace_event(events, "Tracer test disabled").is_empty(), "Nothing should be recorded while disabled.");
+
+	BuiltinTracer::clear();
+	CHECK_MESSAGE(find_trace_event(get_trace_events(), "Tracer test outer").is_empty(), "Clearing should forget recorded zones.");
+}
+
+TEST_CASE("[BuiltinTracer] Ring buffer wrapping") {
+	BuiltinTracer::clear();
+	BuiltinTracer::set_enabled(true);
+	for (uint32_t i = 0; i < BuiltinTracer::EVENTS_PER_THREAD + 10; i++) {
+		GodotProfileZone(i < 10 ? "Tracer test oldest" : "Tracer test newest");
+	}
+	BuiltinTracer::set_enabled(false);
+
+	const Array events = get_trace_events();
+	CHECK_MESSAGE(find_trace_event(events, "Tracer test oldest").is_empty(), "The oldest zones should be overwritten once the buffer is full.");
+	uint32_t newest_count = 0;
+	for (const Variant &event : events) {
+		newest_count += Dictionary(event).get("name", "") == "Tracer test newest";
+	}
+	// The oldest remaining zone may be dropped too, as it could have been in the middle of being overwritten.
+	CHECK(newest_count >= BuiltinTracer::EVENTS_PER_THREAD - 1);
+	CHECK(newest_count <= BuiltinTracer::EVENTS_PER_THREAD);
+	BuiltinTracer::clear();
+}
+
+} // namespace TestBuiltinTracer
+
+#endif // GODOT_USE_BUILTIN_TRACER
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/os.h"
 #include "core/string/node_path.h"
 
 #include "tests/test_macros.h"
@@ -222,4 +223,20 @@ TEST_CASE("[NodePath] Slice") {
 			"Slice of an empty absolute path should be an empty absolute path.");
 }
 
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[NodePath][Benchmark] Parsing" * doctest::skip()) {
+	const String paths[] = { "Player", "../HUD/Label", "/root/Main/World/Player/Sprite2D:position:x", "%Camera:zoom" };
+	const int iterations = 100000;
+	int64_t names = 0;
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		const NodePath path = NodePath(paths[i % 4]);
+		names += path.get_name_count() + path.get_subname_count();
+	}
+	print_line(vformat("Parsed %d NodePaths with %d names in %d usec.", iterations, names, OS::get_singleton()->get_ticks_usec() - begin));
+	CHECK(names > 0);
+}
+
 } // namespace TestNodePath
@@ -0,0 +1,247 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = StringName("test_string_name_interning");
+	const StringName b = StringName(String("test_string_name_interning"));
+	const StringName c = StringName("test_string_name_interning_other");
+
+	CHECK_MESSAGE(a == b, "StringNames created from equal strings should be the same.");
+	CHECK_MESSAGE(a.data_unique_pointer() == b.data_unique_pointer(), "StringNames created from equal strings should share their data.");
+	CHECK(a != c);
+	CHECK(a == "test_string_name_interning");
+	CHECK(String(a) == "test_string_name_interning");
+
+	CHECK(StringName().is_empty());
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Interning from a span") {
+	const String path = "Parent/test_string_name_span/Child";
+	const StringName a = StringName(Span<char32_t>(path.ptr() + 7, 21));
+	const StringName b = StringName("test_string_name_span");
+	CHECK(a == "test_string_name_span");
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK_MESSAGE(a.hash() == String("test_string_name_span").hash(), "Names interned from spans should hash like Strings.");
+	CHECK(StringName(Span<char32_t>()).is_empty());
+}
+
+TEST_CASE("[StringName] Recreation after release") {
+	const String name = "test_string_name_recreated";
+	{
+		StringName a = StringName(name);
+		CHECK(a == name);
+	}
+	// The entry was released above, so it must be created again rather than resurrected.
+	StringName b = StringName(name);
+	CHECK(b == name);
+	CHECK(b.hash() == name.hash());
+
+	StringName c = b;
+	b = StringName();
+	CHECK(c == name);
+	CHECK(c == StringName(name));
+}
+
+#ifdef THREADS_ENABLED
+struct ThreadedData {
+	LocalVector<String> names;
+	LocalVector<const void *> pointers;
+	SafeFlag mismatch;
+	uint32_t iterations = 0;
+};
+
+static void intern_thread_func(void *p_userdata) {
+	ThreadedData *data = (ThreadedData *)p_userdata;
+	for (uint32_t i = 0; i < data->iterations; i++) {
+		for (uint32_t j = 0; j < data->names.size(); j++) {
+			// Even entries are kept alive by the test, odd ones are created and released constantly.
+			StringName sn = StringName(data->names[j]);
+			if (sn != data->names[j] || (j % 2 == 0 && sn.data_unique_pointer() != data->pointers[j])) {
+				data->mismatch.set();
+			}
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent creation and release") {
+	ThreadedData data;
+	data.iterations = 200;
+	LocalVector<StringName> kept_alive;
+	for (int i = 0; i < 256; i++) {
+		data.names.push_back(vformat("test_string_name_concurrent_%d", i));
+		if (i % 2 == 0) {
+			kept_alive.push_back(StringName(data.names[i]));
+			data.pointers.push_back(kept_alive[kept_alive.size() - 1].data_unique_pointer());
+		} else {
+			data.pointers.push_back(nullptr);
+		}
+	}
+
+	const int thread_count = 8;
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].start(intern_thread_func, &data);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK_FALSE_MESSAGE(data.mismatch.is_set(), "Concurrently created StringNames should always resolve to the interned entry.");
+}
+
+struct ChurnData {
+	LocalVector<String> kept_names;
+	LocalVector<String> released_names;
+	SafeFlag done;
+	SafeNumeric<uint64_t> max_mem_usage;
+	uint32_t iterations = 0;
+};
+
+static void lookup_thread_func(void *p_userdata) {
+	ChurnData *data = (ChurnData *)p_userdata;
+	while (!data->done.is_set()) {
+		for (const String &name : data->kept_names) {
+			StringName sn = StringName(name);
+		}
+	}
+}
+
+static void release_thread_func(void *p_userdata) {
+	ChurnData *data = (ChurnData *)p_userdata;
+	for (uint32_t i = 0; i < data->iterations; i++) {
+		for (const String &name : data->released_names) {
+			// Interned and removed right away.
+			StringName sn = StringName(name);
+		}
+		data->max_mem_usage.exchange_if_greater(Memory::get_mem_usage());
+	}
+}
+
+TEST_CASE("[StringName] Memory stays bounded while lookups overlap removals") {
+	// All names share the low bits of their hash, so they fall in the same shard of the table,
+	// where lookups are in progress nearly all the time.
+	ChurnData data;
+	data.iterations = 100;
+	LocalVector<StringName> kept_alive;
+	const uint32_t shard_mask = 0x3F;
+	const uint32_t shard = String("test_string_name_churn").hash() & shard_mask;
+	for (int i = 0; data.kept_names.size() < 16 || data.released_names.size() < 1024; i++) {
+		const String name = vformat("test_string_name_churn_%d", i);
+		if ((name.hash() & shard_mask) != shard) {
+			continue;
+		}
+		if (data.kept_names.size() < 16) {
+			data.kept_names.push_back(name);
+			kept_alive.push_back(StringName(name));
+		} else {
+			data.released_names.push_back(name);
+		}
+	}
+
+	const uint64_t mem_usage = Memory::get_mem_usage();
+	data.max_mem_usage.set(mem_usage);
+
+	const int lookup_thread_count = 4;
+	const int release_thread_count = 2;
+	Thread lookup_threads[lookup_thread_count];
+	Thread release_threads[release_thread_count];
+	for (int i = 0; i < lookup_thread_count; i++) {
+		lookup_threads[i].start(lookup_thread_func, &data);
+	}
+	for (int i = 0; i < release_thread_count; i++) {
+		release_threads[i].start(release_thread_func, &data);
+	}
+	for (int i = 0; i < release_thread_count; i++) {
+		release_threads[i].wait_to_finish();
+	}
+	data.done.set();
+	for (int i = 0; i < lookup_thread_count; i++) {
+		lookup_threads[i].wait_to_finish();
+	}
+
+	// Keeping every removed entry until there are no lookups would take several MiB here.
+	CHECK_MESSAGE(data.max_mem_usage.get() - mem_usage < 2 * 1024 * 1024, "Removed entries should be freed even if lookups never stop.");
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[StringName][Benchmark] Lookup scaling with thread count" * doctest::skip()) {
+	ThreadedData data;
+	data.iterations = 2000;
+	LocalVector<StringName> kept_alive;
+	for (int i = 0; i < 512; i++) {
+		// Only lookups of existing names are measured, so keep all of them alive.
+		data.names.push_back(vformat("test_string_name_benchmark_%d", i * 2));
+		kept_alive.push_back(StringName(data.names[i]));
+		data.pointers.push_back(kept_alive[i].data_unique_pointer());
+	}
+
+	const int max_threads = OS::get_singleton()->get_processor_count();
+	LocalVector<int> thread_counts;
+	for (int i = 1; i < max_threads; i *= 2) {
+		thread_counts.push_back(i);
+	}
+	thread_counts.push_back(max_threads);
+
+	for (int thread_count : thread_counts) {
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (Thread &thread : threads) {
+			thread.start(intern_thread_func, &data);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+
+		const uint64_t lookups = (uint64_t)thread_count * data.iterations * data.names.size();
+		print_line(vformat("StringName lookups with %d threads: %d lookups/s.", thread_count, (int64_t)(lookups * 1000000ull / usec)));
+	}
+
+	CHECK_FALSE(data.mismatch.is_set());
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestStringName
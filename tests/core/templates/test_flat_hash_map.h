@@ -0,0 +1,240 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object_id.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] List initialization") {
+	FlatHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" }, { 0, "F" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "F");
+	CHECK(map[1] == "B");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[FlatHashMap] Insert, overwrite and erase") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+
+	map.insert(42, 1234);
+	CHECK(map.size() == 1);
+	CHECK(map[42] == 1234);
+	CHECK(map.get(42) == 1234);
+	CHECK(*map.getptr(42) == 1234);
+	CHECK(map.getptr(-10) == nullptr);
+
+	map.remove(map.find(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(!map.erase(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FlatHashMap] Many elements") {
+	FlatHashMap<int, int> map;
+	const int count = 10000;
+	for (int i = 0; i < count; i++) {
+		map.insert(i * 7, i);
+	}
+	CHECK(map.size() == count);
+	CHECK(map.get_capacity() >= count);
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		const int *value = map.getptr(i * 7);
+		all_found &= value && *value == i;
+		all_found &= !map.has(i * 7 + 1);
+	}
+	CHECK_MESSAGE(all_found, "All inserted keys should be found, and only them.");
+
+	// Erase every other element, leaving tombstones around.
+	for (int i = 0; i < count; i += 2) {
+		CHECK(map.erase(i * 7));
+	}
+	CHECK(map.size() == count / 2);
+	all_found = true;
+	for (int i = 0; i < count; i++) {
+		all_found &= map.has(i * 7) == (i % 2 == 1);
+	}
+	CHECK_MESSAGE(all_found, "Erasing should not affect the other elements.");
+
+	// Churn, which must be handled by getting rid of tombstones rather than growing forever.
+	const uint32_t capacity = map.get_capacity();
+	for (int i = 0; i < count * 10; i++) {
+		map.insert(-1 - i, i);
+		map.erase(-1 - i);
+	}
+	CHECK(map.size() == count / 2);
+	CHECK(map.get_capacity() == capacity);
+}
+
+TEST_CASE("[FlatHashMap] Iteration order") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, true> ordered_map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i);
+		ordered_map.insert(i, i);
+	}
+
+	int idx = 0;
+	bool in_order = true;
+	for (const KeyValue<int, int> &E : map) {
+		in_order &= E.key == idx++;
+	}
+	CHECK_MESSAGE(in_order, "Elements should be iterated in insertion order.");
+
+	map.erase(10);
+	CHECK_MESSAGE(map.begin()->key == 0, "Erasing should move the last element into the gap.");
+	CHECK(map.find(99) != map.end());
+
+	for (int i = 0; i < 100; i += 3) {
+		ordered_map.erase(i);
+	}
+	int previous = -1;
+	in_order = true;
+	for (const KeyValue<int, int> &E : ordered_map) {
+		in_order &= E.key > previous && E.key % 3 != 0;
+		previous = E.key;
+	}
+	CHECK_MESSAGE(in_order, "With KEEP_ORDER, erasing should keep insertion order.");
+	CHECK(ordered_map.has(98));
+	CHECK(ordered_map[98] == 98);
+}
+
+TEST_CASE("[FlatHashMap] Copy, move and clear") {
+	FlatHashMap<String, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(itos(i), i);
+	}
+
+	FlatHashMap<String, int> copy = map;
+	CHECK(copy.size() == 100);
+	CHECK(copy["50"] == 50);
+	copy["50"] = 0;
+	CHECK_MESSAGE(map["50"] == 50, "Copies should not share elements.");
+
+	FlatHashMap<String, int> moved = std::move(copy);
+	CHECK(moved.size() == 100);
+	CHECK(moved["50"] == 0);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has("50"));
+	map.insert("50", 1);
+	CHECK(map["50"] == 1);
+
+	map.reset();
+	CHECK(map.get_capacity() == FlatHashMap<String, int>::MIN_CAPACITY);
+	map.reserve(1000);
+	CHECK(map.get_capacity() >= 1000);
+}
+
+TEST_CASE("[FlatHashSet] Insert, erase and iteration") {
+	FlatHashSet<StringName> set{ "a", "b", "c", "a" };
+	CHECK(set.size() == 3);
+	CHECK(set.has("b"));
+	CHECK(!set.has("d"));
+
+	set.insert("d");
+	CHECK(set.erase("a"));
+	CHECK(!set.has("a"));
+	CHECK(set.find("d"));
+
+	int count = 0;
+	for (const StringName &E : set) {
+		CHECK(set.has(E));
+		count++;
+	}
+	CHECK(count == 3);
+}
+
+template <typename TMap, typename TKey>
+static uint64_t benchmark_map(const LocalVector<TKey> &p_keys, const LocalVector<TKey> &p_missing_keys, int p_iterations, int64_t &r_sum) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_iterations; i++) {
+		TMap map;
+		for (uint32_t j = 0; j < p_keys.size(); j++) {
+			map.insert(p_keys[j], j);
+		}
+		for (const TKey &key : p_keys) {
+			r_sum += *map.getptr(key);
+		}
+		for (const TKey &key : p_missing_keys) {
+			r_sum += map.has(key);
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[FlatHashMap][Benchmark] Versus HashMap and AHashMap" * doctest::skip()) {
+	const uint32_t count = 10000;
+	const int iterations = 100;
+	int64_t sum = 0;
+
+	LocalVector<StringName> names;
+	LocalVector<StringName> missing_names;
+	LocalVector<ObjectID> ids;
+	LocalVector<ObjectID> missing_ids;
+	for (uint32_t i = 0; i < count; i++) {
+		names.push_back(StringName("name_" + itos(i)));
+		missing_names.push_back(StringName("missing_" + itos(i)));
+		ids.push_back(ObjectID(uint64_t(i) << 24 | 1));
+		missing_ids.push_back(ObjectID(uint64_t(i) << 24 | 2));
+	}
+
+	print_line(vformat("StringName keys: HashMap %d usec, AHashMap %d usec, FlatHashMap %d usec.",
+			benchmark_map<HashMap<StringName, uint32_t>>(names, missing_names, iterations, sum),
+			benchmark_map<AHashMap<StringName, uint32_t>>(names, missing_names, iterations, sum),
+			benchmark_map<FlatHashMap<StringName, uint32_t>>(names, missing_names, iterations, sum)));
+	print_line(vformat("ObjectID keys: HashMap %d usec, AHashMap %d usec, FlatHashMap %d usec.",
+			benchmark_map<HashMap<ObjectID, uint32_t>>(ids, missing_ids, iterations, sum),
+			benchmark_map<AHashMap<ObjectID, uint32_t>>(ids, missing_ids, iterations, sum),
+			benchmark_map<FlatHashMap<ObjectID, uint32_t>>(ids, missing_ids, iterations, sum)));
+
+	CHECK(sum > 0);
+}
+
+} // namespace TestFlatHashMap
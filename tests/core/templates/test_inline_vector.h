@@ -0,0 +1,168 @@
+/**************************************************************************/
+/*  test_inline_vector.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/templates/inline_vector.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestInlineVector {
+
+TEST_CASE("[InlineVector] Staying inline") {
+	InlineVector<int, 4> vector;
+	CHECK(vector.is_empty());
+	CHECK(vector.get_capacity() == 4);
+
+	vector.push_back(0);
+	vector.push_back(1);
+	vector.push_back(2);
+	vector.push_back(3);
+	CHECK(vector.size() == 4);
+	CHECK_MESSAGE(vector.is_inline(), "Elements should be kept inline while they fit.");
+	CHECK((const uint8_t *)vector.ptr() >= (const uint8_t *)&vector);
+	CHECK((const uint8_t *)vector.ptr() < (const uint8_t *)&vector + sizeof(vector));
+
+	vector.pop_back();
+	CHECK(vector.size() == 3);
+	CHECK(vector[2] == 2);
+}
+
+TEST_CASE("[InlineVector] Spilling to the heap") {
+	InlineVector<String, 2> vector = { "a", "b" };
+	CHECK(vector.is_inline());
+	vector.push_back("c");
+	CHECK_MESSAGE(!vector.is_inline(), "Outgrowing the inline storage should move the elements to the heap.");
+	CHECK(vector.get_capacity() >= 3);
+	CHECK(vector[0] == "a");
+	CHECK(vector[2] == "c");
+
+	vector.clear();
+	CHECK(vector.is_empty());
+	CHECK(!vector.is_inline());
+	vector.reset();
+	CHECK_MESSAGE(vector.is_inline(), "Resetting should give the heap memory back.");
+	CHECK(vector.get_capacity() == 2);
+}
+
+TEST_CASE("[InlineVector] Removing elements") {
+	InlineVector<int, 8> vector = { 0, 1, 2, 3, 4 };
+	vector.remove_at(1);
+	CHECK(vector.size() == 4);
+	CHECK(vector[1] == 2);
+	vector.remove_at_unordered(0);
+	CHECK(vector[0] == 4);
+	CHECK(vector.erase(3));
+	CHECK(!vector.erase(3));
+	CHECK(vector.has(2));
+	CHECK(vector.find(2) == 1);
+	CHECK(vector.size() == 2);
+}
+
+TEST_CASE("[InlineVector] Copying and moving") {
+	InlineVector<String, 2> small = { "a" };
+	InlineVector<String, 2> large = { "a", "b", "c" };
+
+	InlineVector<String, 2> small_copy = small;
+	InlineVector<String, 2> large_copy = large;
+	CHECK(small_copy.is_inline());
+	CHECK(small_copy[0] == "a");
+	CHECK(large_copy.size() == 3);
+	CHECK(large_copy[2] == "c");
+	CHECK(large_copy.ptr() != large.ptr());
+
+	const String *large_data = large.ptr();
+	InlineVector<String, 2> large_moved = std::move(large);
+	CHECK_MESSAGE(large_moved.ptr() == large_data, "Moving should steal the heap storage.");
+	CHECK(large.is_empty());
+	CHECK(large.is_inline());
+
+	InlineVector<String, 2> small_moved;
+	small_moved = std::move(small);
+	CHECK(small_moved.size() == 1);
+	CHECK(small_moved[0] == "a");
+	CHECK(small.is_empty());
+
+	small_moved = large_moved;
+	CHECK(small_moved.size() == 3);
+	CHECK(small_moved[1] == "b");
+}
+
+TEST_CASE("[InlineVector] Resizing") {
+	InlineVector<int, 4> vector;
+	vector.resize_initialized(3);
+	CHECK(vector.size() == 3);
+	CHECK(vector[2] == 0);
+	vector.resize(10);
+	CHECK(vector.size() == 10);
+	CHECK(!vector.is_inline());
+	vector.resize(1);
+	CHECK(vector.size() == 1);
+
+	int sum = 0;
+	for (int value : vector) {
+		sum += value + 1;
+	}
+	CHECK(sum == 1);
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[InlineVector][Benchmark] Short temporary vectors versus the heap" * doctest::skip()) {
+	const int iterations = 1000000;
+	int64_t sum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		LocalVector<int> vector;
+		for (int j = 0; j < 8; j++) {
+			vector.push_back(j);
+		}
+		sum += vector[i % 8];
+	}
+	const uint64_t heap_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		InlineVector<int, 8> vector;
+		for (int j = 0; j < 8; j++) {
+			vector.push_back(j);
+		}
+		sum -= vector[i % 8];
+	}
+	const uint64_t inline_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("Short temporary vectors: LocalVector %d usec, InlineVector %d usec.", heap_usec, inline_usec));
+	CHECK(sum == 0);
+}
+
+} // namespace TestInlineVector
@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*  test_lock_free_queue.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/templates/lock_free_queue.h"
+#include "core/templates/safe_refcount.h"
+
+#include "tests/test_macros.h"
+
+namespace TestLockFreeQueue {
+
+TEST_CASE("[LockFreeQueue] Push and pop in FIFO order") {
+	LockFreeQueue<int, 8> queue;
+	CHECK(queue.is_empty_approx());
+
+	int value = -1;
+	CHECK_FALSE(queue.pop(value));
+	CHECK(value == -1);
+
+	for (int i = 0; i < 8; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK(queue.size_approx() == 8);
+	CHECK_MESSAGE(!queue.push(8), "Pushing to a full queue should fail.");
+
+	for (int i = 0; i < 8; i++) {
+		CHECK(queue.pop(value));
+		CHECK(value == i);
+	}
+	CHECK(queue.is_empty_approx());
+	CHECK_FALSE(queue.pop(value));
+}
+
+TEST_CASE("[LockFreeQueue] Wrap around") {
+	LockFreeQueue<uint32_t, 4> queue;
+	uint32_t value = 0;
+	bool all_in_order = true;
+	for (uint32_t i = 0; i < 1000; i++) {
+		queue.push(i);
+		queue.push(i + 1);
+		all_in_order &= queue.pop(value) && value == i;
+		all_in_order &= queue.pop(value) && value == i + 1;
+	}
+	CHECK(all_in_order);
+	CHECK(queue.is_empty_approx());
+}
+
+#ifdef THREADS_ENABLED
+struct ThreadedData {
+	LockFreeQueue<uint64_t, 64> queue;
+	SafeNumeric<uint64_t> popped_count;
+	SafeNumeric<uint64_t> popped_sum;
+	uint64_t per_producer = 0;
+	uint64_t total = 0;
+};
+
+static void producer_func(void *p_userdata) {
+	ThreadedData *data = (ThreadedData *)p_userdata;
+	for (uint64_t i = 1; i <= data->per_producer; i++) {
+		while (!data->queue.push(i)) {
+			Thread::yield();
+		}
+	}
+}
+
+static void consumer_func(void *p_userdata) {
+	ThreadedData *data = (ThreadedData *)p_userdata;
+	uint64_t value = 0;
+	while (data->popped_count.get() < data->total) {
+		if (data->queue.pop(value)) {
+			data->popped_sum.add(value);
+			data->popped_count.increment();
+		} else {
+			Thread::yield();
+		}
+	}
+}
+
+TEST_CASE("[LockFreeQueue] Multiple producers and consumers") {
+	const int thread_pairs = 4;
+	ThreadedData *data = memnew(ThreadedData);
+	data->per_producer = 5000;
+	data->total = data->per_producer * thread_pairs;
+
+	Thread threads[thread_pairs * 2];
+	for (int i = 0; i < thread_pairs; i++) {
+		threads[i * 2].start(producer_func, data);
+		threads[i * 2 + 1].start(consumer_func, data);
+	}
+	for (int i = 0; i < thread_pairs * 2; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK(data->popped_count.get() == data->total);
+	CHECK(data->popped_sum.get() == thread_pairs * (data->per_producer * (data->per_producer + 1) / 2));
+	CHECK(data->queue.is_empty_approx());
+	memdelete(data);
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestLockFreeQueue
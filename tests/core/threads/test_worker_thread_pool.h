@@ -172,4 +172,133 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+class TaskGraphTest {
+public:
+	SafeNumeric<uint32_t> sequence;
+	uint32_t order[3] = {}; // When each single task ran, in sequence.
+	SafeNumeric<uint32_t> group_processed;
+	uint32_t group_processed_before_last = 0;
+	SafeFlag completed;
+
+	void run_node(uint32_t p_index) {
+		order[p_index] = sequence.increment();
+	}
+	void run_group_element(uint32_t p_index, void *p_userdata) {
+		group_processed.increment();
+	}
+	void run_last_node(uint32_t p_index) {
+		group_processed_before_last = group_processed.get();
+		run_node(p_index);
+	}
+	static void on_completed(void *p_arg) {
+		((TaskGraphTest *)p_arg)->completed.set();
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Task graphs run nodes after their dependencies") {
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	for (int iterations = 0; iterations < 100; iterations++) {
+		TaskGraphTest test;
+		WorkerThreadPool::TaskGraphID graph = wtp->create_task_graph("Task graph test");
+
+		// A diamond: the first node, then a task and a group in parallel, then the last node.
+		const WorkerThreadPool::GraphNodeID first[] = { wtp->add_graph_template_task(graph, &test, &TaskGraphTest::run_node, 0u) };
+		const WorkerThreadPool::GraphNodeID middle[] = {
+			wtp->add_graph_template_task(graph, &test, &TaskGraphTest::run_node, 1u, first),
+			wtp->add_graph_template_group_task(graph, &test, &TaskGraphTest::run_group_element, nullptr, 64, -1, first),
+		};
+		wtp->add_graph_template_task(graph, &test, &TaskGraphTest::run_last_node, 2u, middle);
+		wtp->set_task_graph_completion_callback(graph, &TaskGraphTest::on_completed, &test);
+		CHECK_FALSE(wtp->is_task_graph_completed(graph));
+
+		wtp->submit_task_graph(graph);
+		wtp->wait_for_task_graph_completion(graph);
+
+		CHECK(test.order[0] < test.order[1]);
+		CHECK(test.order[1] < test.order[2]);
+		CHECK_MESSAGE(test.group_processed_before_last == 64, "The last node should run after the whole group.");
+		CHECK_MESSAGE(test.completed.is_set(), "The completion callback should be called before the wait is over.");
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Detached task graphs with empty groups") {
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	TaskGraphTest test;
+	WorkerThreadPool::TaskGraphID graph = wtp->create_task_graph("Detached task graph test");
+	const WorkerThreadPool::GraphNodeID empty_group[] = { wtp->add_graph_template_group_task(graph, &test, &TaskGraphTest::run_group_element, nullptr, 0) };
+	wtp->add_graph_template_task(graph, &test, &TaskGraphTest::run_last_node, 0u, empty_group);
+	wtp->set_task_graph_completion_callback(graph, &TaskGraphTest::on_completed, &test);
+
+	// Nobody waits for a detached graph, so poll for the completion callback.
+	wtp->submit_task_graph(graph, true);
+	while (!test.completed.is_set()) {
+		OS::get_singleton()->delay_usec(100);
+	}
+	CHECK_MESSAGE(test.order[0] == 1, "Nodes depending on an empty group should still run.");
+	CHECK(test.group_processed.get() == 0);
+}
+
+static void static_benchmark_task(void *p_arg) {
+	((SafeNumeric<uint64_t> *)p_arg)->increment();
+}
+
+static void static_benchmark_group_task(void *p_arg, uint32_t p_index) {
+	((SafeNumeric<uint64_t> *)p_arg)->increment();
+}
+
+// This is a benchmark rather than a test, so it's skipped by default.
+// Run it with: `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[WorkerThreadPool][Benchmark] Task contention scaling with thread count" * doctest::skip()) {
+	const int task_count = 20000;
+	const int group_count = 2000;
+	const int group_elements = 64;
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	LocalVector<int> thread_counts;
+	for (int i = 1; i < max_threads; i *= 2) {
+		thread_counts.push_back(i);
+	}
+	thread_counts.push_back(max_threads);
+
+	for (int thread_count : thread_counts) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		SafeNumeric<uint64_t> processed;
+		LocalVector<WorkerThreadPool::TaskID> task_ids;
+		task_ids.resize(task_count);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < task_count; i++) {
+			task_ids[i] = pool->add_native_task(static_benchmark_task, &processed, true);
+		}
+		for (int i = 0; i < task_count; i++) {
+			pool->wait_for_task_completion(task_ids[i]);
+		}
+		uint64_t tasks_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+
+		LocalVector<WorkerThreadPool::GroupID> group_ids;
+		group_ids.resize(group_count);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < group_count; i++) {
+			group_ids[i] = pool->add_native_group_task(static_benchmark_group_task, &processed, group_elements, -1, true);
+		}
+		for (int i = 0; i < group_count; i++) {
+			pool->wait_for_group_task_completion(group_ids[i]);
+		}
+		uint64_t groups_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+
+		CHECK(processed.get() == (uint64_t)(task_count + group_count * group_elements));
+
+		print_line(vformat("WorkerThreadPool with %d threads: %d tasks/s, %d groups/s.",
+				thread_count,
+				(int64_t)(task_count * 1000000ull / tasks_usec),
+				(int64_t)(group_count * 1000000ull / groups_usec)));
+
+		pool->finish();
+		memdelete(pool);
+	}
+}
+
 } // namespace TestWorkerThreadPool